@@ -11,6 +11,11 @@
 #define DYN_ALLOC_MAX_SIZE (32<<20) 					//32 MB
 #define DYN_ALLOC_MIN_BLOCK_SIZE (1<<LOG2_MIN_SIZE)		//8 BYTE
 #define DYN_ALLOC_MAX_BLOCK_SIZE (1<<LOG2_MAX_SIZE) 	//2 KB
+
+/*2025*/
+//Values for the DA mode of tracking the free blocks [to be set BEFORE initialize_dynamic_allocator()]
+#define DA_MODE_LIST	0x0		//free blocks are linked in freeBlockLists[]
+#define DA_MODE_BITMAP	0x1		//free blocks are marked in a bitmap per page & pages with free blocks are linked in partialPagesLists[]
 struct PageAllocChunk
 {
 	LIST_ENTRY(PageAllocChunk) prev_next_info;	/* linked list links */
@@ -36,14 +41,27 @@ struct PageInfoElement
 	LIST_ENTRY(PageInfoElement) prev_next_info;	/* linked list links */
 	uint16 block_size;
 	uint16 num_of_free_blocks;
+	//[DA_MODE_BITMAP] if the page has <= 32 blocks: bit i is set if block i is free
+	//				   else: bit w is set if word w of the in-page bitmap has a free block
+	uint32 free_map;
 };
 LIST_HEAD(PageInfoElement_List, PageInfoElement);
 struct PageInfoElement_List freePagesList ;
+struct PageInfoElement_List partialPagesLists[LOG2_MAX_SIZE - LOG2_MIN_SIZE + 1] ;	//[DA_MODE_BITMAP] pages with free blocks
 struct PageInfoElement pageBlockInfoArr[DYN_ALLOC_MAX_SIZE/PAGE_SIZE];
 
 //[3] Limits (to be set in initialize_dynamic_allocator())
 uint32 dynAllocStart;
 uint32 dynAllocEnd;
+uint32 dynAllocMode;
+
+/*2025*/ //Replaced by setter & getter function
+static inline void set_dyn_alloc_mode(uint32 mode) {
+	dynAllocMode = mode;
+}
+static inline uint32 get_dyn_alloc_mode() {
+	return dynAllocMode;
+}
 
 /*FUNCTIONS*/
 //=============================================================================
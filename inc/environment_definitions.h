@@ -68,18 +68,22 @@ struct WorkingSetElement {
 	//2020
 	LIST_ENTRY(WorkingSetElement)
 	prev_next_info;	// list link pointers
+	/*2025*/
+	struct WorkingSetElement* hash_next;	// next element in the same bucket of the env page_WS_hash
+	uint32 ring_index;						// its slot in the env page_WS_ring (WS_RING_NONE: not in it)
 };
 
 //2020
 LIST_HEAD(WS_List, WorkingSetElement);		// Declares 'struct WS_list'
 
 /*2025*/
-struct PageRefElement {
+//Array CLOCK: entry of the per-env ring of the WS pages (one per WS element, see working_set_manager.c)
+#define WS_RING_NONE 0xFFFFFFFF
+struct WSRingEntry {
 	unsigned int virtual_address;
-	LIST_ENTRY(PageRefElement)
-	prev_next_info;	// list link pointers
+	uint32* ptr_pte;					// its cached page table entry, so the sweep needs no table walk
+	struct WorkingSetElement* wse;		// its element in the page_WS_list
 };
-LIST_HEAD(PageRef_List, PageRefElement);	// Declares 'struct PageRef_List'
 
 //======================================================================
 
@@ -145,12 +149,21 @@ struct Env {
 	//================
 	//page working set management
 	unsigned int page_WS_max_size;					//Max allowed size of WS
+	unsigned int page_WS_init_size;					//Max size of WS given at its creation (before any priority/PFF change)
+	uint32 pffTicks;								//PFF: # ticks of the env in the current window
+	uint32 pffLastFaultsCounter;					//PFF: pageFaultsCounter at the start of the current window
 #if USE_KHEAP
 	struct WS_List page_WS_list;					//List of WS elements
 	struct WorkingSetElement* page_last_WS_element;	//ptr to last inserted WS element
+	struct WorkingSetElement** page_WS_hash;		//VA-indexed buckets of the WS elements (see working_set_manager.h)
+	struct WSRingEntry* page_WS_ring;				//Array CLOCK: ring of page_WS_max_size entries (NULL: list CLOCK)
+	uint32 page_WS_ring_size;						//# ring entries, i.e. its slots [0, size) are all in use
+	uint32 page_WS_ring_hand;						//ring index of the clock hand
 	uint8 prp;
 
-	struct PageRef_List referenceStreamList;//List of page references stream to be used for OPTIMAL replacement strategy
+	uint32 *referenceStream;						//Stream of the referenced pages to be used for OPTIMAL replacement strategy (growable array)
+	uint32 referenceStreamSize;						//# refs in the stream
+	uint32 referenceStreamCapacity;					//# refs the stream array can hold
 	uint32 *prepagedVAs;//Initial virtual addresses after fetching the process into RAM
 	uint32 numOfPrepagedVAs;						//Number of prepaged VAs
 
@@ -178,19 +191,23 @@ struct Env {
 
 	//Percentage of WS pages to be removed [either for scarce RAM or Full WS]
 	unsigned int percentage_of_WS_pages_to_be_removed;
+	uint8 isHandlingFault;		//2025: inside fault_handler() (it may block there, e.g. on a free frame or the disk): its WS can't be reclaimed
 
 	//==================
 	/*CPU BSD Sched...*/
 	//==================
+	int nice;						//2025: niceness [BSD_NICE_MIN, BSD_NICE_MAX], the higher the nicer (less CPU)
+	fixed_point_t recentCPU;		//2025: recent CPU usage: +1 each tick it runs & decayed each second
+	uint32 recentCPUSecond;			//2025: bsd_seconds of the last decay of its recentCPU (a blocked env is decayed on its wakeup)
 	// USER HEAP
 	#define MAX_USER_BLOCKS 1024
 	void* heap_blocks[MAX_USER_BLOCKS];
 	int num_heap_blocks;
+	uint32 uheapDABreak;		//break of the user DA area [moved by sys_sbrk()]
 	//==================
 	/*CPU PRIORITY RR Sched...*/
 	//==================
-// created by uosef mohamed
-	uint8 Env_quantums;
+	int64 readyTick;				//2025: ticks when it's last inserted in a ready queue (its starvation is measured from it)
 	//================
 	/*STATISTICS...*/
 	//================
@@ -201,9 +218,23 @@ struct Env {
 	uint32 nModifiedPages;
 	uint32 nNotModifiedPages;
 	uint32 env_runs;			// Number of times environment has run
+	int64 lastRunTick;			//2025: ticks when it's last picked by the scheduler (the reclaimer takes from the least recently run envs first)
+	struct Timer* sleepTimer;	//2025: the timer of its timed sleep (on its kernel stack) while it's blocked, see sleep_timeout()
 	//2020
 	uint32 nPageIn, nPageOut, nNewPageAdded;
 	uint32 nClocks;
+	//2025: pages brought by fault-around & how many of them are used (hits) or evicted before use (misses)
+	uint32 nFaultAroundPages, nFaultAroundHits, nFaultAroundMisses;
+	//2025: [buffering] faults served by reclaiming a buffered frame (soft) or by reading the page file (hard)
+	uint32 nSoftPageFaults, nHardPageFaults;
+	//2025: [zero-fill] fresh pages mapped on the shared zero frame & the writes that gave them their own frame
+	uint32 nZeroMappedPages, nZeroFillCOWFaults;
+	//2025: frame cache of its program (NULL if it's loaded into private frames) & its pages mapped on the cache or copied on a write
+	struct ProgramFrameCache* progCache;
+	uint32 nProgCachePages, nProgCOWFaults;
+	//2025: ring of the traced page faults (see kern/trap/page_trace.h)
+	struct PageTraceRecord* pageTrace;
+	uint32 pageTraceNext, pageTraceCount;
 
 };
 
@@ -78,8 +78,14 @@ void	sys_allocate_chunk(uint32 virtual_address, uint32 size, uint32 perms);
 void 	sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size);
 uint32 	sys_get_uheap_strategy();
 void 	sys_set_uheap_strategy(uint32 heapStrategy);
+uint32 	sys_get_uheap_da_mode();
 
 void sys_env_set_priority(int32 envID, int priority);
+int sys_nice(int increment);
+
+//Timed sleep & monotonic clock (in ns)
+void sys_sleep_ns(uint64 ns);
+uint64 sys_get_time_ns();
 
 //Page File
 int 	sys_pf_calculate_allocated_pages(void);
@@ -105,6 +111,7 @@ struct uint64 sys_get_virtual_time();
 //2020
 int 	sys_check_LRU_lists(uint32* active_list_content, uint32* second_list_content, int actual_active_list_size, int actual_second_list_size);
 int 	sys_check_LRU_lists_free(uint32* list_content, int list_size);
+/*2025*/int 	sys_check_LRU_lists_invariants();
 //2023
 int 	sys_check_WS_list(uint32* WS_list_content, int actual_WS_list_size, uint32 last_WS_element_content, bool chk_in_order);
 //2024
@@ -216,6 +216,8 @@ struct FrameInfo {
 	uint16 references;
 	struct Env *proc;
 	unsigned char isBuffered;
+	unsigned char isWritingBack;	// buffered & in the writeback_frame_list (see writeback_flush())
+	uint32 va;		// user page this frame is buffered for (valid while isBuffered)
 	// added by(uosef mohamed) to keep track page va
 		uint32 frame_virt_addr;
 };
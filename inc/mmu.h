@@ -68,6 +68,7 @@
 #define PTE_MBZ			0x180	// Bits must be zero
 #define PERM_BUFFERED 	0x200 	//Page is buffered
 #define PERM_UHPAGE 	0x400 	//Page in User Heap
+#define PERM_PREFETCHED	0x800 	//Page is brought by fault-around & not checked for use yet
 
 // The PERM_AVAILABLE bits aren't used by the kernel or interpreted by the
 // hardware, so user processes are allowed to set them arbitrarily.
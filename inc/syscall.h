@@ -51,6 +51,12 @@ enum
 	SYS_allocate_user_mem,
 	SYS_free_user_mem,
 	SYS_env_set_priority,
+	SYS_sbrk,
+	SYS_nice,		//2025
+	SYS_sleep_ns,	//2025
+	SYS_get_time_ns,//2025
+	SYS_get_uheap_da_mode,//2025
+	SYS_check_LRU_lists_invariants,//2025
 	//TODO: [PROJECT'25.IM#4] CPU SCHEDULING - #1 System Calls - Add suitable code here
 	//Your code is here
 
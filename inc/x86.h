@@ -48,6 +48,9 @@ static __inline void write_esp(uint32 esp) __attribute__((always_inline));
 static __inline void write_ebp(uint32 ebp) __attribute__((always_inline));
 static __inline void cpuid(uint32 info, uint32 *eaxp, uint32 *ebxp, uint32 *ecxp, uint32 *edxp);
 static __inline uint64 read_tsc(void) __attribute__((always_inline));
+//2025: bit scan (index of lowest/highest set bit). Result is undefined if val == 0
+static __inline uint32 bsf(uint32 val) __attribute__((always_inline));
+static __inline uint32 bsr(uint32 val) __attribute__((always_inline));
 static inline __attribute__((always_inline)) struct uint64 get_virtual_time_user();
 
 
@@ -331,6 +334,15 @@ sti(void)
 	__asm __volatile("sti");
 }
 
+/*2025*/
+//set interrupt flag & halt till the next interrupt.
+//	sti takes effect after the next instruction, so no interrupt can slip in before the hlt
+static __inline void
+sti_hlt(void)
+{
+	__asm __volatile("sti; hlt");
+}
+
 //atomic xchange
 //Example: xchg(&(globalIntVar), 1);
 static __inline uint32
@@ -372,6 +384,24 @@ static __inline void lidt(struct Gatedesc *p, int size)
 }
 
 
+//index of the lowest set bit in val (val MUST NOT be 0)
+static __inline uint32
+bsf(uint32 val)
+{
+	uint32 idx;
+	__asm __volatile("bsfl %1, %0" : "=r" (idx) : "rm" (val) : "cc");
+	return idx;
+}
+
+//index of the highest set bit in val (val MUST NOT be 0)
+static __inline uint32
+bsr(uint32 val)
+{
+	uint32 idx;
+	__asm __volatile("bsrl %1, %0" : "=r" (idx) : "rm" (val) : "cc");
+	return idx;
+}
+
 static inline __attribute__((always_inline)) struct uint64 get_virtual_time_user()
 {
 	struct uint64 result;
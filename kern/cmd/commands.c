@@ -10,13 +10,18 @@
 
 #include <kern/trap/trap.h>
 #include <kern/trap/fault_handler.h>
+#include <kern/trap/page_trace.h>
 #include <kern/proc/user_environment.h>
 #include <kern/proc/priority_manager.h>
+#include <kern/proc/program_cache.h>
 #include <kern/tests/utilities.h>
 #include "../cpu/sched.h"
 #include "../disk/pagefile_manager.h"
 #include "../mem/kheap.h"
+#include "../mem/kmem_cache.h"
 #include "../mem/memory_manager.h"
+#include "../mem/working_set_manager.h"
+#include "../mem/reclaimer.h"
 #include "../tests/tst_handler.h"
 #include "../tests/utilities.h"
 #include "../cons/console.h"
@@ -49,13 +54,16 @@ struct Command commands[] =
 		{"clock", "set replacement algorithm to CLOCK", command_set_page_rep_CLOCK, 0},
 		{"modclock", "set replacement algorithm to modified CLOCK", command_set_page_rep_ModifiedCLOCK, 0},
 		{"optimal", "set replacement algorithm to OPTIMAL", command_set_page_rep_OPTIMAL, 0},
+		{"dynlocal", "set replacement algorithm to dynamic local (CLOCK with a WS size that follows the page fault frequency)", command_set_page_rep_DynamicLocal, 0},
 		{"rep?", "print current replacement algorithm", command_print_page_rep, 0},
+		{"reclaim?", "print the free frames watermarks of the memory reclaimer", command_get_reclaim_watermarks, 0},
 		{"uhfirstfit", "set USER heap placement strategy to FIRST FIT", command_set_uheap_plac_FIRSTFIT, 0},
 		{"uhbestfit", "set USER heap placement strategy to BEST FIT", command_set_uheap_plac_BESTFIT, 0},
 		{"uhnextfit", "set USER heap placement strategy to NEXT FIT", command_set_uheap_plac_NEXTFIT, 0},
 		{"uhworstfit", "set USER heap placement strategy to WORST FIT", command_set_uheap_plac_WORSTFIT, 0},
 		{"uhcustomfit", "set USER heap placement strategy to CUSTOM FIT", command_set_uheap_plac_CUSTOMFIT, 0},
 		{"uheap?", "print current USER heap placement strategy", command_print_uheap_plac, 0},
+		{"uhdamode?", "print the DA mode of the USER heaps of the new envs", command_get_uheap_da_mode, 0},
 		{"khcontalloc", "set KERNEL heap placement strategy to CONTINUOUS ALLOCATION", command_set_kheap_plac_CONTALLOC, 0},
 		{"khfirstfit", "set KERNEL heap placement strategy to FIRST FIT", command_set_kheap_plac_FIRSTFIT, 0},
 		{"khbestfit", "set KERNEL heap placement strategy to BEST FIT", command_set_kheap_plac_BESTFIT, 0},
@@ -68,6 +76,15 @@ struct Command commands[] =
 		{"nomodbuff", "disable modified buffer", command_disable_modified_buffer, 0},
 		{"modbuff", "enable modified buffer", command_enable_modified_buffer, 0},
 		{"modbufflength?", "get modified buffer length", command_get_modified_buffer_length, 0},
+		{"faultaround?", "get the fault-around window (# neighbor pages brought with each page fault)", command_get_fault_around_window, 0},
+		{"wsring?", "print whether the new envs use the array CLOCK working set", command_get_ws_ring, 0},
+		{"zerofill?", "print whether the fresh heap/stack pages are mapped on the shared zero frame", command_get_zero_fill, 0},
+		{"progcache?", "print whether the new envs share the frames of their programs & the cached pages of each one", command_get_program_cache, 0},
+		{"progcacheflush", "free the cached frames of the programs that have no env", command_flush_program_cache, 0},
+		{"tickless?", "print whether the clock is a one-shot armed for each dispatch", command_get_tickless, 0},
+		{"clocksweeps", "print the histogram of the CLOCK sweep lengths", command_print_clock_sweeps, 0},
+		{"resetclocksweeps", "reset the histogram of the CLOCK sweep lengths", command_reset_clock_sweeps, 0},
+		{"pgtrace?", "print whether the page faults are traced (and streamed to COM1)", command_get_page_trace, 0},
 		{"cls", "clear screen", command_cls, 0},
 
 		//*****************************//
@@ -86,7 +103,19 @@ struct Command commands[] =
 		{"schedTest", "Used for turning on/off the scheduler test", command_sch_test, 1},
 		{"lru", "set replacement algorithm to LRU", command_set_page_rep_LRU, 1},
 		{"modbufflength", "set the length of the modified buffer", command_set_modified_buffer_length, 1},
+		{"faultaround", "set the fault-around window (0: disabled)", command_set_fault_around_window, 1},
+		{"uhdamode", "track the free blocks of the USER heaps of the new envs in bitmaps (1: bitmap, 0: list)", command_set_uheap_da_mode, 1},
+		{"wsring", "use the array CLOCK working set for the new envs (1: enable, 0: disable)", command_set_ws_ring, 1},
+		{"zerofill", "map the fresh heap/stack pages on the shared zero frame till they're written (1: enable, 0: disable)", command_set_zero_fill, 1},
+		{"progcache", "share the frames of the program among its new envs, copied on write (1: enable, 0: disable)", command_set_program_cache, 1},
+		{"tickless", "arm the clock as a one-shot for each dispatch & skip the tick of a single runnable env (1: enable, 0: disable)", command_set_tickless, 1},
+		{"fastnclock", "sweep the Nth chance CLOCK in one pass instead of N turns of the hand (1: enable, 0: disable)", command_set_fast_nthCLOCK, 1},
+		{"pgtrace", "trace the page faults of each env in its ring (1: enable, 0: disable)", command_set_page_trace, 1},
+		{"pgtracecom1", "stream each traced page fault to COM1 in binary (1: enable, 0: disable)", command_set_page_trace_com1, 1},
+		{"pgtracedump", "print the page trace of the given environment (by its ID)", command_dump_page_trace, 1},
+		{"pgtraceexport", "send the page trace of the given environment (by its ID) to COM1 in binary", command_export_page_trace, 1},
 		{ "setStarvThr", "set the the starvation threshold of priority scheduler", command_set_starve_thresh, 1},
+		{ "setBoostPeriod", "set the # ticks between two priority boosts of the MLFQ scheduler (0: no boost)", command_set_mlfq_boost_period, 1},
 
 		//******************************//
 		/* COMMANDS WITH TWO ARGUMENTS */
@@ -104,6 +133,8 @@ struct Command commands[] =
 		/* COMMANDS WITH THREE ARGUMENTS */
 		//********************************//
 		{ "rub", "reads block of bytes from specific location in given environment" ,command_readuserblock, 3},
+		{ "reclaim", "set the low & high free frames watermarks (% of the frames) of the memory reclaimer", command_set_reclaim_watermarks, 2},
+		{ "pff", "set the page fault frequency window (# ticks), low & high thresholds (# faults per window) of the dynamic local replacement", command_set_pff, 3},
 		{ "schedPRIRR", "switch the scheduler to PRIORITY RR with given #priorities, quantum and starvation threshold", command_sch_PRIRR, 3},
 
 		//**************************************//
@@ -598,6 +629,10 @@ int command_meminfo(int number_of_arguments, char **arguments)
 			counters.freeBuffered+ counters.freeNotBuffered+ counters.modified, counters.freeBuffered, counters.freeNotBuffered, counters.modified);
 
 	cprintf("Num of calls for kheap_virtual_address [in last run] = %d\n", numOfKheapVACalls);
+#if USE_KHEAP
+	cprintf("\nKernel object caches:\n");
+	kmem_cache_print_all();
+#endif
 
 	return 0;
 }
@@ -826,6 +861,13 @@ int command_set_page_rep_nthCLOCK(int number_of_arguments, char **arguments)
 	cprintf("Page replacement algorithm is now N chance CLOCK\n");
 	return 0;
 }
+/*2025*/
+int command_set_fast_nthCLOCK(int number_of_arguments, char **arguments)
+{
+	setFASTNchanceCLOCK(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("FAST Nth chance CLOCK is now %s\n", FASTNchanceCLOCK ? "ENABLED" : "DISABLED");
+	return 0;
+}
 int command_set_page_rep_CLOCK(int number_of_arguments, char **arguments)
 {
 	setPageReplacmentAlgorithmCLOCK();
@@ -854,6 +896,35 @@ int command_set_page_rep_OPTIMAL(int number_of_arguments, char **arguments)
 	return 0;
 }
 
+/*2025*/
+int command_set_page_rep_DynamicLocal(int number_of_arguments, char **arguments)
+{
+	setPageReplacmentAlgorithmDynamicLocal();
+	cprintf("Page replacement algorithm is now DYNAMIC LOCAL (PFF window = %d ticks, thresholds = [%d, %d] faults)\n",
+			getPFFWindow(), getPFFLowThreshold(), getPFFHighThreshold());
+	return 0;
+}
+
+int command_set_pff(int number_of_arguments, char **arguments)
+{
+	setPFFParameters(strtol(arguments[1], NULL, 10), strtol(arguments[2], NULL, 10), strtol(arguments[3], NULL, 10));
+	cprintf("PFF window = %d ticks, thresholds = [%d, %d] faults\n", getPFFWindow(), getPFFLowThreshold(), getPFFHighThreshold());
+	return 0;
+}
+
+int command_set_reclaim_watermarks(int number_of_arguments, char **arguments)
+{
+	setReclaimWatermarks(strtol(arguments[1], NULL, 10), strtol(arguments[2], NULL, 10));
+	return command_get_reclaim_watermarks(number_of_arguments, arguments);
+}
+
+int command_get_reclaim_watermarks(int number_of_arguments, char **arguments)
+{
+	cprintf("Reclaimer watermarks: low = %d, high = %d free frames (of %d), currently free = %d\n",
+			getReclaimLowWatermark(), getReclaimHighWatermark(), number_of_frames, LIST_SIZE(&MemFrameLists.free_frame_list));
+	return 0;
+}
+
 /*2018*///BEGIN======================================================
 int command_sch_RR(int number_of_arguments, char **arguments)
 {
@@ -871,6 +942,11 @@ int command_sch_MLFQ(int number_of_arguments, char **arguments)
 	{
 		quantumOfEachLevel[i-2] = strtol(arguments[i], NULL, 10);
 	}
+	/*2025*/ //the levels without a given quantum take the last one
+	for (int i = number_of_arguments - 2 ; i > 0 && i < numOfLevels && i < MAX_ARGUMENTS - 2 ; i++)
+	{
+		quantumOfEachLevel[i] = quantumOfEachLevel[i-1];
+	}
 
 	sched_init_MLFQ(numOfLevels, quantumOfEachLevel);
 
@@ -912,6 +988,13 @@ int command_set_starve_thresh(int number_of_arguments, char **arguments)
 	sched_set_starv_thresh(starvationThresh);
 	return 0;
 }
+/*2025*/
+int command_set_mlfq_boost_period(int number_of_arguments, char **arguments)
+{
+	uint32 period = strtol(arguments[1], NULL, 10);
+	sched_set_mlfq_boost_period(period);
+	return 0;
+}
 //*********************************************************************************//
 
 int command_set_priority(int number_of_arguments, char **arguments)
@@ -933,6 +1016,7 @@ int command_print_sch_method(int number_of_arguments, char **arguments)
 			cprintf("%d   ", quantums[i]) ;
 		}
 		cprintf("\n");
+		/*2025*/ cprintf("Priority boost period = %d ticks\n", mlfq_boost_period);
 	}
 	else if (isSchedMethodRR())
 	{
@@ -980,11 +1064,15 @@ int command_print_page_rep(int number_of_arguments, char **arguments)
 		cprintf("Page replacement algorithm is Modified CLOCK\n");
 	else if (isPageReplacmentAlgorithmOPTIMAL())
 		cprintf("Page replacement algorithm is OPTIMAL\n");
+	else if (isPageReplacmentAlgorithmDynamicLocal())
+		cprintf("Page replacement algorithm is DYNAMIC LOCAL (PFF window = %d ticks, thresholds = [%d, %d] faults)\n",
+				getPFFWindow(), getPFFLowThreshold(), getPFFHighThreshold());
 	else if (isPageReplacmentAlgorithmNchanceCLOCK())
 	{
 		cprintf("Page replacement algorithm is Nth Chance CLOCK ");
-		if (page_WS_max_sweeps > 0)			cprintf("[NORMAL ver]\n");
-		else if (page_WS_max_sweeps < 0)	cprintf("[MODIFIED ver]\n");
+		if (page_WS_max_sweeps > 0)			cprintf("[NORMAL ver] ");
+		else if (page_WS_max_sweeps < 0)	cprintf("[MODIFIED ver] ");
+		cprintf("N = %d%s\n", page_WS_max_sweeps < 0 ? -page_WS_max_sweeps : page_WS_max_sweeps, FASTNchanceCLOCK ? " [FAST]" : "");
 	}
 	else
 		cprintf("Page replacement algorithm is UNDEFINED\n");
@@ -1052,6 +1140,20 @@ int command_print_uheap_plac(int number_of_arguments, char **arguments)
 	return 0;
 }
 
+/*2025*/
+int command_set_uheap_da_mode(int number_of_arguments, char **arguments)
+{
+	set_uheap_da_mode(strtol(arguments[1], NULL, 10) != 0 ? DA_MODE_BITMAP : DA_MODE_LIST);
+	cprintf("User Heap DA mode is now %s for the new envs\n", get_uheap_da_mode() == DA_MODE_BITMAP ? "BITMAP" : "LIST");
+	return 0;
+}
+
+int command_get_uheap_da_mode(int number_of_arguments, char **arguments)
+{
+	cprintf("User Heap DA mode is %s for the new envs\n", get_uheap_da_mode() == DA_MODE_BITMAP ? "BITMAP" : "LIST");
+	return 0;
+}
+
 /*2015*///END======================================================
 
 /*2017*///BEGIN======================================================
@@ -1212,6 +1314,136 @@ int command_get_modified_buffer_length(int number_of_arguments, char **arguments
 	return 0;
 }
 
+/*2025*/
+int command_set_fault_around_window(int number_of_arguments, char **arguments)
+{
+	setFaultAroundWindow(strtol(arguments[1], NULL, 10));
+	cprintf("Fault-around window updated = %d pages (max = %d)\n", getFaultAroundWindow(), FAULT_AROUND_MAX_WINDOW);
+	return 0;
+}
+
+int command_get_fault_around_window(int number_of_arguments, char **arguments)
+{
+	cprintf("Fault-around window = %d pages\n", getFaultAroundWindow());
+	return 0;
+}
+
+int command_set_ws_ring(int number_of_arguments, char **arguments)
+{
+	enableWSRing(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Array CLOCK working set is now %s for the new envs\n", isWSRingEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_get_ws_ring(int number_of_arguments, char **arguments)
+{
+	cprintf("Array CLOCK working set is %s for the new envs\n", isWSRingEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_set_zero_fill(int number_of_arguments, char **arguments)
+{
+	enableZeroFill(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Lazy zero-fill is now %s\n", isZeroFillEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_get_zero_fill(int number_of_arguments, char **arguments)
+{
+	cprintf("Lazy zero-fill is %s\n", isZeroFillEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_set_program_cache(int number_of_arguments, char **arguments)
+{
+	enableProgramCache(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Program frame cache is now %s for the new envs\n", isProgramCacheEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_get_program_cache(int number_of_arguments, char **arguments)
+{
+	program_cache_print();
+	return 0;
+}
+
+int command_set_tickless(int number_of_arguments, char **arguments)
+{
+	enableTickless(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Tickless clock is now %s\n", isTicklessEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_get_tickless(int number_of_arguments, char **arguments)
+{
+	cprintf("Tickless clock is %s\n", isTicklessEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_flush_program_cache(int number_of_arguments, char **arguments)
+{
+	cprintf("%d cached frames are freed\n", program_cache_flush());
+	return 0;
+}
+
+int command_print_clock_sweeps(int number_of_arguments, char **arguments)
+{
+	print_clock_sweep_histogram();
+	return 0;
+}
+
+int command_reset_clock_sweeps(int number_of_arguments, char **arguments)
+{
+	reset_clock_sweep_histogram();
+	cprintf("CLOCK sweep histogram is reset\n");
+	return 0;
+}
+
+int command_set_page_trace(int number_of_arguments, char **arguments)
+{
+	enablePageTrace(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Page trace is now %s\n", isPageTraceEnabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_set_page_trace_com1(int number_of_arguments, char **arguments)
+{
+	enablePageTraceCOM1(strtol(arguments[1], NULL, 10) != 0);
+	cprintf("Page trace streaming to COM1 is now %s\n", isPageTraceCOM1Enabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_get_page_trace(int number_of_arguments, char **arguments)
+{
+	cprintf("Page trace is %s, streaming to COM1 is %s\n",
+			isPageTraceEnabled() ? "ENABLED" : "DISABLED", isPageTraceCOM1Enabled() ? "ENABLED" : "DISABLED");
+	return 0;
+}
+
+int command_dump_page_trace(int number_of_arguments, char **arguments)
+{
+	struct Env* env = NULL;
+	if (envid2env(strtol(arguments[1], NULL, 10), &env, 0) < 0 || env == NULL)
+	{
+		cprintf("invalid environment ID\n");
+		return 0;
+	}
+	page_trace_print(env);
+	return 0;
+}
+
+int command_export_page_trace(int number_of_arguments, char **arguments)
+{
+	struct Env* env = NULL;
+	if (envid2env(strtol(arguments[1], NULL, 10), &env, 0) < 0 || env == NULL)
+	{
+		cprintf("invalid environment ID\n");
+		return 0;
+	}
+	cprintf("%d records are sent to COM1\n", page_trace_export(env));
+	return 0;
+}
+
 int command_tst(int number_of_arguments, char **arguments)
 {
 	return tst_handler(number_of_arguments, arguments);
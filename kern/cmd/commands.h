@@ -106,6 +106,10 @@ int command_set_page_rep_LRU(int number_of_arguments, char **arguments);
 int command_set_page_rep_ModifiedCLOCK(int number_of_arguments, char **arguments);
 int command_set_page_rep_nthCLOCK(int number_of_arguments, char **arguments);
 int command_set_page_rep_OPTIMAL(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_page_rep_DynamicLocal(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_pff(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_reclaim_watermarks(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_reclaim_watermarks(int number_of_arguments, char **arguments);
 int command_print_page_rep(int number_of_arguments, char **arguments);
 int command_disable_modified_buffer(int number_of_arguments, char **arguments);
 int command_enable_modified_buffer(int number_of_arguments, char **arguments);
@@ -114,6 +118,25 @@ int command_disable_buffering(int number_of_arguments, char **arguments);
 int command_enable_buffering(int number_of_arguments, char **arguments);
 int command_set_modified_buffer_length(int number_of_arguments, char **arguments);
 int command_get_modified_buffer_length(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_fault_around_window(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_fault_around_window(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_ws_ring(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_fast_nthCLOCK(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_ws_ring(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_zero_fill(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_zero_fill(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_program_cache(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_program_cache(int number_of_arguments, char **arguments);
+/*2025*/ int command_flush_program_cache(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_tickless(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_tickless(int number_of_arguments, char **arguments);
+/*2025*/ int command_print_clock_sweeps(int number_of_arguments, char **arguments);
+/*2025*/ int command_reset_clock_sweeps(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_page_trace(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_page_trace_com1(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_page_trace(int number_of_arguments, char **arguments);
+/*2025*/ int command_dump_page_trace(int number_of_arguments, char **arguments);
+/*2025*/ int command_export_page_trace(int number_of_arguments, char **arguments);
 
 //USER HEAP Commands
 //======================
@@ -123,6 +146,8 @@ int command_set_uheap_plac_NEXTFIT(int number_of_arguments, char **arguments);
 int command_set_uheap_plac_WORSTFIT(int number_of_arguments, char **arguments);
 int command_set_uheap_plac_CUSTOMFIT(int number_of_arguments, char **arguments);
 int command_print_uheap_plac(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_uheap_da_mode(int number_of_arguments, char **arguments);
+/*2025*/ int command_get_uheap_da_mode(int number_of_arguments, char **arguments);
 
 //KERNEL HEAP Commands
 //======================
@@ -146,5 +171,6 @@ int command_sch_test(int number_of_arguments, char **arguments);
 int command_set_priority(int number_of_arguments, char **arguments);
 int command_sch_PRIRR(int number_of_arguments, char **arguments);
 int command_set_starve_thresh(int number_of_arguments, char **arguments);
+/*2025*/ int command_set_mlfq_boost_period(int number_of_arguments, char **arguments);
 
 #endif /* KERN_CMD_COMMANDS_H_ */
@@ -7,6 +7,8 @@
 #include "channel.h"
 #include <kern/proc/user_environment.h>
 #include <kern/cpu/sched.h>
+#include <kern/cpu/kclock.h>
+#include <kern/cpu/timer_wheel.h>
 #include <inc/string.h>
 #include <inc/disk.h>
 
@@ -17,6 +19,13 @@
 void init_channel(struct Channel *chan, char *name) {
 	strcpy(chan->name, name);
 	init_queue(&(chan->queue));
+	/*2025*/ chan->isIOWait = 0;
+}
+
+/*2025*/
+//Mark the channel as an I/O wait one (see sleep_on())
+void set_channel_io_wait(struct Channel *chan, uint8 isIOWait) {
+	chan->isIOWait = isIOWait;
 }
 
 //===============================
@@ -25,17 +34,79 @@ void init_channel(struct Channel *chan, char *name) {
 // Atomically release lock and sleep on chan.
 // Reacquires lock when awakened.
 // Ref: xv6-x86 OS code
-void sleep(struct Channel *chan, struct kspinlock *OurLock) {
-	acquire_kspinlock(&ProcessQueues.qlock);
-	if (OurLock != NULL)
-		release_kspinlock(OurLock);
+/*2025*/
+//Block the current env on chan, with the given timer (if any) added to wake it up. The qlock should be held
+static void sleep_on(struct Channel *chan, struct Timer *timer, uint64 timeout_ns) {
 	struct Env *cur = get_cpu_proc();
+	/*2025*/ //MLFQ: an env that blocks on an I/O (e.g. the disk, keyboard or a timed sleep) moves one level up.
+	//	The lock waits & the kernel daemons' waits (e.g. on a free frame) don't count
+	if (isSchedMethodMLFQ() && chan->isIOWait && cur->priority > 0)
+		cur->priority--;
+	if (timer != NULL) {
+		timer->env = cur;
+		timer->chan = chan;
+		timer_add(timer, kclock_now_ns() + timeout_ns);
+		cur->sleepTimer = timer;
+	}
 	cur->env_status = ENV_BLOCKED;
 	enqueue(&(chan->queue), cur);
 	sched();
+	//already cancelled if it's woken up before its timer (see wakeup_env())
+	cur->sleepTimer = NULL;
+}
+
+//Move the given blocked env (just dequeued from its channel) to the ready queue. The qlock should be held.
+//	Its sleep timer (if any) is cancelled here: the timer lives on its kernel stack, which is freed if it's killed
+//	before it runs again
+static void wakeup_env(struct Env *e) {
+	if (e->sleepTimer != NULL) {
+		timer_cancel(e->sleepTimer);
+		e->sleepTimer = NULL;
+	}
+	e->env_status = ENV_READY;
+	sched_insert_ready(e);
+}
+
+void sleep(struct Channel *chan, struct kspinlock *OurLock) {
+	acquire_kspinlock(&ProcessQueues.qlock);
+	if (OurLock != NULL)
+		release_kspinlock(OurLock);
+	/*2025*/ sleep_on(chan, NULL, 0);
+	if (OurLock != NULL)
+		acquire_kspinlock(OurLock);
+	release_kspinlock(&ProcessQueues.qlock);
+}
+
+/*2025*/
+//Expiration of a timed sleep: take the env out of its channel (if it's not woken up yet) into the ready queue
+static void sleep_timer_expired(struct Timer *timer) {
+	timer->env->sleepTimer = NULL;
+	if (timer->env->env_status == ENV_BLOCKED) {
+		LIST_REMOVE(&(timer->chan->queue), timer->env);
+		sched_insert_ready(timer->env);
+	}
+	else {
+		timer->fired = 0;
+	}
+}
+
+//Same as sleep() but gives up after the given timeout (in ns).
+//	Returns 1 if it's woken up, 0 if it's timed out
+int sleep_timeout(struct Channel *chan, struct kspinlock *OurLock, uint64 timeout_ns) {
+	//it lives on the kernel stack of the env while it's blocked
+	struct Timer timer;
+	timer.func = sleep_timer_expired;
+	timer.slot = NULL;
+	timer.fired = 0;
+
+	acquire_kspinlock(&ProcessQueues.qlock);
+	if (OurLock != NULL)
+		release_kspinlock(OurLock);
+	sleep_on(chan, &timer, timeout_ns);
 	if (OurLock != NULL)
 		acquire_kspinlock(OurLock);
 	release_kspinlock(&ProcessQueues.qlock);
+	return !timer.fired;
 }
 
 //==================================================
@@ -49,8 +120,7 @@ void wakeup_one(struct Channel *chan) {
 	acquire_kspinlock(&ProcessQueues.qlock);
 	struct Env *cur = dequeue(&(chan->queue));
 	if (cur != NULL) {
-		cur->env_status = ENV_READY;
-		sched_insert_ready(cur);
+		/*2025*/ wakeup_env(cur);
 	}
 	release_kspinlock(&ProcessQueues.qlock);
 }
@@ -67,8 +137,7 @@ void wakeup_all(struct Channel *chan) {
 	acquire_kspinlock(&ProcessQueues.qlock);
 	struct Env *all;
 	while ((all = dequeue(&(chan->queue))) != NULL) {
-		all->env_status = ENV_READY;
-		sched_insert_ready(all);
+		/*2025*/ wakeup_env(all);
 	}
 	release_kspinlock(&ProcessQueues.qlock);
 }
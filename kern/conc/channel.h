@@ -15,12 +15,15 @@ struct Channel
 {
 	struct Env_Queue queue;	//queue of blocked processes waiting on this channel
 	char name[NAMELEN];     //channel name
+	uint8 isIOWait;			//2025: a wait on it is an I/O wait (disk, keyboard, timed sleep): MLFQ moves the env one level up
 };
 
 void init_channel(struct Channel *chan, char *name);
+/*2025*/ void set_channel_io_wait(struct Channel *chan, uint8 isIOWait);
 void sleep(struct Channel *chan, struct kspinlock* lk); 	//block the running process on the given channel (queue) using the given lk
 void wakeup_one(struct Channel *chan);					//wakeup ONE blocked process on the given channel (queue)
 void wakeup_all(struct Channel *chan);					//wakeup ALL blocked processes on the given channel (queue)
+/*2025*/ int sleep_timeout(struct Channel *chan, struct kspinlock* lk, uint64 timeout_ns);	//sleep() for the given time at most (0: timed out)
 
 
 #endif /* KERN_CONC_CHANNEL_H_ */
@@ -27,6 +27,23 @@ void wait_ksemaphore(struct ksemaphore *Ksemaphore) {
 	release_kspinlock(&(Ksemaphore->lk));
 }
 
+/*2025*/
+//Same as wait_ksemaphore() but gives up after the given timeout (in ns).
+//	Returns 1 if it's acquired, 0 if it's timed out
+int wait_ksemaphore_timeout(struct ksemaphore *Ksemaphore, uint64 timeout_ns) {
+	int acquired = 1;
+	acquire_kspinlock(&(Ksemaphore->lk));
+	Ksemaphore->count--;
+	if (Ksemaphore->count < 0) {
+		acquired = sleep_timeout(&(Ksemaphore->chan), &(Ksemaphore->lk), timeout_ns);
+		//it's not waiting anymore: give back its decrement
+		if (!acquired)
+			Ksemaphore->count++;
+	}
+	release_kspinlock(&(Ksemaphore->lk));
+	return acquired;
+}
+
 void signal_ksemaphore(struct ksemaphore *Ksemaphore) {
 	acquire_kspinlock(&(Ksemaphore->lk));
 	Ksemaphore->count++;
@@ -22,6 +22,7 @@ int text_length = 0;
 #define COM1		0x3F8
 
 #define COM_RX		0	// In:	Receive buffer (DLAB=0)
+#define COM_TX		0	// Out: Transmit buffer (DLAB=0)
 #define COM_DLL		0	// Out: Divisor Latch Low (DLAB=1)
 #define COM_DLM		1	// Out: Divisor Latch High (DLAB=1)
 #define COM_IER		1	// Out: Interrupt Enable Register
@@ -37,6 +38,7 @@ int text_length = 0;
 #define	  COM_MCR_OUT2	0x08	// Out2 complement
 #define COM_LSR		5	// In:	Line Status Register
 #define   COM_LSR_DATA	0x01	//   Data available
+#define   COM_LSR_TXRDY	0x20	//   Transmit buffer avail
 
 static bool serial_exists;
 
@@ -90,6 +92,22 @@ serial_init(void)
 
 }
 
+static void delay(void);
+
+/*2025*/
+//send one byte to COM1 (e.g. the page trace stream)
+void
+serial_putc(int c)
+{
+	int i;
+
+	if (!serial_exists)
+		return;
+	for (i = 0; !(inb(COM1 + COM_LSR) & COM_LSR_TXRDY) && i < 12800; i++)
+		delay();
+	outb(COM1 + COM_TX, c);
+}
+
 
 
 /***** Parallel port output code *****/
@@ -388,11 +406,13 @@ kbd_init(void)
 	if (KBD_INT_BLK_METHOD == LCK_SLEEP)
 	{
 		init_channel(&KBDchannel, "keyboard channel");
+		/*2025*/ set_channel_io_wait(&KBDchannel, 1);
 		init_kspinlock(&KBDlock, "keyboard channel lock");
 	}
 	else if (KBD_INT_BLK_METHOD == LCK_SEMAPHORE)
 	{
 		init_ksemaphore(&KBDsem, 0, "keyboard semaphore");
+		/*2025*/ set_channel_io_wait(&(KBDsem.chan), 1);
 	}
 }
 
@@ -40,6 +40,7 @@ struct ksemaphore KBDsem;				//semaphore to manage KBD interrupts
 
 void kbd_intr(void); // irq 1
 void serial_intr(void); // irq 4
+/*2025*/ void serial_putc(int c);
 void keyboard_interrupt_handler();
 
 /*2025*/
@@ -17,6 +17,9 @@
 #include <kern/cpu/sched.h>
 #include <kern/trap/trap.h>
 
+/*2025*/
+#define KCLOCK_PORTB				0x61		//system control port B: PIT counter 2 gate & output
+#define KCLOCK_CALIBRATE_MAX_LOOPS	(1 << 26)	//give up the calibration if the counter 2 never expires
 
 unsigned
 mc146818_read(unsigned reg)
@@ -39,11 +42,94 @@ mc146818_write(unsigned reg, unsigned datum)
  * (which depends on the mode).
  */
 
+/*2025*/
+static uint8 kclock_quantum = 0;	//last quantum set by kclock_set_quantum()
+static uint8 kclock_armed = 1;		//tickless: is a one-shot interrupt due? (0: it's expired or skipped)
+static uint16 kclock_armed_cnt = 0;	//tickless: the count it's armed with
+static uint8 kclock_short = 0;		//the last armed count is shorter than a quantum (e.g. till the next timer)
+static uint64 kclock_slice_end = 0;	//end of the slice of the running env in ns (0: idle, see kclock_arm_idle())
+
+static uint64 tsc_base = 0;			//TSC at the calibration (time 0 of the monotonic clock)
+static uint32 tsc_khz = 0;			//# TSC cycles per ms
+static uint32 tsc_ns_mult = 0;		//ns per cycle << TSC_NS_SHIFT
+
+void enableTickless(uint32 enableIt){_EnableTickless = enableIt;}
+uint8 isTicklessEnabled(){  return _EnableTickless ; }
+
+//CNT0 mode: a rate generator, or a one-shot (interrupt on terminal count) in the tickless mode
+static uint8 kclock_mode()
+{
+	return TIMER_SEL0 | (isTicklessEnabled() ? TIMER_INTTC : TIMER_RATEGEN) | TIMER_16BIT;
+}
+
+//floor((n << shift) / d) by a long division, so no 64-bit division is needed (d < 2^31)
+static uint32 kclock_div_shifted(uint32 n, uint32 d, int shift)
+{
+	uint32 q = n / d;
+	uint32 r = n % d;
+	for (int i = 0; i < shift; i++)
+	{
+		r <<= 1;
+		q <<= 1;
+		if (r >= d)
+		{
+			r -= d;
+			q |= 1;
+		}
+	}
+	return q;
+}
+
+//Count the TSC cycles of TSC_CALIBRATE_MS ms on the PIT counter 2 (its gate is in the port B, bit 0 & its output in bit 5),
+//	so the counter 0 (the clock) isn't touched
+static void kclock_calibrate_tsc()
+{
+	uint8 portB = inb(KCLOCK_PORTB);
+	outb(KCLOCK_PORTB, (portB & ~0x02) | 0x01);		//gate on, speaker off
+	outb(TIMER_MODE, TIMER_SEL2 | TIMER_INTTC | TIMER_16BIT);
+	uint16 cnt = TIMER_DIV(1000 / TSC_CALIBRATE_MS);
+	outb(TIMER_CNTR2, cnt & 0xFF);
+	outb(TIMER_CNTR2, cnt >> 8);
+
+	uint64 start = read_tsc();
+	uint32 loops = 0;
+	while ((inb(KCLOCK_PORTB) & 0x20) == 0 && ++loops < KCLOCK_CALIBRATE_MAX_LOOPS) ;
+	uint64 end = read_tsc();
+	outb(KCLOCK_PORTB, portB);
+
+	tsc_khz = (uint32)(end - start) / TSC_CALIBRATE_MS;
+	if (loops >= KCLOCK_CALIBRATE_MAX_LOOPS || tsc_khz < 1000)
+	{
+		cprintf("*	TSC calibration failed, assuming 1 GHz\n");
+		tsc_khz = 1000000;
+	}
+	tsc_ns_mult = kclock_div_shifted(1000000, tsc_khz, TSC_NS_SHIFT);
+	tsc_base = read_tsc();
+}
+
 void kclock_init()
 {
 	ticks = 0;
+	/*2025*/ enableTickless(0);
+	/*2025*/ kclock_calibrate_tsc();
 	irq_install_handler(0, &clock_interrupt_handler);
 }
+
+/*2025*/
+//Nanoseconds since the boot (the TSC calibration)
+uint64 kclock_now_ns(void)
+{
+	uint64 cycles = read_tsc() - tsc_base;
+	//(cycles * tsc_ns_mult) >> TSC_NS_SHIFT on the 32-bit halves of cycles, so it can't overflow
+	uint64 hi = (cycles >> 32) * tsc_ns_mult;
+	uint64 lo = ((cycles & 0xFFFFFFFF) * tsc_ns_mult) >> TSC_NS_SHIFT;
+	return (hi << (32 - TSC_NS_SHIFT)) + lo;
+}
+
+uint32 kclock_tsc_khz(void)
+{
+	return tsc_khz;
+}
 void
 kclock_start(uint8 quantum_in_ms)
 {
@@ -108,7 +194,7 @@ kclock_stop(void)
 	//outb(TIMER_CNTR0, 0x00) ;
 
 
-	outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+	outb(TIMER_MODE, kclock_mode());
 
 //	uint16 cnt0 = kclock_read_cnt0() ;
 //	cprintf("Timer STOPPED: Counter0 = %d\n", cnt0 );
@@ -150,7 +236,16 @@ kclock_resume(void)
 	 * The main benefit of the latch command is that it allows both bytes of the current count to be read without inconsistencies. For example, if you didn't use the latch command, then the current count may decrease from 0x0200 to 0x01FF after you've read the low byte but before you've read the high byte, so that your software thinks the counter was 0x0100 instead of 0x0200 (or 0x01FF).
 	 */
 	//uint16 cnt0 = kclock_read_cnt0() ;
+	/*2025*/ //Tickless: no interrupt is due (e.g. a single runnable env), keep it masked
+	if (isTicklessEnabled() && !kclock_armed)
+		return;
+
 	uint16 cnt0 = kclock_read_cnt0_latch() ;
+	/*2025*/ //Tickless: the one-shot has expired (& wrapped around) while in the kernel, so fire it ASAP
+	if (isTicklessEnabled() && cnt0 > kclock_armed_cnt)
+	{
+		cnt0 = 0;
+	}
 	//cprintf("CLOCK RESUMED: Counter0 Value = %d\n", cnt0 );
 	//2017: if the remaining time is small, then increase it a bit to avoid invoking the CLOCK INT
 	//		before returning back to the environment (this cause INT inside INT!!!) el7 :)
@@ -162,7 +257,7 @@ kclock_resume(void)
 	if (cnt0 % 2 == 1)
 		cnt0++;
 
-	outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+	outb(TIMER_MODE, kclock_mode());
 	kclock_write_cnt0_LSB_first(cnt0) ;
 
 	//Busy-wait until the new cnt value is loaded from CR (Count Register) to CE (Count Element)
@@ -203,7 +298,7 @@ kclock_resume(void)
 
 void kclock_start_counter(uint8 cnt0)
 {
-	outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+	outb(TIMER_MODE, kclock_mode());
 	kclock_write_cnt0_LSB_first(cnt0) ;
 	//irq_setmask_8259A(irq_mask_8259A & ~(1<<0));
 	irq_clear_mask(0);
@@ -220,10 +315,15 @@ void kclock_set_quantum(uint8 quantum_in_ms)
 //		if (cnt%2 == 1)
 //			cnt++;
 		int cnt = NUM_CLKS_PER_QUANTUM(quantum_in_ms);
+		/*2025*/
+		kclock_quantum = quantum_in_ms;
+		kclock_armed = 1;
+		kclock_armed_cnt = cnt;
+		kclock_short = 0;
 
 
 		//cprintf("QUANTUM is set to %d ms (%d)\n", quantum_in_ms, TIMER_DIV((1000/quantum_in_ms)));
-		outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+		outb(TIMER_MODE, kclock_mode());
 		kclock_write_cnt0_LSB_first(cnt) ;
 		kclock_stop();
 		//uint16 cnt0 = kclock_read_cnt0_latch() ; //read after write to ensure it's set to the desired value
@@ -236,6 +336,93 @@ void kclock_set_quantum(uint8 quantum_in_ms)
 }
 //==============
 
+/*2025*/
+//Tickless: arm the one-shot to interrupt after the given count (from now) without affecting the interrupt status
+void kclock_arm(uint16 cnt0)
+{
+	kclock_armed = 1;
+	kclock_armed_cnt = cnt0;
+	kclock_short = cnt0 < NUM_CLKS_PER_QUANTUM(kclock_quantum);
+	outb(TIMER_MODE, kclock_mode());
+	kclock_write_cnt0_LSB_first(cnt0) ;
+	kclock_stop();
+}
+
+//Tickless: no interrupt is due (it's just expired, or there's nothing to preempt), so it stays masked till it's armed again
+void kclock_disarm(void)
+{
+	kclock_armed = 0;
+	kclock_stop();
+}
+
+uint8 kclock_is_armed(void)
+{
+	return kclock_armed;
+}
+
+//Tickless: arm the one-shot for a whole quantum (the last one set by kclock_set_quantum())
+void kclock_arm_quantum(void)
+{
+	kclock_arm(NUM_CLKS_PER_QUANTUM(kclock_quantum));
+}
+
+/*2025*/
+//The PIT count of the given duration: [20, 0xFFFF] (~55 ms at most)
+uint16 kclock_ns_to_cnt(uint64 ns)
+{
+	if (ns >= (uint64)0xFFFF * PIT_NS_PER_CLK)
+		return 0xFFFF;
+	uint32 cnt = (uint32)ns / PIT_NS_PER_CLK;
+	return cnt < 20 ? 20 : cnt;
+}
+
+//A new slice starts (on a dispatch): it ends after a quantum from now, even if the clock is armed for less
+void kclock_start_slice(void)
+{
+	kclock_slice_end = kclock_now_ns() + (uint64)kclock_quantum * 1000000;
+}
+
+//Arm the clock for the slice of the next env: a quantum, or less if the next event (e.g. a timer) is due before.
+//	The rate generator (not tickless) keeps its running quantum unless it's shortened, then it's restored on the next slice
+void kclock_arm_slice(uint64 max_ns)
+{
+	uint16 cnt = NUM_CLKS_PER_QUANTUM(kclock_quantum);
+	uint16 max_cnt = kclock_ns_to_cnt(max_ns);
+	if (max_cnt < cnt)
+		kclock_arm(max_cnt);
+	else if (isTicklessEnabled())
+		kclock_arm(cnt);
+	else if (kclock_short)
+		kclock_set_quantum(kclock_quantum);
+}
+
+//Idle (interrupts disabled): arm the clock & unmask it to interrupt after the given duration (e.g. the next timer)
+void kclock_arm_idle(uint64 ns)
+{
+	kclock_arm(kclock_ns_to_cnt(ns));
+	kclock_short = 1;
+	kclock_slice_end = 0;
+	irq_clear_mask(0);
+}
+
+//The clock has just fired: is it an early fire, i.e. it's armed shorter than a quantum (e.g. till the next timer,
+//	or by the idle scheduler) & the slice isn't over yet? If so, the rest of the slice is set in rest_ns (0 if idle).
+//Returns 0 if it's the end of the slice (i.e. a normal tick)
+int kclock_slice_rest(uint64 now_ns, uint64* rest_ns)
+{
+	*rest_ns = 0;
+	if (!kclock_short)
+		return 0;
+	if (kclock_slice_end == 0)
+		return 1;
+	//the shortest count (see kclock_ns_to_cnt()) is too short to be worth it: consider the slice over
+	if (now_ns + 20 * PIT_NS_PER_CLK >= kclock_slice_end)
+		return 0;
+	*rest_ns = kclock_slice_end - now_ns;
+	return 1;
+}
+//==============
+
 
 //2017
 void
@@ -49,6 +49,29 @@ void kclock_write_cnt0_LSB_first(uint16 val);
 //2018
 void kclock_set_quantum(uint8 quantum_in_ms);
 
+/*2025*/
+//Tickless mode: CNT0 is a one-shot (interrupt on terminal count) armed by the scheduler for each dispatch
+uint32 _EnableTickless;
+void enableTickless(uint32 enableIt);
+uint8 isTicklessEnabled();
+void kclock_arm(uint16 cnt0);
+void kclock_disarm(void);
+uint8 kclock_is_armed(void);
+void kclock_arm_quantum(void);
+void kclock_start_slice(void);
+void kclock_arm_slice(uint64 max_ns);
+void kclock_arm_idle(uint64 ns);
+int kclock_slice_rest(uint64 now_ns, uint64* rest_ns);
+uint16 kclock_ns_to_cnt(uint64 ns);
+
+/*2025*/
+//Monotonic clock: the TSC calibrated against the PIT at boot
+#define TSC_CALIBRATE_MS	10		//length of the calibration window
+#define TSC_NS_SHIFT		22		//ns = (cycles * tsc_ns_mult) >> TSC_NS_SHIFT
+#define PIT_NS_PER_CLK		838		//1e9 / TIMER_FREQ
+uint64 kclock_now_ns(void);
+uint32 kclock_tsc_khz(void);
+
 
 extern uint32 virtualTime;
 
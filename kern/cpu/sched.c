@@ -6,10 +6,14 @@
 #include <kern/trap/trap.h>
 #include <kern/mem/kheap.h>
 #include <kern/mem/memory_manager.h>
+#include <kern/mem/writeback.h>
+#include <kern/mem/reclaimer.h>
+#include <kern/mem/working_set_manager.h>
 #include <kern/tests/utilities.h>
 #include <kern/cmd/command_prompt.h>
 #include <kern/cpu/cpu.h>
 #include <kern/cpu/picirq.h>
+#include <kern/cpu/timer_wheel.h>
 
 uint32 isSchedMethodRR() {
 	return (scheduler_method == SCH_RR);
@@ -35,11 +39,36 @@ static struct Env* (*sched_next[])(void) = {
 
 };
 
+/*2025*/
+static int64 mlfq_last_boost = 0;		//ticks of the last MLFQ boost
+static uint8 mlfq_quantum_expired = 0;	//set by the clock interrupt: the current env has used up its quantum
+static uint32 bsd_ticks_per_second = 1;	//# ticks (quantums) per second under BSD
+static int64 bsd_second_tick = 0;		//ticks of the last BSD per-second update
+
+/*2025*/
+//Is any env waiting in the ready queue(s)?
+static int sched_any_ready()
+{
+	for (int level = 0; level < num_of_ready_queues; level++) {
+		if (!LIST_EMPTY(&(ProcessQueues.env_ready_queues[level])))
+			return 1;
+	}
+	return 0;
+}
+
+//Is there a work to do on each tick other than the preemption? (then the tick can't be skipped)
+static int sched_tick_needed()
+{
+	return isSchedMethodBSD() || isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX)
+			|| isPageReplacmentAlgorithmDynamicLocal();
+}
+
 //===================================
 // [1] Default Scheduler Initializer:
 //===================================
 void sched_init() {
 	old_pf_counter = 0;
+	/*2025*/ sched_set_mlfq_boost_period(MLFQ_DEFAULT_BOOST_PERIOD);
 
 	sched_init_RR(INIT_QUANTUM_IN_MS);
 
@@ -98,6 +127,21 @@ void fos_scheduler(void) {
 
 				//Change its status to RUNNING
 				next_env->env_status = ENV_RUNNING;
+				/*2025*/ next_env->lastRunTick = ticks;
+
+				/*2025*/ //Arm the clock for the slice of the next env, cut at the next timer (if any).
+				//	Tickless: skip the tick if it's the only runnable env (it's armed again once another one gets ready)
+				uint64 timer_delta_ns = 0;
+				int timer_pending = timer_next_expiry(kclock_now_ns(), &timer_delta_ns);
+				kclock_start_slice();
+				if (isTicklessEnabled() && !sched_any_ready() && !sched_tick_needed()) {
+					if (timer_pending)
+						kclock_arm(kclock_ns_to_cnt(timer_delta_ns));
+					else
+						kclock_disarm();
+				} else {
+					kclock_arm_slice(timer_pending ? timer_delta_ns : (uint64)-1);
+				}
 
 				//Context switch to it
 				context_switch(&(c->scheduler), next_env->context);
@@ -133,13 +177,31 @@ void fos_scheduler(void) {
 		//2024 - check if there's any blocked process?
 		is_any_blocked = 0;
 		for (int i = 0; i < NENV; ++i) {
-			if (envs[i].env_status == ENV_BLOCKED) {
+			//the write-back & the reclaimer daemons are always there, sleeping till there's a work to do
+			if (envs[i].env_status == ENV_BLOCKED && &envs[i] != WriteBackDaemon && &envs[i] != ReclaimerDaemon) {
 				is_any_blocked = 1;
 				break;
 			}
 		}
 		release_kspinlock(&ProcessQueues.qlock); //release lock: to protect ready & blocked Qs in multi-CPU
 		//cprintf("\n[FOS_SCHEDULER] release: lock status after = %d\n", qlock.locked);
+
+		/*2025*/ //Idle: all the envs are blocked, so halt till the next interrupt (e.g. the disk or the keyboard) instead of spinning.
+		//	The ready queues are re-checked with the interrupts disabled, so a wakeup can't slip in before the hlt
+		//	If some of them are sleeping for a time, the clock is armed for the first one to wake up
+		if (is_any_blocked) {
+			cli();
+			acquire_kspinlock(&ProcessQueues.qlock);
+			int any_ready = sched_any_ready();
+			uint64 timer_delta_ns = 0;
+			int timer_pending = timer_next_expiry(kclock_now_ns(), &timer_delta_ns);
+			release_kspinlock(&ProcessQueues.qlock);
+			if (!any_ready) {
+				if (timer_pending)
+					kclock_arm_idle(timer_delta_ns);
+				sti_hlt();
+			}
+		}
 	} while (is_any_blocked > 0);
 
 	/*2015*///No more envs... curenv doesn't exist any more! return back to command prompt
@@ -178,7 +240,26 @@ void sched_init_RR(uint8 quantum) {
 // [4] Initialize MLFQ Scheduler:
 //===============================
 void sched_init_MLFQ(uint8 numOfLevels, uint8 *quantumOfEachLevel) {
-	panic("Not implemented yet");
+	/*2025*/
+	{
+		num_of_ready_queues = numOfLevels;
+#if USE_KHEAP
+		sched_delete_ready_queues();
+		ProcessQueues.env_ready_queues = kmalloc(
+				(sizeof(struct Env_Queue)) * num_of_ready_queues);
+		quantums = kmalloc(sizeof(uint8) * num_of_ready_queues);
+		if (ProcessQueues.env_ready_queues == NULL || quantums == NULL)
+			panic("sched_init_MLFQ(): NOT ENOUGH KERNEL HEAP SPACE");
+#endif
+		for (uint8 i = 0; i < numOfLevels; i++) {
+			init_queue(&(ProcessQueues.env_ready_queues[i]));
+			quantums[i] = quantumOfEachLevel[i];
+		}
+		for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++)
+			ready_queues_bitmap[w] = 0;
+		mlfq_last_boost = ticks;
+		kclock_set_quantum(quantums[0]);
+	}
 
 	//=========================================
 	//DON'T CHANGE THESE LINES=================
@@ -195,7 +276,28 @@ void sched_init_MLFQ(uint8 numOfLevels, uint8 *quantumOfEachLevel) {
 // [5] Initialize BSD Scheduler:
 //===============================
 void sched_init_BSD(uint8 numOfLevels, uint8 quantum) {
-	panic("Not implemented yet");
+	/*2025*/
+	{
+		num_of_ready_queues = numOfLevels;
+#if USE_KHEAP
+		sched_delete_ready_queues();
+		ProcessQueues.env_ready_queues = kmalloc(
+				(sizeof(struct Env_Queue)) * num_of_ready_queues);
+		quantums = kmalloc(sizeof(uint8) * num_of_ready_queues);
+		if (ProcessQueues.env_ready_queues == NULL || quantums == NULL)
+			panic("sched_init_BSD(): NOT ENOUGH KERNEL HEAP SPACE");
+#endif
+		for (uint8 i = 0; i < numOfLevels; i++) {
+			init_queue(&(ProcessQueues.env_ready_queues[i]));
+			quantums[i] = quantum;
+		}
+		for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++)
+			ready_queues_bitmap[w] = 0;
+		load_avg = fix_int(0);
+		bsd_ticks_per_second = MAX(1, 1000 / MAX(1, quantum));
+		bsd_second_tick = ticks;
+		kclock_set_quantum(quantum);
+	}
 
 	//=========================================
 	//DON'T CHANGE THESE LINES=================
@@ -228,6 +330,9 @@ void sched_init_PRIRR(uint8 numOfPriorities, uint8 quantum, uint32 starvThresh)
 			init_queue(&(ProcessQueues.env_ready_queues[i]));
 			quantums[i] = quantum;
 		}
+		/*2025*/
+		for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++)
+			ready_queues_bitmap[w] = 0;
 		kclock_set_quantum(quantums[0]);
 	}
 	//=========================================
@@ -240,6 +345,20 @@ void sched_init_PRIRR(uint8 numOfPriorities, uint8 quantum, uint32 starvThresh)
 	//=========================================
 }
 
+//Highest non-empty ready level by the bitmap (PRIRR, MLFQ & BSD) (find-first-set), clearing the stale bits on the way. -1 if all are empty
+static int first_ready_level()
+{
+	for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++) {
+		while (ready_queues_bitmap[w]) {
+			int level = w * 32 + bsf(ready_queues_bitmap[w]);
+			if (level < num_of_ready_queues && !LIST_EMPTY(&(ProcessQueues.env_ready_queues[level])))
+				return level;
+			READY_QUEUES_BITMAP_CLEAR(level);
+		}
+	}
+	return -1;
+}
+
 //=========================
 // [7] RR Scheduler:
 //=========================
@@ -277,6 +396,26 @@ struct Env* fos_scheduler_RR() {
 //=========================
 // [8] MLFQ Scheduler:
 //=========================
+/*2025*/
+//Move all the ready envs to the top level (the oldest of each level first, so their order is kept)
+//	& the blocked ones too, so they get it on their wakeup
+static void mlfq_boost()
+{
+	for (int level = 1; level < num_of_ready_queues; level++) {
+		struct Env* e;
+		while ((e = dequeue(&(ProcessQueues.env_ready_queues[level]))) != NULL) {
+			e->priority = 0;
+			sched_insert_ready(e);
+		}
+		READY_QUEUES_BITMAP_CLEAR(level);
+	}
+	for (int i = 0; i < NENV; i++) {
+		if (envs[i].env_status == ENV_BLOCKED)
+			envs[i].priority = 0;
+	}
+	mlfq_last_boost = ticks;
+}
+
 struct Env* fos_scheduler_MLFQ() {
 	//Apply the MLFQ with the specified levels to pick up the next environment
 	//Note: the "curenv" (if exist) should be placed in its correct queue
@@ -285,24 +424,122 @@ struct Env* fos_scheduler_MLFQ() {
 		panic(
 				"fos_scheduler_MLFQ: q.lock is not held by this CPU while it's expected to be.");
 	/****************************************************************************************/
-	panic("Not implemented yet");
+	/*2025*/
+	struct Env *next_env = NULL;
+	struct Env *cur_env = get_cpu_proc();
+
+	//[1] Re-insert the current env (if any): one level down if it has used up its quantum,
+	//	else it has given up the CPU by itself, so it keeps its level
+	if (cur_env != NULL) {
+		if (mlfq_quantum_expired && cur_env->priority < num_of_ready_queues - 1)
+			cur_env->priority++;
+		sched_insert_ready(cur_env);
+	}
+	mlfq_quantum_expired = 0;
+
+	//[2] Boost all the envs to the top level periodically, so the CPU-bound ones at the bottom can't starve
+	if (mlfq_boost_period > 0 && ticks - mlfq_last_boost >= mlfq_boost_period)
+		mlfq_boost();
+
+	//[3] Pick the next env from the highest non-empty level, with the quantum of its level
+	int level = first_ready_level();
+	if (level >= 0) {
+		next_env = dequeue(&(ProcessQueues.env_ready_queues[level]));
+		kclock_set_quantum(quantums[level]);
+	}
+	return next_env;
 }
 
 //=========================
 // [9] BSD Scheduler:
 //=========================
+/*2025*/
+//Once per second: update the load average, then decay the recent CPU of the ready envs & move them to their new levels.
+//	The running env is decayed on its re-insertion & the blocked ones on their wakeup (see env_update_bsd_level())
+static void bsd_update_second(struct Env* cur_env)
+{
+	//load_avg = (59/60)*load_avg + (1/60)*(# ready & running envs)
+	int numOfReady = cur_env != NULL ? 1 : 0;
+	for (int level = 0; level < num_of_ready_queues; level++)
+		numOfReady += LIST_SIZE(&(ProcessQueues.env_ready_queues[level]));
+	load_avg = fix_add(fix_mul(fix_frac(59, 60), load_avg), fix_frac(numOfReady, 60));
+	bsd_seconds++;
+
+	//detach them (the oldest of the highest level first) & re-insert them, so they keep their order
+	struct Env_Queue ready;
+	init_queue(&ready);
+	for (int level = 0; level < num_of_ready_queues; level++) {
+		struct Env* e;
+		while ((e = dequeue(&(ProcessQueues.env_ready_queues[level]))) != NULL)
+			enqueue(&ready, e);
+	}
+	for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++)
+		ready_queues_bitmap[w] = 0;
+	struct Env* e;
+	while ((e = dequeue(&ready)) != NULL)
+		sched_insert_ready(e);
+}
+
 struct Env* fos_scheduler_BSD() {
 	/*To protect process Qs (or info of current process) in multi-CPU************************/
 	if (!holding_kspinlock(&ProcessQueues.qlock))
 		panic(
 				"fos_scheduler_BSD: q.lock is not held by this CPU while it's expected to be.");
 	/****************************************************************************************/
-	panic("Not implemented yet");
+	/*2025*/
+	struct Env *next_env = NULL;
+	struct Env *cur_env = get_cpu_proc();
+
+	//[1] Each second (catching up the ones passed while idle): load average & recent CPU decay
+	while (ticks - bsd_second_tick >= bsd_ticks_per_second) {
+		bsd_second_tick += bsd_ticks_per_second;
+		bsd_update_second(cur_env);
+	}
+
+	//[2] Re-insert the current env: only its recent CPU is changed since the last second,
+	//	so it's the only one whose level is recomputed each BSD_RECOMPUTE_TICKS ticks
+	if (cur_env != NULL) {
+		if (ticks % BSD_RECOMPUTE_TICKS == 0)
+			env_update_bsd_level(cur_env);
+		sched_insert_ready(cur_env);
+	}
+
+	//[3] Pick the next env from the highest non-empty level (round robin within it)
+	int level = first_ready_level();
+	if (level >= 0)
+		next_env = dequeue(&(ProcessQueues.env_ready_queues[level]));
+	return next_env;
 }
 
 //=============================
 // [10] PRIORITY RR Scheduler:
 //=============================
+/*2025*/
+//Lazy aging: each ready queue is ordered by the ready ticks (the oldest env is at its tail, the next to dequeue),
+//	so only the tails are checked: an env that has waited for the starvation threshold is promoted one level up
+//	& re-inserted (its wait restarts). The levels are visited upward, so it's promoted once per pass.
+//	It's called on each dispatch (i.e. each quantum) instead of counting the quantums of all the ready envs on each tick.
+static void prirr_age_ready_queues()
+{
+	for (int w = 0; w < READY_QUEUES_BITMAP_WORDS; w++) {
+		uint32 bits = ready_queues_bitmap[w];
+		while (bits) {
+			int level = w * 32 + bsf(bits);
+			bits &= bits - 1;
+			if (level == 0 || level >= num_of_ready_queues)
+				continue;
+			struct Env_Queue* queue = &(ProcessQueues.env_ready_queues[level]);
+			struct Env* e = LIST_LAST(queue);
+			while (e != NULL && ticks - e->readyTick >= glopal_starvation_thresh) {
+				LIST_REMOVE(queue, e);
+				e->priority = level - 1;
+				sched_insert_ready(e);
+				e = LIST_LAST(queue);
+			}
+		}
+	}
+}
+
 struct Env* fos_scheduler_PRIRR() {
 	/*To protect process Qs (or info of current process) in multi-CPU************************/
 	if (!holding_kspinlock(&ProcessQueues.qlock))
@@ -316,16 +553,15 @@ struct Env* fos_scheduler_PRIRR() {
 
 	// if there is running env send it to its coressponding queue
 	if (cur_env != NULL) {
-		enqueue(&(ProcessQueues.env_ready_queues[cur_env->priority]), cur_env);
+		sched_insert_ready(cur_env);
 	}
 
-	// loop among prirr queues to get the next env
-	for (uint8 i = 0; i < num_of_ready_queues; i++) {
-		next_env = dequeue(&(ProcessQueues.env_ready_queues[i]));
-		if (next_env != NULL) {
-			kclock_set_quantum(quantums[i]);
-			break;
-		}
+	/*2025*/ //get the next env from the highest non-empty level in O(1), after aging the starving ones
+	prirr_age_ready_queues();
+	int level = first_ready_level();
+	if (level >= 0) {
+		next_env = dequeue(&(ProcessQueues.env_ready_queues[level]));
+		kclock_set_quantum(quantums[level]);
 	}
 	return next_env;
 }
@@ -336,30 +572,35 @@ struct Env* fos_scheduler_PRIRR() {
 //========================================
 void clock_interrupt_handler(struct Trapframe* tf) {
 
-	if (isSchedMethodPRIRR()) {
-		//TODO: [PROJECT'25.IM#4] CPU SCHEDULING - #4 clock_interrupt_handler
-		//Your code is here
-		//Comment the following line
-		//panic("clock_interrupt_handler() is not implemented yet...!!");
-		acquire_kspinlock(&ProcessQueues.qlock);
-		for (uint8 i = 0; i < num_of_ready_queues; i++) {
-			struct Env * e;
-			LIST_FOREACH_SAFE(e, &(ProcessQueues.env_ready_queues[i]), Env)
-			{
-				e->Env_quantums++;
-				///e->Env_quantums += quantums[i];
-				if (e->Env_quantums >= glopal_starvation_thresh) {
-					sched_remove_ready(e);
-					e->priority = MAX(0, e->priority - 1);
-					//e->priority++;
-					sched_insert_ready(e);
-					e->Env_quantums = 0;
-				}
-			}
+	//TODO: [PROJECT'25.IM#4] CPU SCHEDULING - #4 clock_interrupt_handler
+	/*2025*/ //PRIRR: the starving envs are aged from their ready ticks on the dispatch (see prirr_age_ready_queues()),
+	//	so the tick doesn't depend on the # ready envs
+	/*2025*/ //Wake up the envs whose timed sleeps are over
+	uint64 now_ns = kclock_now_ns();
+	timer_run(now_ns);
+	/*2025*/ //Early fire (cut short for a timer, or the idle one): it's not a tick, so re-arm the clock for the rest
+	//	of the slice (cut again at the next timer, if any) & skip the tick accounting below
+	uint64 rest_ns = 0;
+	if (kclock_slice_rest(now_ns, &rest_ns)) {
+		if (get_cpu_proc() != NULL) {
+			uint64 timer_delta_ns = 0;
+			acquire_kspinlock(&ProcessQueues.qlock);
+			if (timer_next_expiry(now_ns, &timer_delta_ns) && timer_delta_ns < rest_ns)
+				rest_ns = timer_delta_ns;
+			release_kspinlock(&ProcessQueues.qlock);
+			kclock_arm(kclock_ns_to_cnt(rest_ns));
 		}
-
-		release_kspinlock(&ProcessQueues.qlock);
+		return;
 	}
+	/*2025*/ //MLFQ: the clock fires at the end of the slice, so the running env has used up its quantum
+	if (isSchedMethodMLFQ())
+		mlfq_quantum_expired = 1;
+	/*2025*/ //Tickless: the one-shot is consumed, it's armed again by the scheduler
+	if (isTicklessEnabled())
+		kclock_disarm();
+	/*2025*/ //BSD: the running env is charged the tick (its level is recomputed by the scheduler)
+	if (isSchedMethodBSD() && get_cpu_proc() != NULL)
+		get_cpu_proc()->recentCPU = fix_add(get_cpu_proc()->recentCPU, fix_int(1));
 
 	/********DON'T CHANGE THESE LINES***********/
 	ticks++;
@@ -375,6 +616,10 @@ void clock_interrupt_handler(struct Trapframe* tf) {
 		if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX)) {
 			update_WS_time_stamps();
 		}
+		/*2025*/
+		if (isPageReplacmentAlgorithmDynamicLocal()) {
+			env_page_ws_pff_update(p);
+		}
 		//cprintf("\n***************\nClock Handler\n***************\n") ;
 		//fos_scheduler();
 		yield();
@@ -408,6 +653,7 @@ void update_WS_time_stamps() {
 		int used = (perms & PERM_USED);
 
 		if (used) {
+			fault_around_account(env, va, perms);
 			wse->time_stamp = wse->time_stamp | 0x80000000;
 		} else {
 			wse->time_stamp = wse->time_stamp & 0x7FFFFFFF;
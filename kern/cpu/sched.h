@@ -43,6 +43,26 @@ struct
 #endif
 	uint8 num_of_ready_queues ;			// Number of ready queue(s)
 
+/*2025*/
+//PRIRR: bit i is set while the ready queue i may be non-empty (a queue emptied by a direct removal is cleared lazily at the dispatch)
+#define READY_QUEUES_BITMAP_WORDS	8	//256 levels (num_of_ready_queues is uint8)
+uint32 ready_queues_bitmap[READY_QUEUES_BITMAP_WORDS];
+#define READY_QUEUES_BITMAP_SET(level)		(ready_queues_bitmap[(level) / 32] |= (1 << ((level) % 32)))
+#define READY_QUEUES_BITMAP_CLEAR(level)	(ready_queues_bitmap[(level) / 32] &= ~(1 << ((level) % 32)))
+
+/*2025*/
+#define MLFQ_DEFAULT_BOOST_PERIOD	100	//# ticks between two boosts of all the envs to the top MLFQ level
+uint32 mlfq_boost_period;			//0: never boost
+
+/*2025*/
+//BSD: level of an env = recent_cpu/4 + 2*nice (i.e. PRI_MAX - its priority, level 0 is the highest)
+#define BSD_NICE_MIN			-20
+#define BSD_NICE_MAX			20
+#define BSD_RECOMPUTE_TICKS		4	//the level of the running env is recomputed each 4 ticks
+#define BSD_MAX_DECAY_SECONDS	64	//max # missed seconds applied to the recent CPU of an env on its wakeup
+fixed_point_t load_avg;				//# ready & running envs averaged over the last minute (17.14)
+uint32 bsd_seconds;					//# seconds passed under the BSD scheduler (i.e. # load average updates)
+
 //===============
 
 //2015
@@ -53,8 +53,6 @@ void enqueue(struct Env_Queue* queue, struct Env* env)
 	if(env != NULL)
 	{
 		LIST_INSERT_HEAD(queue, env);
-		// reset the Env_quantums //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-		env->Env_quantums = 0;
 	}
 }
 
@@ -157,7 +155,15 @@ void sched_insert_ready(struct Env* env)
 	{
 		//cprintf("\nInserting %d into ready queue 0\n", env->env_id);
 		env->env_status = ENV_READY ;
+		/*2025*/ //BSD: an env that missed some decays (e.g. it was blocked) is decayed & moved to its level first
+		if (isSchedMethodBSD() && env->recentCPUSecond != bsd_seconds)
+			env_update_bsd_level(env);
+		/*2025*/ env->readyTick = ticks;
+		/*2025*/ //Tickless: the running env may be skipping its ticks as the only runnable one, so its slice is due again
+		if (isTicklessEnabled() && !kclock_is_armed())
+			kclock_arm_quantum();
 		enqueue(&(ProcessQueues.env_ready_queues[env->priority]), env);
+		/*2025*/ READY_QUEUES_BITMAP_SET(env->priority);
 	}
 }
 
@@ -272,6 +278,16 @@ void sched_new_env(struct Env* e)
 	  //cprintf("\n[SCHED_NEW_ENV] release: lock status after = %d\n", qlock.locked);
 }
 
+/*2025*/
+//Set the ready level of a new env on its first run: MLFQ starts it at the top, BSD from its recent CPU & nice
+static void sched_set_new_env_level(struct Env* e)
+{
+	if (isSchedMethodMLFQ())
+		e->priority = 0;
+	else if (isSchedMethodBSD())
+		env_update_bsd_level(e);
+}
+
 //=================================================
 // [9] Run the given EnvID:
 //=================================================
@@ -285,6 +301,7 @@ void sched_run_env(uint32 envId)
 		if(ptr_env->env_id == envId)
 		{
 			sched_remove_new(ptr_env);
+			/*2025*/ sched_set_new_env_level(ptr_env);
 			sched_insert_ready(ptr_env);
 
 			/*2015*///if scheduler not run yet, then invoke it!
@@ -491,7 +508,7 @@ void sched_print_all()
 		cprintf("\nThe processes in NEW queue are:\n");
 		LIST_FOREACH(ptr_env, &ProcessQueues.env_new_queue)
 		{
-			cprintf("	[%d] %s\n", ptr_env->env_id, ptr_env->prog_name);
+			cprintf("	[%d] %s (nice = %d)\n", ptr_env->env_id, ptr_env->prog_name, env_get_nice(ptr_env));
 		}
 	}
 	else
@@ -499,6 +516,13 @@ void sched_print_all()
 		cprintf("\nNo processes in NEW queue\n");
 	}
 	cprintf("================================================\n");
+	/*2025*/
+	if (isSchedMethodBSD())
+	{
+		int la = get_load_average();
+		cprintf("Load average = %d.%d%d\n", la / 100, (la % 100) / 10, la % 10);
+		cprintf("================================================\n");
+	}
 	for (int i = 0 ; i < num_of_ready_queues ; i++)
 	{
 		if (!LIST_EMPTY(&(ProcessQueues.env_ready_queues[i])))
@@ -506,7 +530,11 @@ void sched_print_all()
 			cprintf("The processes in READY queue #%d are:\n", i);
 			LIST_FOREACH(ptr_env, &(ProcessQueues.env_ready_queues[i]))
 			{
-				cprintf("	[%d] %s\n", ptr_env->env_id, ptr_env->prog_name);
+				/*2025*/
+				if (isSchedMethodBSD())
+					cprintf("	[%d] %s (nice = %d, recent_cpu = %d)\n", ptr_env->env_id, ptr_env->prog_name, env_get_nice(ptr_env), env_get_recent_cpu(ptr_env));
+				else
+					cprintf("	[%d] %s (nice = %d)\n", ptr_env->env_id, ptr_env->prog_name, env_get_nice(ptr_env));
 			}
 		}
 		else
@@ -545,6 +573,7 @@ void sched_run_all()
 	for (int i = 0; i < q_size; ++i)
 	{
 		ptr_env = dequeue(&ProcessQueues.env_new_queue);
+		/*2025*/ sched_set_new_env_level(ptr_env);
 		sched_insert_ready(ptr_env);
 	}
 
@@ -669,20 +698,83 @@ int64 timer_ticks()
 }
 int env_get_nice(struct Env* e)
 {
-	panic("Not implemented function");
+	/*2025*/
+	return e->nice;
 }
 
 void env_set_nice(struct Env* e, int nice_value)
 {
-	panic("Not implemented function");
+	/*2025*/
+	if (nice_value < BSD_NICE_MIN)
+		nice_value = BSD_NICE_MIN;
+	if (nice_value > BSD_NICE_MAX)
+		nice_value = BSD_NICE_MAX;
+
+	bool lock_already_held = holding_kspinlock(&ProcessQueues.qlock);
+	if (!lock_already_held)
+	{
+		acquire_kspinlock(&ProcessQueues.qlock);
+	}
+	{
+		e->nice = nice_value;
+		if (isSchedMethodBSD())
+		{
+			//move it to its new level if it's waiting in a ready queue
+			if (e->env_status == ENV_READY)
+			{
+				sched_remove_ready(e);
+				env_update_bsd_level(e);
+				sched_insert_ready(e);
+			}
+			else
+			{
+				env_update_bsd_level(e);
+			}
+		}
+	}
+	if (!lock_already_held)
+	{
+		release_kspinlock(&ProcessQueues.qlock);
+	}
 }
+//Returns 100 times the recent CPU of the given env (rounded)
 int env_get_recent_cpu(struct Env* e)
 {
-	panic("Not implemented function");
+	/*2025*/
+	return fix_round(fix_scale(e->recentCPU, 100));
 }
+//Returns 100 times the load average (rounded)
 int get_load_average()
 {
-	panic("Not implemented function");
+	/*2025*/
+	return fix_round(fix_scale(load_avg, 100));
+}
+
+/*2025*/
+//Catch up the decay of the recent CPU of the given env till bsd_seconds, then recompute its level.
+//	As 4.4BSD updatepri(), a blocked env isn't decayed while it sleeps: its missed seconds are applied
+//	on its wakeup with the current load average, so the per-second pass only visits the ready envs
+void env_update_bsd_level(struct Env* e)
+{
+	uint32 numOfSeconds = MIN(bsd_seconds - e->recentCPUSecond, BSD_MAX_DECAY_SECONDS);
+	if (numOfSeconds > 0)
+	{
+		//recent_cpu = (2*load_avg)/(2*load_avg + 1) * recent_cpu + nice
+		fixed_point_t twiceLoad = fix_scale(load_avg, 2);
+		fixed_point_t decay = fix_div(twiceLoad, fix_add(twiceLoad, fix_int(1)));
+		for (uint32 i = 0; i < numOfSeconds; i++)
+		{
+			e->recentCPU = fix_add(fix_mul(decay, e->recentCPU), fix_int(e->nice));
+		}
+	}
+	e->recentCPUSecond = bsd_seconds;
+
+	int level = fix_trunc(fix_unscale(e->recentCPU, 4)) + 2 * e->nice;
+	if (level < 0)
+		level = 0;
+	if (level > num_of_ready_queues - 1)
+		level = num_of_ready_queues - 1;
+	e->priority = level;
 }
 /********* for BSD Priority Scheduler *************/
 
@@ -719,3 +811,10 @@ void sched_set_starv_thresh(uint32 starvThresh)
 
 
 }
+
+/*2025*/
+/********* for MLFQ Scheduler *************/
+void sched_set_mlfq_boost_period(uint32 period)
+{
+	mlfq_boost_period = period;
+}
@@ -14,11 +14,13 @@ int env_get_nice(struct Env* e) ;
 void env_set_nice(struct Env* e, int nice_value) ;
 int env_get_recent_cpu(struct Env* e) ;
 int get_load_average() ;
+/*2025*/ void env_update_bsd_level(struct Env* e) ;
 /********* for BSD Priority Scheduler *************/
 
 /*2024*/
 void env_set_priority(int32 envID, int priority);
 void sched_set_starv_thresh(uint32 starvThresh);
+/*2025*/ void sched_set_mlfq_boost_period(uint32 period);
 uint32 glopal_starvation_thresh;
 
 //void sched_insert_ready0(struct Env* env);
@@ -0,0 +1,183 @@
+/*
+ * timer_wheel.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "timer_wheel.h"
+#include <inc/assert.h>
+#include <kern/cpu/sched.h>
+#include <kern/cpu/kclock.h>
+
+static struct Timer_List wheel[TW_LEVELS][TW_SLOTS];
+static uint64 wheel_time = 0;		//next unit to be processed
+static uint32 num_of_timers = 0;	//# pending timers
+
+//Slot index of the given time (in units) at the given level
+#define TW_INDEX(time, level)	((uint32)((time) >> (TW_SLOT_BITS * (level))) & (TW_SLOTS - 1))
+
+//=====================================
+// [1] INITIALIZE THE WHEEL:
+//=====================================
+void timer_wheel_init()
+{
+	for (int level = 0; level < TW_LEVELS; level++)
+		for (int i = 0; i < TW_SLOTS; i++)
+			LIST_INIT(&wheel[level][i]);
+	wheel_time = 0;
+	num_of_timers = 0;
+	init_channel(&TimerSleepChannel, "timed sleep");
+	set_channel_io_wait(&TimerSleepChannel, 1);
+}
+
+//=====================================
+// [2] ADD/CANCEL A TIMER:
+//=====================================
+//Put the timer in the slot of its distance from the wheel time (an expired one is put in the current slot)
+static void timer_place(struct Timer* timer)
+{
+	uint64 expires = timer->expires < wheel_time ? wheel_time : timer->expires;
+	uint64 delta = expires - wheel_time;
+	if (delta > TW_MAX_UNITS)
+	{
+		delta = TW_MAX_UNITS;
+		expires = wheel_time + TW_MAX_UNITS;
+	}
+	int level = 0;
+	while (level < TW_LEVELS - 1 && delta >= (1ULL << (TW_SLOT_BITS * (level + 1))))
+		level++;
+
+	timer->slot = &wheel[level][TW_INDEX(expires, level)];
+	LIST_INSERT_HEAD(timer->slot, timer);
+}
+
+//Add the given timer to expire at the given time (in ns of the monotonic clock). The qlock should be held
+void timer_add(struct Timer* timer, uint64 expires_ns)
+{
+	if (!holding_kspinlock(&ProcessQueues.qlock))
+		panic("timer_add: q.lock is not held by this CPU while it's expected to be.");
+
+	//rounded up, so it never expires early
+	timer->expires = (expires_ns + (1 << TW_UNIT_SHIFT) - 1) >> TW_UNIT_SHIFT;
+	timer->fired = 0;
+	//the wheel isn't advanced while there's no timer, so catch it up first
+	if (num_of_timers == 0)
+		wheel_time = kclock_now_ns() >> TW_UNIT_SHIFT;
+	timer_place(timer);
+	num_of_timers++;
+}
+
+//Remove the given timer if it's still pending. The qlock should be held
+void timer_cancel(struct Timer* timer)
+{
+	if (!holding_kspinlock(&ProcessQueues.qlock))
+		panic("timer_cancel: q.lock is not held by this CPU while it's expected to be.");
+
+	if (timer->slot != NULL)
+	{
+		LIST_REMOVE(timer->slot, timer);
+		timer->slot = NULL;
+		num_of_timers--;
+	}
+}
+
+//=====================================
+// [3] RUN THE EXPIRED TIMERS:
+//=====================================
+//Move the timers of the given slot down to their levels (they're all within the slot span from now)
+static void timer_cascade(int level, uint32 index)
+{
+	struct Timer_List* slot = &wheel[level][index];
+	struct Timer* timer;
+	while ((timer = LIST_FIRST(slot)) != NULL)
+	{
+		LIST_REMOVE(slot, timer);
+		timer_place(timer);
+	}
+}
+
+//Advance the wheel till the given time & call the functions of the expired timers.
+//	Called on each clock interrupt. Returns the number of expired timers
+int timer_run(uint64 now_ns)
+{
+	int numOfExpired = 0;
+	uint64 now = now_ns >> TW_UNIT_SHIFT;
+
+	acquire_kspinlock(&ProcessQueues.qlock);
+	{
+		//nothing to expire: just catch up (e.g. after a long idle)
+		if (num_of_timers == 0 && wheel_time <= now)
+			wheel_time = now + 1;
+
+		while (wheel_time <= now)
+		{
+			//once a level wraps around, the next slot of the upper one is due to be cascaded
+			uint32 index = TW_INDEX(wheel_time, 0);
+			for (int level = 1; index == 0 && level < TW_LEVELS; level++)
+			{
+				index = TW_INDEX(wheel_time, level);
+				timer_cascade(level, index);
+			}
+
+			struct Timer_List* slot = &wheel[0][TW_INDEX(wheel_time, 0)];
+			struct Timer* timer;
+			while ((timer = LIST_FIRST(slot)) != NULL)
+			{
+				LIST_REMOVE(slot, timer);
+				timer->slot = NULL;
+				num_of_timers--;
+				timer->fired = 1;
+				timer->func(timer);
+				numOfExpired++;
+			}
+			wheel_time++;
+		}
+	}
+	release_kspinlock(&ProcessQueues.qlock);
+	return numOfExpired;
+}
+
+//=====================================
+// [4] NEXT EXPIRATION:
+//=====================================
+//Set "delta_ns" to the time from now till the wheel should be run next: the first non-empty slot of level 0,
+//	or the cascade of the first non-empty slot of an upper level (whichever is first).
+//	Returns 0 if there's no pending timer. The qlock should be held
+int timer_next_expiry(uint64 now_ns, uint64* delta_ns)
+{
+	if (num_of_timers == 0)
+		return 0;
+
+	uint64 next = (uint64)-1;
+	for (int level = 0; level < TW_LEVELS; level++)
+	{
+		int shift = TW_SLOT_BITS * level;
+		//level 0: its current slot is the next to run, upper levels: their current slot is already cascaded
+		for (int i = (level == 0 ? 0 : 1); i <= TW_SLOTS; i++)
+		{
+			uint64 time = ((wheel_time >> shift) + i) << shift;
+			if (time >= next)
+				break;
+			if (!LIST_EMPTY(&wheel[level][TW_INDEX(time, level)]))
+			{
+				next = time;
+				break;
+			}
+		}
+	}
+	uint64 next_ns = next << TW_UNIT_SHIFT;
+	*delta_ns = next_ns > now_ns ? next_ns - now_ns : 0;
+	return 1;
+}
+
+//=====================================
+// [5] TIMER LEVEL (FOR THE TESTS):
+//=====================================
+//The level of the slot of the given timer (-1 if it's not pending)
+int timer_level(struct Timer* timer)
+{
+	if (timer->slot == NULL)
+		return -1;
+	return (timer->slot - &wheel[0][0]) / TW_SLOTS;
+}
@@ -0,0 +1,52 @@
+/*
+ * timer_wheel.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_CPU_TIMER_WHEEL_H_
+#define KERN_CPU_TIMER_WHEEL_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+#include <inc/queue.h>
+#include <inc/environment_definitions.h>
+#include <kern/conc/channel.h>
+
+//Hierarchical timer wheel: TW_LEVELS levels of TW_SLOTS slots each,
+//	a slot of level L covers TW_SLOTS^L units of (1 << TW_UNIT_SHIFT) ns (~65.5 us).
+//	A timer is placed in the level of its distance & moved down (cascaded) as the time gets close to it
+#define TW_UNIT_SHIFT	16
+#define TW_SLOT_BITS	6
+#define TW_SLOTS		(1 << TW_SLOT_BITS)
+#define TW_LEVELS		4
+#define TW_MAX_UNITS	((1ULL << (TW_SLOT_BITS * TW_LEVELS)) - 1)	//~18 minutes, a farther timer is re-cascaded
+
+struct Timer;
+LIST_HEAD(Timer_List, Timer);		// Declares 'struct Timer_List'
+
+struct Timer
+{
+	LIST_ENTRY(Timer) prev_next_info;	//link pointers of its slot
+	uint64 expires;						//time to expire (in wheel units)
+	struct Timer_List* slot;			//its slot (NULL if it's not pending)
+	void (*func)(struct Timer*);		//called on its expiration with the ProcessQueues.qlock held
+	struct Env* env;					//sleep timers: the sleeping env
+	struct Channel* chan;				//	& the channel it sleeps on
+	uint8 fired;						//is it expired?
+};
+
+struct Channel TimerSleepChannel;		//the envs sleep on it in sys_sleep_ns(), only woken up by their timers
+
+void timer_wheel_init();
+void timer_add(struct Timer* timer, uint64 expires_ns);
+void timer_cancel(struct Timer* timer);
+int timer_run(uint64 now_ns);
+int timer_next_expiry(uint64 now_ns, uint64* delta_ns);
+int timer_level(struct Timer* timer);
+
+#endif /* KERN_CPU_TIMER_WHEEL_H_ */
@@ -15,6 +15,7 @@
 
 #include "../mem/kheap.h"
 #include "../mem/memory_manager.h"
+#include "../proc/program_cache.h"
 
 int __pf_write_env_table( struct Env* ptr_env, uint32 virtual_address, uint32* tableKVirtualAddress);
 int __pf_read_env_table(struct Env* ptr_env, uint32 virtual_address, uint32* tableKVirtualAddress);
@@ -34,6 +35,13 @@ int read_disk_page(uint32 dfn, void* va)
 }
 
 
+//read "num_of_pages" consecutive disk frames starting at dfn in ONE transfer
+int read_disk_pages(uint32 dfn, void* va, uint32 num_of_pages)
+{
+	uint32 df_start_sector = PAGE_FILE_START_SECTOR+dfn*SECTOR_PER_PAGE;
+	return ide_read(df_start_sector, (void*)va, num_of_pages*SECTOR_PER_PAGE);
+}
+
 int write_disk_page(uint32 dfn, void* va)
 {
 	//write disk at wanted frame
@@ -55,6 +63,7 @@ uint32* ptr_disk_page_directory;
 void initialize_disk_page_file();
 
 int read_disk_page(uint32 dfn, void* va);
+int read_disk_pages(uint32 dfn, void* va, uint32 num_of_pages);
 int write_disk_page(uint32 dfn, void* va);
 
 int get_disk_page_directory(struct Env* ptr_env, uint32** ptr_disk_page_directory);
@@ -62,69 +71,109 @@ int get_disk_page_directory(struct Env* ptr_env, uint32** ptr_disk_page_director
 
 
 // --------------------------------------------------------------
-// Tracking of physical frames.
-// The 'frames_info' array has one 'struct Frame_Info' entry per physical frame.
-// frames_info are reference counted, and free frames are kept on a linked list.
+// Tracking of disk frames.
+// The free disk frames are marked in the DiskFrameLists.disk_free_map bitmap
+// (one bit per disk frame), so consecutive frames can be allocated as extents.
 // --------------------------------------------------------------
 
-// Initialize paging structure and disk_free_frame_list.
+// Initialize the free disk frames bitmap.
 // After this point, ONLY use the functions below
-// to allocate and deallocate physical memory via the disk_free_frame_list,
-// and NEVER use boot_allocate_space() or the related boot-time functions above.
+// to allocate and deallocate disk frames via the disk_free_map.
 //
 void initialize_disk_page_file()
 {
-	int i;
-	LIST_INIT(&DiskFrameLists.disk_free_frame_list);
-
 	//LOG_STATMENT(cprintf("PAGES_PER_FILE = %d, PAGE_FILE_START_SECTOR = %d\n",PAGES_PER_FILE,PAGE_FILE_START_SECTOR););
-	for (i = 1; i < PAGES_PER_FILE; i++)
-	{
-		initialize_frame_info(&(disk_frames_info[i]));
-
-		//disk_frames_info[i].references = 0;
-		LIST_INSERT_HEAD(&DiskFrameLists.disk_free_frame_list, &disk_frames_info[i]);
-	}
+	//all disk frames are free except frame 0 (0 means "not in page file")
+	memset(DiskFrameLists.disk_free_map, 0xFF, sizeof(DiskFrameLists.disk_free_map));
+	DiskFrameLists.disk_free_map[0] &= ~1;
+	DiskFrameLists.disk_num_of_free_frames = PAGES_PER_FILE - 1;
+	DiskFrameLists.disk_next_hint = 1;
 
 	init_kspinlock(&DiskFrameLists.dfllock, "Disk FrameList Lock");
 }
 
-//
-// Initialize a Frame_Info structure.
-// The result has null links and 0 references.
-// Note that the corresponding physical frame is NOT initialized!
-//
-static inline uint32 to_disk_frame_number(struct FrameInfo *ptr_frame_info)
+#define DISK_MAP_WORD(dfn)	((dfn) >> 5)
+#define DISK_MAP_BIT(dfn)	(1 << ((dfn) & 31))
+
+//mark "num" disk frames starting at dfn as free/allocated
+static inline void disk_set_frames(uint32 dfn, uint32 num, bool is_free)
 {
-	return ptr_frame_info - disk_frames_info;
+	for (uint32 i = 0; i < num; i++, dfn++)
+	{
+		if (is_free)
+			DiskFrameLists.disk_free_map[DISK_MAP_WORD(dfn)] |= DISK_MAP_BIT(dfn);
+		else
+			DiskFrameLists.disk_free_map[DISK_MAP_WORD(dfn)] &= ~DISK_MAP_BIT(dfn);
+	}
+	if (is_free)
+		DiskFrameLists.disk_num_of_free_frames += num;
+	else
+		DiskFrameLists.disk_num_of_free_frames -= num;
+}
+
+//first dfn of "num" consecutive free disk frames, searching from "hint" to the end then from the start
+//returns 0 if not found
+static uint32 disk_find_free_frames(uint32 num, uint32 hint)
+{
+	uint32 run = 0, run_start = 0;
+	uint32 dfn = (hint == 0 || hint >= PAGES_PER_FILE) ? 1 : hint;
+	for (uint32 n = 0; n < PAGES_PER_FILE; n++, dfn++)
+	{
+		//a run can't wrap around the end of the page file
+		if (dfn == PAGES_PER_FILE)
+		{
+			dfn = 1;
+			run = 0;
+		}
+		uint32 word = DiskFrameLists.disk_free_map[DISK_MAP_WORD(dfn)];
+		//skip a fully-allocated word at once
+		if ((dfn & 31) == 0 && word == 0)
+		{
+			n += 31;
+			dfn += 31;
+			run = 0;
+			continue;
+		}
+		if (word & DISK_MAP_BIT(dfn))
+		{
+			if (run == 0)
+				run_start = dfn;
+			if (++run == num)
+				return run_start;
+		}
+		else
+			run = 0;
+	}
+	return 0;
 }
 
 //
-// Allocates a disk frame.
+// Allocates "num_of_frames" CONSECUTIVE disk frames, as near as possible after the given hint
+// (hint = 0: continue after the last allocated frames)
 //
-// *ptr_frame_info -- is set to point to the Frame_Info struct of the
-// newly allocated frame
+// *first_dfn -- is set to the first allocated disk frame
 //
 // RETURNS
 //   0 -- on success
 //   E_NO_PAGE_FILE_SPACE -- otherwise
 //
-int allocate_disk_frame(uint32 *dfn)
+int allocate_disk_frames(uint32 num_of_frames, uint32 hint, uint32 *first_dfn)
 {
 	int ret = 0;
 	acquire_kspinlock(&DiskFrameLists.dfllock);
 	{
-		// Fill this function in
-		struct FrameInfo *ptr_frame_info = LIST_FIRST(&DiskFrameLists.disk_free_frame_list);
-		if(ptr_frame_info == NULL)
+		uint32 dfn = 0;
+		if (num_of_frames > 0 && num_of_frames <= DiskFrameLists.disk_num_of_free_frames)
+			dfn = disk_find_free_frames(num_of_frames, hint ? hint : DiskFrameLists.disk_next_hint);
+		if (dfn == 0)
 		{
 			ret = E_NO_PAGE_FILE_SPACE;
 		}
 		else
 		{
-			LIST_REMOVE(&DiskFrameLists.disk_free_frame_list, ptr_frame_info);
-			initialize_frame_info(ptr_frame_info);
-			*dfn = to_disk_frame_number(ptr_frame_info);
+			disk_set_frames(dfn, num_of_frames, 0);
+			DiskFrameLists.disk_next_hint = dfn + num_of_frames;
+			*first_dfn = dfn;
 		}
 	}
 	release_kspinlock(&DiskFrameLists.dfllock);
@@ -133,7 +182,19 @@ int allocate_disk_frame(uint32 *dfn)
 }
 
 //
-// Return a frame to the disk_free_frame_list.
+// Allocates a disk frame.
+//
+// RETURNS
+//   0 -- on success
+//   E_NO_PAGE_FILE_SPACE -- otherwise
+//
+int allocate_disk_frame(uint32 *dfn)
+{
+	return allocate_disk_frames(1, 0, dfn);
+}
+
+//
+// Return a frame to the free disk frames.
 //
 inline void free_disk_frame(uint32 dfn)
 {
@@ -141,7 +202,7 @@ inline void free_disk_frame(uint32 dfn)
 	if(dfn == 0) return;
 	acquire_kspinlock(&DiskFrameLists.dfllock);
 	{
-		LIST_INSERT_HEAD(&DiskFrameLists.disk_free_frame_list, &disk_frames_info[dfn]);
+		disk_set_frames(dfn, 1, 1);
 	}
 	release_kspinlock(&DiskFrameLists.dfllock);
 }
@@ -206,6 +267,54 @@ int get_disk_page_table(uint32 *ptr_disk_page_directory, const uint32 virtual_ad
 	return 0;
 }
 
+/*2025*/
+//hint to place the page on disk right after (or before) its neighbor page to keep the env sequential on disk
+static uint32 pf_env_page_hint(struct Env* ptr_env, uint32 virtual_address)
+{
+	uint32 dfn = (virtual_address >= PAGE_SIZE) ? pf_get_env_page_dfn(ptr_env, virtual_address - PAGE_SIZE) : 0;
+	if (dfn != 0)
+		return dfn + 1;
+	dfn = pf_get_env_page_dfn(ptr_env, virtual_address + PAGE_SIZE);
+	if (dfn > 1)
+		return dfn - 1;
+	return 0;
+}
+
+//reserve consecutive disk frames for the pages of [virtual_address, virtual_address + num_of_pages * PAGE_SIZE)
+//that are not in the page file yet (their content is written later by pf_add_env_page())
+int pf_reserve_env_pages(struct Env* ptr_env, uint32 virtual_address, uint32 num_of_pages)
+{
+	uint32 *ptr_disk_page_table;
+	uint32 va, numOfMissing = 0, first_missing = 0;
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	assert(virtual_address + num_of_pages * PAGE_SIZE <= KERNEL_BASE);
+
+	get_disk_page_directory(ptr_env, &(ptr_env->disk_env_pgdir)) ;
+
+	for (va = virtual_address; va < virtual_address + num_of_pages * PAGE_SIZE; va += PAGE_SIZE)
+	{
+		if (pf_get_env_page_dfn(ptr_env, va) == 0)
+		{
+			if (numOfMissing++ == 0)
+				first_missing = va;
+		}
+	}
+	if (numOfMissing == 0)
+		return 0;
+
+	uint32 dfn;
+	if (allocate_disk_frames(numOfMissing, pf_env_page_hint(ptr_env, first_missing), &dfn) == E_NO_PAGE_FILE_SPACE)
+		return E_NO_PAGE_FILE_SPACE;
+
+	for (va = first_missing; va < virtual_address + num_of_pages * PAGE_SIZE; va += PAGE_SIZE)
+	{
+		get_disk_page_table(ptr_env->disk_env_pgdir, va, 1, &ptr_disk_page_table) ;
+		if (ptr_disk_page_table[PTX(va)] == 0)
+			ptr_disk_page_table[PTX(va)] = dfn++;
+	}
+	return 0;
+}
+
 int pf_add_empty_env_page( struct Env* ptr_env, uint32 virtual_address, uint8 initializeByZero)
 {
 	//2016: FIX:
@@ -228,7 +337,7 @@ int pf_add_empty_env_page( struct Env* ptr_env, uint32 virtual_address, uint8 in
 	uint32 dfn=ptr_disk_page_table[PTX(virtual_address)];
 	if( dfn == 0)
 	{
-		if( allocate_disk_frame(&dfn) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
+		if( allocate_disk_frames(1, pf_env_page_hint(ptr_env, virtual_address), &dfn) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
 		ptr_disk_page_table[PTX(virtual_address)] = dfn;
 	}
 
@@ -249,7 +358,7 @@ int pf_add_env_page( struct Env* ptr_env, uint32 virtual_address, void* dataSrc)
 	uint32 dfn=ptr_disk_page_table[PTX(virtual_address)];
 	if( dfn == 0)
 	{
-		if( allocate_disk_frame(&dfn) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
+		if( allocate_disk_frames(1, pf_env_page_hint(ptr_env, virtual_address), &dfn) == E_NO_PAGE_FILE_SPACE) return E_NO_PAGE_FILE_SPACE;
 		ptr_disk_page_table[PTX(virtual_address)] = dfn;
 	}
 
@@ -267,7 +376,8 @@ int pf_add_env_page( struct Env* ptr_env, uint32 virtual_address, void* dataSrc)
 	return ret;
 }
 
-int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct FrameInfo* modified_page_frame_info)
+/*2025*/ //The disk frame to update the given page on (the page is added to the page file if it's not there yet)
+static uint32 pf_update_env_page_dfn(struct Env* ptr_env, uint32 virtual_address)
 {
 	int ret;
 	uint32 *ptr_disk_page_table;
@@ -285,8 +395,10 @@ int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct Frame
 	if(ptr_disk_page_table == NULL || (ptr_disk_page_table != NULL && ptr_disk_page_table[PTX(virtual_address)]== 0))
 	{
 
+		/*2025*/ //a page of a cached program is added on its first write-back too (see program_cache_fresh_page())
 		if ((virtual_address >= USER_HEAP_START && virtual_address < USER_HEAP_MAX) ||
-				(virtual_address >= USTACKBOTTOM && virtual_address < USTACKTOP))
+				(virtual_address >= USTACKBOTTOM && virtual_address < USTACKTOP) ||
+				program_cache_has_page(ptr_env, virtual_address))
 		{
 			/*2023*/ //EL7 :)
 			/* REMOVE THIS CONDITION SINCE THE GIVEN virtual_address MIGHT HAVE PRESENT = 0
@@ -339,6 +451,13 @@ int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct Frame
 
 	get_disk_page_table(ptr_env->disk_env_pgdir, virtual_address, 0, &ptr_disk_page_table);
 	uint32 dfn=ptr_disk_page_table[PTX(virtual_address)];
+	return dfn;
+}
+
+int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct FrameInfo* modified_page_frame_info)
+{
+	int ret;
+	uint32 dfn = pf_update_env_page_dfn(ptr_env, virtual_address);
 
 #if USE_KHEAP
 	{
@@ -395,6 +514,28 @@ int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct Frame
 
 	return ret;
 }
+
+/*2025*/ //Same as pf_update_env_page() but the page is copied to "dst" instead of being written,
+//	so the caller can write it to the returned dfn later (e.g. without holding the frame lists lock).
+//	Its MODIFIED is cleared as it's already considered written.
+//	The page directory of the env should be the current one
+uint32 pf_copy_env_page(struct Env* ptr_env, uint32 virtual_address, void* dst)
+{
+	uint32 dfn = pf_update_env_page_dfn(ptr_env, virtual_address);
+
+	//read it through its VA even if it's not PRESENT (e.g. buffered), as in pf_update_env_page()
+	uint32 *ptrTable ;
+	get_page_table(ptr_env->env_page_directory, virtual_address, &ptrTable);
+	uint32 origPerms = ptrTable[PTX(virtual_address)] & 0xFFF;
+	ptrTable[PTX(virtual_address)] |= PERM_PRESENT ;
+	memcpy(dst, (void*)ROUNDDOWN(virtual_address, PAGE_SIZE), PAGE_SIZE);
+	ptrTable[PTX(virtual_address)] &= 0xFFFFF000 ;
+	ptrTable[PTX(virtual_address)] |= (origPerms & ~PERM_MODIFIED) ;
+	tlb_invalidate(ptr_env->env_page_directory, (void*)virtual_address);
+
+	ptr_env->nPageOut++ ;
+	return dfn;
+}
 /*
 int pf_special_update_env_modified_page(struct Env* ptr_env, uint32 virtual_address, struct Frame_Info* page_modified_frame_info)
 {
@@ -443,6 +584,39 @@ int pf_read_env_page(struct Env* ptr_env, void* virtual_address)
 	return disk_read_error;
 }
 
+/*2025*/
+//get the disk frame of the given page (0 if it's not in the page file)
+uint32 pf_get_env_page_dfn(struct Env* ptr_env, uint32 virtual_address)
+{
+	uint32 *ptr_disk_page_table;
+	if( ptr_env->disk_env_pgdir == 0) return 0;
+
+	get_disk_page_table(ptr_env->disk_env_pgdir, virtual_address, 0, &ptr_disk_page_table);
+	if(ptr_disk_page_table == 0) return 0;
+
+	return ptr_disk_page_table[PTX(virtual_address)];
+}
+
+//read "num_of_pages" pages starting at virtual_address in ONE disk transfer
+//	their disk frames MUST be consecutive (see pf_get_env_page_dfn())
+int pf_read_env_pages(struct Env* ptr_env, uint32 virtual_address, uint32 num_of_pages)
+{
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	uint32 dfn = pf_get_env_page_dfn(ptr_env, virtual_address);
+	if( dfn == 0) return E_PAGE_NOT_EXIST_IN_PF;
+
+	int disk_read_error = read_disk_pages(dfn, (void*)virtual_address, num_of_pages);
+
+	//reset modified bit to 0 (same as pf_read_env_page())
+	for (uint32 i = 0; i < num_of_pages; i++)
+	{
+		pt_set_page_permissions(ptr_env->env_page_directory, virtual_address + i*PAGE_SIZE, 0, PERM_MODIFIED);
+	}
+	ptr_env->nPageIn += num_of_pages;
+
+	return disk_read_error;
+}
+
 void pf_remove_env_page(struct Env* ptr_env, uint32 virtual_address)
 {
 	//LOG_STRING("pf_remove_env_page: 0");
@@ -462,6 +636,24 @@ void pf_remove_env_page(struct Env* ptr_env, uint32 virtual_address)
 	//LOG_STRING("pf_remove_env_page: 3");
 }
 
+//move the disk frame of the page at src_va (if any) to dst_va without touching its content
+void pf_move_env_page(struct Env* ptr_env, uint32 src_va, uint32 dst_va)
+{
+	uint32 *ptr_src_disk_page_table, *ptr_dst_disk_page_table;
+	if( ptr_env->disk_env_pgdir == 0) return;
+
+	get_disk_page_table(ptr_env->disk_env_pgdir, src_va, 0, &ptr_src_disk_page_table);
+	if(ptr_src_disk_page_table == 0) return;
+
+	uint32 dfn = ptr_src_disk_page_table[PTX(src_va)];
+	if( dfn == 0) return;
+
+	pf_remove_env_page(ptr_env, dst_va);
+	get_disk_page_table(ptr_env->disk_env_pgdir, dst_va, 1, &ptr_dst_disk_page_table);
+	ptr_dst_disk_page_table[PTX(dst_va)] = dfn;
+	ptr_src_disk_page_table[PTX(src_va)] = 0;
+}
+
 void pf_free_env(struct Env* ptr_env)
 {
 	uint32 pdeno;
@@ -619,18 +811,14 @@ int pf_calculate_allocated_pages(struct Env* ptr_env)
 }
 
 //2016:
-//calculate the disk free frames from the disk free frame list
+//calculate the disk free frames from the disk free frames bitmap
 int pf_calculate_free_frames()
 {
 	uint32 totalFreeDiskFrames ;
 	acquire_kspinlock(&DiskFrameLists.dfllock);
 	{
 		/*2023: UPDATE beased on suggestion from T112 2023.Term1*/
-		totalFreeDiskFrames = LIST_SIZE(&DiskFrameLists.disk_free_frame_list);
-		//	LIST_FOREACH(ptr, &disk_free_frame_list)
-		//	{
-		//		totalFreeDiskFrames++ ;
-		//	}
+		totalFreeDiskFrames = DiskFrameLists.disk_num_of_free_frames;
 	}
 	release_kspinlock(&DiskFrameLists.dfllock);
 	return totalFreeDiskFrames;
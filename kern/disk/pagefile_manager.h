@@ -17,20 +17,32 @@
 #define PAGES_PER_FILE (PAGE_FILE_SIZE/PAGE_SIZE)
 
 ///=============================================================================================
-struct FrameInfo* disk_frames_info;
+/*2025*/ //Free disk frames are tracked by a bitmap to allocate consecutive disk frames (extents)
 struct
 {
-	struct FrameInfo_List disk_free_frame_list;	// Free list of disk frames_info
+	uint32 disk_free_map[PAGES_PER_FILE / 32];	// bit (dfn % 32) of word (dfn / 32) is set if the disk frame is free
+	uint32 disk_num_of_free_frames;				// # set bits in disk_free_map
+	uint32 disk_next_hint;						// where to search if no hint is given (next fit)
 	struct kspinlock dfllock;					// Lock to protect the disk frame info lists
 } DiskFrameLists;
 
+int allocate_disk_frame(uint32 *dfn);
+/*2025*/ int allocate_disk_frames(uint32 num_of_frames, uint32 hint, uint32 *first_dfn);
+void free_disk_frame(uint32 dfn);
+
 ///=============================================================================================
 int pf_add_empty_env_page( struct Env* ptr_env, uint32 virtual_address, uint8 initializeByZero);
 int pf_add_env_page( struct Env* ptr_env, uint32 virtual_address, void* dataSrc);
+/*2025*/ int pf_reserve_env_pages(struct Env* ptr_env, uint32 virtual_address, uint32 num_of_pages);
+/*2025*/ int write_disk_page(uint32 dfn, void* va);
 int pf_update_env_page(struct Env* ptr_env, uint32 virtual_address, struct FrameInfo* modified_page_frame_info);
+/*2025*/ uint32 pf_copy_env_page(struct Env* ptr_env, uint32 virtual_address, void* dst);
 //int pf_special_update_env_modified_page(struct Env* ptr_env, uint32 virtual_address, struct Frame_Info* page_modified_frame_info);
 int pf_read_env_page(struct Env* ptr_env, void* virtual_address);
+/*2025*/ uint32 pf_get_env_page_dfn(struct Env* ptr_env, uint32 virtual_address);
+/*2025*/ int pf_read_env_pages(struct Env* ptr_env, uint32 virtual_address, uint32 num_of_pages);
 void pf_remove_env_page(struct Env* ptr_env, uint32 virtual_address);
+void pf_move_env_page(struct Env* ptr_env, uint32 src_va, uint32 dst_va);
 ///=============================================================================================
 
 int pf_calculate_allocated_pages(struct Env* ptr_env);
@@ -13,14 +13,18 @@
 #include "kern/cmd/command_prompt.h"
 #include "kern/cmd/commands.h"
 #include <kern/cpu/kclock.h>
+#include <kern/cpu/timer_wheel.h>
 #include <kern/cpu/cpu.h>
 #include <kern/cpu/sched.h>
 #include <kern/cpu/picirq.h>
 #include <kern/cpu/cpu.h>
 #include <kern/mem/boot_memory_manager.h>
 #include <kern/mem/kheap.h>
+#include <kern/mem/kmem_cache.h>
 #include <kern/mem/memory_manager.h>
 #include <kern/mem/shared_memory_manager.h>
+#include <kern/mem/writeback.h>
+#include <kern/mem/reclaimer.h>
 #include <kern/tests/utilities.h>
 #include <kern/tests/test_kheap.h>
 #include <kern/tests/test_dynamic_allocator.h>
@@ -74,10 +78,12 @@ void FOS_initialize()
 		initialize_paging();
 #if USE_KHEAP
 		kheap_init();
+		kmem_cache_init();
 		sharing_init();
 #endif
 		fault_handler_init();
 		set_uheap_strategy(UHP_PLACE_CUSTOMFIT);
+		set_uheap_da_mode(DA_MODE_LIST);
 	}
 	//cprintf("* [DONE]\n");
 
@@ -114,7 +120,14 @@ void FOS_initialize()
 	cprintf("* 6) SCHEDULER & MULTI-TASKING:\n");
 	{
 		kclock_init();
+		/*2025*/
+		cprintf("*	TSC is calibrated at %d kHz\n", kclock_tsc_khz());
+		timer_wheel_init();
 		sched_init() ;
+		writeback_init();
+		cprintf("*	Write-back daemon is created [env #%d]\n", WriteBackDaemon->env_id);
+		reclaimer_init();
+		cprintf("*	Reclaimer daemon is created [env #%d]\n", ReclaimerDaemon->env_id);
 	}
 	//cprintf("* [DONE]\n");
 
@@ -148,11 +148,6 @@ void initialize_kernel_VM()
 	// 		size of "frames_info" can exceed the 4 MB space for "READ_ONLY_FRAMES_INFO"
 	//boot_map_range(ptr_page_directory, READ_ONLY_FRAMES_INFO, array_size, STATIC_KERNEL_PHYSICAL_ADDRESS(frames_info),PERM_USER) ;
 
-
-	uint32 disk_array_size = PAGES_PER_FILE * sizeof(struct FrameInfo);
-	disk_frames_info = boot_allocate_space(disk_array_size , PAGE_SIZE);
-	/*2023: this line is moved to the boot_allocate_space()*/ //memset(disk_frames_info , 0, disk_array_size);
-
 	// This allows the kernel & user to access any page table entry using a
 	// specified VA for each: VPT for kernel and UVPT for User.
 	setup_listing_to_all_page_tables_entries();
@@ -24,13 +24,13 @@ uint8* ptr_temp_page;				// Virtual address of a page used by program loader to
 uint32 phys_page_directory;			// Physical address of boot time page directory
 char* ptr_free_mem;					// Pointer to next byte of free mem
 
-//struct FrameInfo* disk_frames_info;	// Virtual address of physical frames_info array
 struct FrameInfo* frames_info;		// Virtual address of physical frames_info array
 
 struct
 {
 	struct FrameInfo_List free_frame_list;		// Free list of physical frames_info
 	struct FrameInfo_List modified_frame_list;	// Modified frame list for buffering
+	struct FrameInfo_List writeback_frame_list;	// Modified frames being written back while the lock is released (2025)
 	struct kspinlock mfllock;					// Lock to protect the frame info lists
 } MemFrameLists;
 
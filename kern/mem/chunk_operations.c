@@ -10,7 +10,9 @@
 #include <kern/proc/user_environment.h>
 #include "kheap.h"
 #include "memory_manager.h"
+#include "writeback.h"
 #include <inc/queue.h>
+#include <inc/dynamic_allocator.h>
 
 //extern void inctst();
 
@@ -133,8 +135,30 @@ uint32 calculate_required_frames(uint32* page_directory, uint32 sva,
 /* DYNAMIC ALLOCATOR SYSTEM CALLS */
 //=====================================
 /*2024*/
+//	Moves the break of the user DA area of the current env by numOfPages (+ve: grow, -ve: shrink)
+//	The new pages are only marked (no frames): they're allocated on the first access (page fault)
+//	Returns the previous break, or (void*)-1 if the new break is outside the user DA area
 void* sys_sbrk(int numOfPages) {
-	panic("not implemented function");
+	struct Env* e = get_cpu_proc();
+	assert(e != NULL);
+	uint32 old_brk = e->uheapDABreak;
+	if (numOfPages == 0)
+		return (void*) old_brk;
+
+	if (numOfPages > 0)
+	{
+		if (numOfPages > (USER_HEAP_START + DYN_ALLOC_MAX_SIZE - old_brk) / PAGE_SIZE)
+			return (void*) -1;
+		allocate_user_mem(e, old_brk, numOfPages * PAGE_SIZE);
+	}
+	else
+	{
+		if (-numOfPages > (old_brk - USER_HEAP_START) / PAGE_SIZE)
+			return (void*) -1;
+		free_user_mem(e, old_brk + numOfPages * PAGE_SIZE, -numOfPages * PAGE_SIZE);
+	}
+	e->uheapDABreak = old_brk + numOfPages * PAGE_SIZE;
+	return (void*) old_brk;
 }
 
 //=====================================
@@ -150,15 +174,19 @@ void allocate_user_mem(struct Env* e, uint32 virtual_address, uint32 size) {
 	uint32 end_va = ROUNDUP(virtual_address + size, PAGE_SIZE);
 	uint32* ptr_page_table = NULL;
 
-	for (uint32 va = start_Va; va < end_va; va += PAGE_SIZE)
+	//mark the range in bulk: one table lookup per 4 MB, then fill its entries
+	for (uint32 va = start_Va; va < end_va; )
 	{
 		int ret = get_page_table(e->env_page_directory, va, &ptr_page_table);
 		if (ret == TABLE_NOT_EXIST) {
 			ptr_page_table = create_page_table(e->env_page_directory, va);
-
 		}
 
-		if (ptr_page_table != NULL) {
+		uint32 table_end = ROUNDDOWN(va, PTSIZE) + PTSIZE;
+		if (table_end > end_va || table_end == 0)
+			table_end = end_va;
+		for (; va < table_end; va += PAGE_SIZE)
+		{
 			ptr_page_table[PTX(va)] = CONSTRUCT_ENTRY(0,
 					PERM_UHPAGE | PERM_WRITEABLE | PERM_USER);
 		}
@@ -177,16 +205,19 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size) {
 	uint32 end_va = ROUNDUP(virtual_address + size, PAGE_SIZE);
 	uint32* ptr_page_table = NULL;
 
+	env_page_ws_invalidate_range(e, start_Va, end_va - start_Va);
 	for (uint32 va = start_Va; va < end_va; va += PAGE_SIZE)
 	{
 		pf_remove_env_page(e, va);
 
-		env_page_ws_invalidate(e, va);
 		int ret = get_page_table(e->env_page_directory, va, &ptr_page_table);
 		if (ret == TABLE_IN_MEMORY) {
 			if (ptr_page_table[PTX(va)] & PERM_PRESENT) {
 				unmap_frame(e->env_page_directory, va);
 			}
+			else if (ptr_page_table[PTX(va)] & PERM_BUFFERED) {
+				writeback_cancel(e, va);
+			}
 
 			ptr_page_table[PTX(va)] = 0;
 		}
@@ -202,17 +233,49 @@ void free_user_mem(struct Env* e, uint32 virtual_address, uint32 size) {
 //=====================================
 void __free_user_mem_with_buffering(struct Env* e, uint32 virtual_address,
 		uint32 size) {
-	// your code is here, remove the panic and write your code
-	panic("__free_user_mem_with_buffering() is not implemented yet...!!");
+	//the buffered frames of the range are dropped from the free/modified lists
+	//by free_user_mem() itself (see writeback_cancel())
+	free_user_mem(e, virtual_address, size);
 
 }
 
 //=====================================
 // 3) MOVE USER MEMORY:
 //=====================================
+//	Moves the pages of [src, src+size) to [dst, dst+size) WITHOUT copying their content:
+//	the page table entries (frame + permissions), the disk frames and the WS elements are moved
+//	to the destination, then the source range is cleared.
 void move_user_mem(struct Env* e, uint32 src_virtual_address,
 		uint32 dst_virtual_address, uint32 size) {
-	panic("move_user_mem() is not implemented yet...!!");
+	uint32 src_va = ROUNDDOWN(src_virtual_address, PAGE_SIZE);
+	uint32 dst_va = ROUNDDOWN(dst_virtual_address, PAGE_SIZE);
+	uint32 num_pages = ROUNDUP(src_virtual_address + size, PAGE_SIZE) / PAGE_SIZE - src_va / PAGE_SIZE;
+	uint32 *ptr_src_table = NULL, *ptr_dst_table = NULL;
+
+	for (uint32 i = 0; i < num_pages; i++, src_va += PAGE_SIZE, dst_va += PAGE_SIZE)
+	{
+		if (get_page_table(e->env_page_directory, src_va, &ptr_src_table) != TABLE_IN_MEMORY)
+			continue;
+
+		uint32 entry = ptr_src_table[PTX(src_va)];
+		//not touched yet: the destination is already marked by allocate_user_mem()
+		struct FrameInfo *ptr_frame_info = get_frame_info(e->env_page_directory, src_va, &ptr_src_table);
+		if (ptr_frame_info != NULL)
+		{
+			if (get_page_table(e->env_page_directory, dst_va, &ptr_dst_table) == TABLE_NOT_EXIST)
+				ptr_dst_table = create_page_table(e->env_page_directory, dst_va);
+			ptr_dst_table[PTX(dst_va)] = entry;
+			env_page_ws_move(e, src_va, dst_va);
+			//still waiting for the write-back daemon: let it write the page at its new place
+			if (entry & PERM_BUFFERED)
+				ptr_frame_info->va = dst_va;
+		}
+		pf_move_env_page(e, src_va, dst_va);
+
+		ptr_src_table[PTX(src_va)] = 0;
+		tlb_invalidate(e->env_page_directory, (void *)src_va);
+		tlb_invalidate(e->env_page_directory, (void *)dst_va);
+	}
 }
 
 //=================================================================================//
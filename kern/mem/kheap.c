@@ -6,17 +6,23 @@
 #include <kern/proc/user_environment.h>
 #include <kern/mem/memory_manager.h>
 #include "../conc/kspinlock.h"
+#include <inc/string.h>
+#include <inc/x86.h>
 
 //==================================================================================//
 //============================== GIVEN FUNCTIONS ===================================//
 //==================================================================================//
 
+static void kheap_page_alloc_init();
+
 //==============================================
 // [1] INITIALIZE KERNEL HEAP:
 //==============================================
 //TODO: [PROJECT'25.GM#2] KERNEL HEAP - #0 kheap_init [GIVEN]
 //Remember to initialize locks (if any)
 void kheap_init() {
+	/*2025*/ //the DA mode should be set BEFORE initializing it
+	set_dyn_alloc_mode(KHEAP_DA_MODE);
 	//==================================================================================
 	//DON'T CHANGE THESE LINES==========================================================
 	//==================================================================================
@@ -30,6 +36,7 @@ void kheap_init() {
 	}
 	//==================================================================================
 	//==================================================================================
+	kheap_page_alloc_init();
 }
 
 //==============================================
@@ -57,113 +64,299 @@ void return_page(void* va) {
 //==================================================================================//
 //============================ REQUIRED FUNCTIONS ==================================//
 //==================================================================================//
-//===================================
-// [1] ALLOCATE SPACE IN KERNEL HEAP:
-//===================================
-int number_of_free_chunks = 0;
-static struct PageAllocChunk CHUNKS[(KERNEL_HEAP_START - KERNEL_HEAP_MAX)
-		/ PAGE_SIZE]; /////////////////////// i geuss it needs locks
 
-static int CHUNK_INDEX = 0;
-void* kmalloc(unsigned int size) {
-	//TODO: [PROJECT'25.GM#2] KERNEL HEAP - #1 kmalloc
-	//kpanic_into_prompt("kmalloc() is not implemented yet...!!");
-	/* =========================================================================== */
-	/* ================================== CASE_1 ================================= */
-	/* =================== size<=2KB uses alloc_block in DA======================= */
-	if (size <= DYN_ALLOC_MAX_BLOCK_SIZE)
-		return alloc_block(size);
+/*2025*/
+//=====================================================
+// PAGE ALLOCATOR ENGINE (SEGREGATED FIT):
+//=====================================================
+//	Every page in [kheapPageAllocStart, kheapPageAllocBreak) belongs to exactly one chunk.
+//	The chunk record is kept in a per-page lookup table indexed by the page number in the
+//	page allocator. The HEAD record of a chunk holds its info and the TAIL record points
+//	back to its head (via st_Va) so that both neighbors of a chunk are reachable in O(1).
+//
+//	Free chunks are kept in two-level segregated lists (TLSF-like):
+//		FL = power-of-two size class, SL = KHP_SL_COUNT linear sub-classes inside it
+//	with a bitmap of the non-empty lists, so a suitable free chunk is found by bit scans.
+
+#define KHP_NUM_OF_PAGES	((KERNEL_HEAP_MAX - KERNEL_HEAP_START - DYN_ALLOC_MAX_SIZE) / PAGE_SIZE)
+#define KHP_SL_LOG2			4
+#define KHP_SL_COUNT		(1 << KHP_SL_LOG2)
+#define KHP_FL_COUNT		16
+
+#define KHP_PAGE_INDEX(va)	(((uint32)(va) - kheapPageAllocStart) >> PGSHIFT)
+#define KHP_PAGE_VA(idx)	(kheapPageAllocStart + ((uint32)(idx) << PGSHIFT))
+
+static struct PageAllocChunk kheapChunkTable[KHP_NUM_OF_PAGES];
+static struct PageAllocChunk_List kheapFreeChunks[KHP_FL_COUNT][KHP_SL_COUNT];
+static uint32 kheapFLBitmap;
+static uint32 kheapSLBitmap[KHP_FL_COUNT];
+
+//map a number of pages to its segregated list [fl][sl]
+static inline void kheap_mapping(uint32 num_pages, int* fl, int* sl)
+{
+	if (num_pages < KHP_SL_COUNT)
+	{
+		*fl = 0;
+		*sl = num_pages;
+	}
+	else
+	{
+		int f = bsr(num_pages);
+		*fl = f - KHP_SL_LOG2 + 1;
+		*sl = (num_pages >> (f - KHP_SL_LOG2)) - KHP_SL_COUNT;
+	}
+}
 
-	uint32 alloced_size = ROUNDUP((uint32 )size, PAGE_SIZE);
-	int pages_to_alloc = alloced_size / PAGE_SIZE;
+static void kheap_insert_free_chunk(struct PageAllocChunk* chunk)
+{
+	int fl, sl;
+	kheap_mapping(chunk->num_pages, &fl, &sl);
+	LIST_INSERT_HEAD(&kheapFreeChunks[fl][sl], chunk);
+	kheapFLBitmap |= (1 << fl);
+	kheapSLBitmap[fl] |= (1 << sl);
+}
 
-	// save the exact fit chunk & largest chunk for (worst fit)
-	//**************************************************************************************************
-	struct PageAllocChunk *EXACT_FIT_Chunk = NULL;
-	struct PageAllocChunk *WORST_FIT_Chunk = NULL;
-	struct PageAllocChunk *Chunk = NULL;
-	// HERE WILL MAKE IF CONDITION WILL SPEED UP))(IF Page_Alloc_Chunks.HAS_ANY_FREE BLOCK)
-	if (number_of_free_chunks != 0) {
-		LIST_FOREACH(Chunk,&Page_Alloc_Chunks)
+static void kheap_remove_free_chunk(struct PageAllocChunk* chunk)
+{
+	int fl, sl;
+	kheap_mapping(chunk->num_pages, &fl, &sl);
+	LIST_REMOVE(&kheapFreeChunks[fl][sl], chunk);
+	if (LIST_EMPTY(&kheapFreeChunks[fl][sl]))
+	{
+		kheapSLBitmap[fl] &= ~(1 << sl);
+		if (kheapSLBitmap[fl] == 0)
+			kheapFLBitmap &= ~(1 << fl);
+	}
+}
+
+//set the HEAD & TAIL records of the chunk that starts at page "idx"
+static struct PageAllocChunk* kheap_set_chunk(uint32 idx, uint32 num_pages, bool is_free)
+{
+	struct PageAllocChunk* head = &kheapChunkTable[idx];
+	struct PageAllocChunk* tail = &kheapChunkTable[idx + num_pages - 1];
+	head->st_Va = KHP_PAGE_VA(idx);
+	head->num_pages = num_pages;
+	head->Size_limit = num_pages * PAGE_SIZE;
+	head->is_free = is_free;
+	if (tail != head)
+	{
+		tail->st_Va = head->st_Va;
+		tail->num_pages = num_pages;
+		tail->Size_limit = head->Size_limit;
+		tail->is_free = is_free;
+	}
+	return head;
+}
+
+static void kheap_clear_chunk(uint32 idx, uint32 num_pages)
+{
+	memset(&kheapChunkTable[idx], 0, sizeof(struct PageAllocChunk));
+	memset(&kheapChunkTable[idx + num_pages - 1], 0, sizeof(struct PageAllocChunk));
+}
+
+//first non-empty list whose chunks are ALL >= num_pages
+static struct PageAllocChunk* kheap_find_suitable(uint32 num_pages)
+{
+	int fl, sl;
+	if (num_pages >= KHP_SL_COUNT)
+		num_pages += (1 << (bsr(num_pages) - KHP_SL_LOG2)) - 1;
+	kheap_mapping(num_pages, &fl, &sl);
+	if (fl >= KHP_FL_COUNT)
+		return NULL;
+
+	uint32 slMap = kheapSLBitmap[fl] & (~0U << sl);
+	if (slMap == 0)
+	{
+		uint32 flMap = (fl + 1 < KHP_FL_COUNT) ? kheapFLBitmap & (~0U << (fl + 1)) : 0;
+		if (flMap == 0)
+			return NULL;
+		fl = bsf(flMap);
+		slMap = kheapSLBitmap[fl];
+	}
+	sl = bsf(slMap);
+	return LIST_FIRST(&kheapFreeChunks[fl][sl]);
+}
+
+//free chunk of EXACTLY num_pages (only its own size class is visited)
+static struct PageAllocChunk* kheap_find_exact(uint32 num_pages)
+{
+	int fl, sl;
+	kheap_mapping(num_pages, &fl, &sl);
+	if (fl >= KHP_FL_COUNT || (kheapSLBitmap[fl] & (1 << sl)) == 0)
+		return NULL;
+	struct PageAllocChunk* chunk;
+	LIST_FOREACH(chunk, &kheapFreeChunks[fl][sl])
+	{
+		if (chunk->num_pages == num_pages)
+			return chunk;
+	}
+	return NULL;
+}
+
+//smallest free chunk >= num_pages in its own size class, else the first suitable one above it
+static struct PageAllocChunk* kheap_find_best(uint32 num_pages)
+{
+	int fl, sl;
+	kheap_mapping(num_pages, &fl, &sl);
+	struct PageAllocChunk *chunk, *best = NULL;
+	if (fl < KHP_FL_COUNT && (kheapSLBitmap[fl] & (1 << sl)))
+	{
+		LIST_FOREACH(chunk, &kheapFreeChunks[fl][sl])
 		{
-			if (Chunk->is_free) {
-				if (Chunk->Size_limit == alloced_size) {
-					EXACT_FIT_Chunk = Chunk;
-					break;
-				}
-				if (WORST_FIT_Chunk == NULL
-						|| Chunk->Size_limit > WORST_FIT_Chunk->Size_limit)
-					WORST_FIT_Chunk = Chunk; // means bigger chunk
-			}
+			if (chunk->num_pages >= num_pages && (best == NULL || chunk->num_pages < best->num_pages))
+				best = chunk;
 		}
 	}
-	//***************************************************************************************************
+	if (best == NULL)
+		best = kheap_find_suitable(num_pages);
+	return best;
+}
+
+//largest free chunk (only the highest non-empty size class is visited)
+static struct PageAllocChunk* kheap_find_largest(uint32 num_pages)
+{
+	if (kheapFLBitmap == 0)
+		return NULL;
+	int fl = bsr(kheapFLBitmap);
+	int sl = bsr(kheapSLBitmap[fl]);
+	struct PageAllocChunk *chunk, *largest = NULL;
+	LIST_FOREACH(chunk, &kheapFreeChunks[fl][sl])
+	{
+		if (largest == NULL || chunk->num_pages > largest->num_pages)
+			largest = chunk;
+	}
+	if (largest->num_pages < num_pages)
+		return NULL;
+	return largest;
+}
+
+static void kheap_page_alloc_init()
+{
+	for (int fl = 0; fl < KHP_FL_COUNT; ++fl)
+	{
+		for (int sl = 0; sl < KHP_SL_COUNT; ++sl)
+			LIST_INIT(&kheapFreeChunks[fl][sl]);
+		kheapSLBitmap[fl] = 0;
+	}
+	kheapFLBitmap = 0;
+	memset(kheapChunkTable, 0, sizeof(kheapChunkTable));
+}
+
+//reserve the VA of a chunk of num_pages (based on the current strategy) WITHOUT allocating its frames
+//returns its page index, or -1 if no enough space
+static int kheap_reserve_pages(uint32 pages_to_alloc)
+{
 	/* =========================================================================== */
 	/* ================================== CASE_2 ================================= */
-	/* ================================ EXCAT FIT ================================ */
-	if (EXACT_FIT_Chunk != NULL) { // found exact chunk with equal size needed
-		for (int i = 0; i < pages_to_alloc; i++) {
-			get_page(
-					(void*) ((uint32) (EXACT_FIT_Chunk->st_Va
-							+ (uint32) i * PAGE_SIZE)));
+	/* ================= FIND A FREE CHUNK BASED ON THE STRATEGY ================= */
+	struct PageAllocChunk *Chunk = NULL;
+	switch (get_kheap_strategy())
+	{
+	case KHP_PLACE_CONTALLOC:
+		break;
+	case KHP_PLACE_BESTFIT:
+		Chunk = kheap_find_best(pages_to_alloc);
+		break;
+	case KHP_PLACE_WORSTFIT:
+		Chunk = kheap_find_largest(pages_to_alloc);
+		break;
+	case KHP_PLACE_CUSTOMFIT:
+		//EXACT FIT, else WORST FIT
+		Chunk = kheap_find_exact(pages_to_alloc);
+		if (Chunk == NULL)
+			Chunk = kheap_find_largest(pages_to_alloc);
+		break;
+	default:
+		//FIRST & NEXT FIT: first suitable chunk in size order
+		Chunk = kheap_find_suitable(pages_to_alloc);
+		break;
+	}
+
+	uint32 idx;
+	if (Chunk != NULL)
+	{
+		idx = KHP_PAGE_INDEX(Chunk->st_Va);
+		uint32 OLDChunkPagesNum = Chunk->num_pages;
+		kheap_remove_free_chunk(Chunk);
+		//split the remaining part as a new free chunk
+		if (OLDChunkPagesNum > pages_to_alloc)
+		{
+			struct PageAllocChunk *splitted_Chunk = kheap_set_chunk(idx + pages_to_alloc, OLDChunkPagesNum - pages_to_alloc, 1);
+			kheap_insert_free_chunk(splitted_Chunk);
 		}
-		EXACT_FIT_Chunk->is_free = 0;
-		EXACT_FIT_Chunk->num_pages = pages_to_alloc;
-		number_of_free_chunks--;
-		return (void*) (uint32) EXACT_FIT_Chunk->st_Va;
 	}
 	/* =========================================================================== */
 	/* ================================== CASE_3 ================================= */
-	/* ================================ WORST FIT ================================ */
-	if (WORST_FIT_Chunk != NULL && WORST_FIT_Chunk->Size_limit > alloced_size) {
-		uint32 OLDChunkSize = WORST_FIT_Chunk->Size_limit;
-		int OLDChunkPagesNum = WORST_FIT_Chunk->num_pages;
-
-		struct PageAllocChunk *splitted_Chunk = &CHUNKS[CHUNK_INDEX++];
-		if (splitted_Chunk == NULL) {
-			cprintf("null splitted_Chunk pointer");
-			return NULL;
+	/* ================== TAKE FROM UNUSED AREA (MOVE BREAK UP) ================== */
+	else
+	{
+		/* ========================== NO ENOUGH MEMORY ========================== */
+		if (KERNEL_HEAP_MAX - kheapPageAllocBreak < pages_to_alloc * PAGE_SIZE)
+			return -1;
+		idx = KHP_PAGE_INDEX(kheapPageAllocBreak);
+		kheapPageAllocBreak += pages_to_alloc * PAGE_SIZE;
+	}
+	kheap_set_chunk(idx, pages_to_alloc, 0);
+	return idx;
+}
+
+//release the VA of the (already unmapped) chunk at page "idx": merge it with its free neighbors
+static void kheap_release_pages(uint32 idx, uint32 num_pages)
+{
+	kheap_clear_chunk(idx, num_pages);
+
+	// if previous chunk is free: merge with it
+	if (idx > 0) {
+		struct PageAllocChunk *prevChunk = &kheapChunkTable[KHP_PAGE_INDEX(kheapChunkTable[idx - 1].st_Va)];
+		if (prevChunk->is_free) {
+			uint32 prevIdx = KHP_PAGE_INDEX(prevChunk->st_Va);
+			uint32 prevPages = prevChunk->num_pages;
+			kheap_remove_free_chunk(prevChunk);
+			kheap_clear_chunk(prevIdx, prevPages);
+			idx = prevIdx;
+			num_pages += prevPages;
 		}
-		splitted_Chunk->Size_limit = OLDChunkSize - alloced_size;
-		splitted_Chunk->is_free = 1;
-		splitted_Chunk->num_pages = OLDChunkPagesNum - pages_to_alloc;
-		splitted_Chunk->st_Va =
-				(uint32) (WORST_FIT_Chunk->st_Va + alloced_size);
-		LIST_INSERT_AFTER(&Page_Alloc_Chunks,WORST_FIT_Chunk, splitted_Chunk);
-
-		for (int i = 0; i < pages_to_alloc; i++) {
-			get_page(
-					(void*) ((uint32) (WORST_FIT_Chunk->st_Va
-							+ (uint32) i * PAGE_SIZE)));
+	}
+	// if next chunk is free: merge with it
+	if (KHP_PAGE_VA(idx + num_pages) < kheapPageAllocBreak) {
+		struct PageAllocChunk *nextChunk = &kheapChunkTable[idx + num_pages];
+		if (nextChunk->is_free) {
+			uint32 nextPages = nextChunk->num_pages;
+			kheap_remove_free_chunk(nextChunk);
+			kheap_clear_chunk(idx + num_pages, nextPages);
+			num_pages += nextPages;
 		}
-
-		WORST_FIT_Chunk->Size_limit = alloced_size;
-		WORST_FIT_Chunk->is_free = 0;
-		WORST_FIT_Chunk->num_pages = pages_to_alloc;
-
-		return (void*) (uint32) (WORST_FIT_Chunk->st_Va);
 	}
-	/* =========================================================================== */
-	/* ================================== CASE_4 ================================= */
-	/* ================== TAKE FROM UNUSED AREA (MOVE BREAK UP) ================== */
-
-	/* ========================== CASE_5 (NO ENOUGH MEMORY) ========================== */
-	if (KERNEL_HEAP_MAX - kheapPageAllocBreak < alloced_size) {
-		return NULL;
+	// last chunk: move the break down instead of keeping it as a free chunk
+	if (KHP_PAGE_VA(idx + num_pages) == kheapPageAllocBreak) {
+		kheapPageAllocBreak = KHP_PAGE_VA(idx);
+		return;
 	}
-	struct PageAllocChunk *NEWchunk = &CHUNKS[CHUNK_INDEX++];
+	kheap_insert_free_chunk(kheap_set_chunk(idx, num_pages, 1));
+}
 
-	NEWchunk->st_Va = kheapPageAllocBreak;
-	NEWchunk->is_free = 0;
-	NEWchunk->num_pages = pages_to_alloc;
-	NEWchunk->Size_limit = alloced_size;
-	kheapPageAllocBreak += NEWchunk->Size_limit;
-	LIST_INSERT_TAIL(&Page_Alloc_Chunks, NEWchunk);
+//===================================
+// [1] ALLOCATE SPACE IN KERNEL HEAP:
+//===================================
+void* kmalloc(unsigned int size) {
+	//TODO: [PROJECT'25.GM#2] KERNEL HEAP - #1 kmalloc
+	//kpanic_into_prompt("kmalloc() is not implemented yet...!!");
+	/* =========================================================================== */
+	/* ================================== CASE_1 ================================= */
+	/* =================== size<=2KB uses alloc_block in DA======================= */
+	if (size <= DYN_ALLOC_MAX_BLOCK_SIZE)
+		return alloc_block(size);
 
+	uint32 pages_to_alloc = ROUNDUP((uint32 )size, PAGE_SIZE) / PAGE_SIZE;
+
+	int idx = kheap_reserve_pages(pages_to_alloc);
+	if (idx < 0)
+		return NULL;
+	uint32 va = KHP_PAGE_VA(idx);
 	for (int i = 0; i < pages_to_alloc; i++) {
-		get_page((void*) ((uint32) (NEWchunk->st_Va + (uint32) i * PAGE_SIZE)));
+		get_page((void*) (va + (uint32) i * PAGE_SIZE));
 	}
-	return (void*) (uint32) (NEWchunk->st_Va);
+	return (void*) va;
 }
 
 //=================================
@@ -178,61 +371,19 @@ void kfree(void* virtual_address) {
 		free_block(virtual_address);
 		return;
 	}
-	/* ================================== Kfr 	ee page allocator ================================= */
+	/* ================================== Kfree page allocator ================================= */
 	if (va >= kheapPageAllocStart && va < kheapPageAllocBreak) {
-		struct PageAllocChunk *Chunk = NULL;
-
-		LIST_FOREACH(Chunk,&Page_Alloc_Chunks)
-		{
-			if (Chunk->st_Va == (uint32) virtual_address) {	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-				Chunk->is_free = 1;
-				number_of_free_chunks++;
-				for (int i = 0; i < Chunk->num_pages; i++) {
-					return_page((void*) Chunk->st_Va + (uint32) i * PAGE_SIZE);
-				}
-
-				// untill now you freed the desired chunk (check for prev,next chunks)
-				struct PageAllocChunk *prevChunk = LIST_PREV(Chunk);
-				struct PageAllocChunk *nextChunk = LIST_NEXT(Chunk);
-
-				// if brevieos chunk is free
-				if (prevChunk != NULL && prevChunk->is_free) {
-
-					for (int i = 0; i < prevChunk->num_pages; i++) {
-						return_page(
-								(void*) prevChunk->st_Va
-										+ (uint32) i * PAGE_SIZE);
-					}
-					Chunk->st_Va = prevChunk->st_Va;
-					Chunk->Size_limit += prevChunk->Size_limit;
-					Chunk->num_pages += prevChunk->num_pages;
-					LIST_REMOVE(&Page_Alloc_Chunks, prevChunk);
-					number_of_free_chunks--;
-				}
-
-				if (nextChunk != NULL && nextChunk->is_free) {
-
-					for (int i = 0; i < nextChunk->num_pages; i++) {
-						return_page(
-								(void*) nextChunk->st_Va
-										+ (uint32) i * PAGE_SIZE);
-					}
-					Chunk->Size_limit += nextChunk->Size_limit;
-					Chunk->num_pages += nextChunk->num_pages;
-					LIST_REMOVE(&Page_Alloc_Chunks, nextChunk);
-					number_of_free_chunks--;
-				}
-				struct PageAllocChunk *lastchunk = LIST_LAST(
-						&Page_Alloc_Chunks);
-				if (lastchunk == Chunk) {
-					kheapPageAllocBreak -= Chunk->Size_limit;
-					LIST_REMOVE(&Page_Alloc_Chunks, Chunk);
-					number_of_free_chunks--;
-					return;
-				}
-			}///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
+		uint32 idx = KHP_PAGE_INDEX(va);
+		struct PageAllocChunk *Chunk = &kheapChunkTable[idx];
+		//must be the start of an allocated chunk
+		if (Chunk->st_Va != va || Chunk->num_pages == 0 || Chunk->is_free)
+			return;
+
+		uint32 num_pages = Chunk->num_pages;
+		for (int i = 0; i < num_pages; i++) {
+			return_page((void*) va + (uint32) i * PAGE_SIZE);
 		}
+		kheap_release_pages(idx, num_pages);
 	}
 }
 
@@ -294,44 +445,110 @@ unsigned int kheap_physical_address(unsigned int virtual_address) {
 //	A call with virtual_address = null is equivalent to kmalloc().
 //	A call with new_size = zero is equivalent to kfree().
 
-extern __inline__ uint32 get_block_size(void *va);
+//	Page chunks are resized in place whenever possible (shrink, or grow into a free next chunk/the break).
+//	Otherwise, the chunk is moved by remapping its frames to the new VA instead of copying its content.
+
+//move the frame mapped at "old_va" to "new_va" (no copy)
+static void kheap_remap_page(uint32 old_va, uint32 new_va)
+{
+	uint32 *ptr_page_table;
+	struct FrameInfo *ptr_frame_info = get_frame_info(ptr_page_directory, old_va, &ptr_page_table);
+	if (ptr_frame_info == NULL)
+		panic("krealloc: page at va %x is not mapped", old_va);
+	map_frame(ptr_page_directory, ptr_frame_info, new_va, PERM_WRITEABLE);
+	unmap_frame(ptr_page_directory, old_va);
+	ptr_frame_info->frame_virt_addr = new_va;
+}
+
+//move the content of a block/chunk to a new allocation of "new_size" (memcpy)
+static void *krealloc_copy(void *virtual_address, uint32 old_size, uint32 new_size)
+{
+	void *new_va = kmalloc(new_size);
+	if (new_va == NULL)
+		return NULL;
+	memcpy(new_va, virtual_address, MIN(old_size, new_size));
+	kfree(virtual_address);
+	return new_va;
+}
 
 void *krealloc(void *virtual_address, uint32 new_size) {
 	//TODO: [PROJECT'25.BONUS#2] KERNEL REALLOC - krealloc
-	/*uint32 va = (uint32) virtual_address;
+	uint32 va = (uint32) virtual_address;
 	if (virtual_address == NULL)
 		return kmalloc(new_size);
 	if (new_size == 0) {
 		kfree(virtual_address);
 		return NULL;
 	}
-	if (va >= dynAllocStart && va < dynAllocEnd) { //we have block allocator
-
-		uint32 old_size = get_block_size(virtual_address);
-		struct BlockElement *NewBlk = alloc_block(new_size);
-		// memcpy(void *dst, const void *src, uint32 n)
-		memcpy((void*) NewBlk, virtual_address, old_size);
-		free_block(virtual_address);
-		return NewBlk;
-	} else if (va >= KERNEL_HEAP_START && va < KERNEL_HEAP_MAX) { // we have page alocator
-		struct PageAllocChunk *Chunk = NULL;
-		LIST_FOREACH(Chunk,&Page_Alloc_Chunks)
-		{
-			struct PageAllocChunk *prevChunk = LIST_PREV(Chunk);
-			struct PageAllocChunk *nextChunk = LIST_NEXT(Chunk);
-			if (Chunk->st_Va == (uint32) virtual_address) {
-				if (nextChunk != NULL && nextChunk->is_free) {
-					if ((Chunk->Size_limit + nextChunk->Size_limit)
-							> new_size) { // there is space upove to expand
-
-					}
+	/* ================================== BLOCK ALLOCATOR ================================= */
+	if (va >= dynAllocStart && va < dynAllocEnd) {
+		if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE) {
+			void *new_va = realloc_block(virtual_address, new_size);
+			if (new_va != NULL)
+				return new_va;
+		}
+		//crosses 2 KB: promote it to the page allocator
+		return krealloc_copy(virtual_address, get_block_size(virtual_address), new_size);
+	}
+	/* ================================== PAGE ALLOCATOR ================================= */
+	if (va < kheapPageAllocStart || va >= kheapPageAllocBreak)
+		return NULL;
+	uint32 idx = KHP_PAGE_INDEX(va);
+	struct PageAllocChunk *Chunk = &kheapChunkTable[idx];
+	if (Chunk->st_Va != va || Chunk->num_pages == 0 || Chunk->is_free)
+		return NULL;
 
-				}
-			}
+	uint32 old_pages = Chunk->num_pages;
+	//fits in a block: demote it to the block allocator
+	if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE)
+		return krealloc_copy(virtual_address, old_pages * PAGE_SIZE, new_size);
+
+	uint32 new_pages = ROUNDUP(new_size, PAGE_SIZE) / PAGE_SIZE;
+	if (new_pages == old_pages)
+		return virtual_address;
+
+	/* ========================== SHRINK: FREE THE TAIL ========================== */
+	if (new_pages < old_pages) {
+		kheap_set_chunk(idx, new_pages, 0);
+		kheap_set_chunk(idx + new_pages, old_pages - new_pages, 0);
+		kfree((void*) KHP_PAGE_VA(idx + new_pages));
+		return virtual_address;
+	}
 
+	/* ========================== GROW IN PLACE ========================== */
+	uint32 extra_pages = new_pages - old_pages;
+	uint32 next_idx = idx + old_pages;
+	bool grown = 0;
+	if (KHP_PAGE_VA(next_idx) == kheapPageAllocBreak) {
+		if (KERNEL_HEAP_MAX - kheapPageAllocBreak >= extra_pages * PAGE_SIZE) {
+			kheapPageAllocBreak += extra_pages * PAGE_SIZE;
+			grown = 1;
 		}
-
 	}
-	*/
-	panic("krealloc() is not implemented yet...!!");
+	else if (kheapChunkTable[next_idx].is_free && kheapChunkTable[next_idx].num_pages >= extra_pages) {
+		uint32 next_pages = kheapChunkTable[next_idx].num_pages;
+		kheap_remove_free_chunk(&kheapChunkTable[next_idx]);
+		kheap_clear_chunk(next_idx, next_pages);
+		if (next_pages > extra_pages)
+			kheap_insert_free_chunk(kheap_set_chunk(idx + new_pages, next_pages - extra_pages, 1));
+		grown = 1;
+	}
+	if (grown) {
+		kheap_set_chunk(idx, new_pages, 0);
+		for (uint32 i = old_pages; i < new_pages; i++)
+			get_page((void*) (va + i * PAGE_SIZE));
+		return virtual_address;
+	}
+
+	/* ========================== MOVE: REMAP THE FRAMES ========================== */
+	int new_idx = kheap_reserve_pages(new_pages);
+	if (new_idx < 0)
+		return NULL;
+	uint32 new_va = KHP_PAGE_VA(new_idx);
+	for (uint32 i = 0; i < old_pages; i++)
+		kheap_remap_page(va + i * PAGE_SIZE, new_va + i * PAGE_SIZE);
+	for (uint32 i = old_pages; i < new_pages; i++)
+		get_page((void*) (new_va + i * PAGE_SIZE));
+	kheap_release_pages(idx, old_pages);
+	return (void*) new_va;
 }
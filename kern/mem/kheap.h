@@ -6,6 +6,7 @@
 #endif
 
 #include <inc/types.h>
+#include <inc/dynamic_allocator.h>
 
 /*2017*/
 //Values for user heap placement strategy
@@ -16,6 +17,11 @@
 #define KHP_PLACE_WORSTFIT 	0x4
 #define KHP_PLACE_CUSTOMFIT 0x5
 
+/*2025*/
+//DA mode of the kernel heap (see DA_MODE_XXX in inc/dynamic_allocator.h), set once in kheap_init().
+//	The kheap tests check the free block lists, so they expect DA_MODE_LIST
+#define KHEAP_DA_MODE	DA_MODE_LIST
+
 //TODO: [PROJECT'25.GM#2] KERNEL HEAP - #0 Page Alloc Limits [GIVEN]
 uint32 kheapPageAllocStart;
 uint32 kheapPageAllocBreak;
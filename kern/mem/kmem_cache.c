@@ -0,0 +1,171 @@
+/*
+ * kmem_cache.c
+ *
+ *  Object caches (slab layer) for the kernel fixed-size structures.
+ *  Slab pages are taken from the kernel heap page allocator (kmalloc/kfree of one page,
+ *  i.e. get_page()/return_page()) only when needed, so no memory is reserved at boot.
+ */
+
+#include "kmem_cache.h"
+#include <inc/string.h>
+#include <inc/assert.h>
+#include <inc/memlayout.h>
+#include <inc/environment_definitions.h>
+#include "kheap.h"
+#include "shared_memory_manager.h"
+
+static struct kmem_cache kmemCaches[KMEM_CACHE_MAX_NUM];
+static int kmemNumOfCaches = 0;
+
+//==============================================
+// [1] INITIALIZE THE KERNEL CACHES:
+//==============================================
+void kmem_cache_init()
+{
+	kmemNumOfCaches = 0;
+	ws_element_cache = kmem_cache_create("WorkingSetElement", sizeof(struct WorkingSetElement), 0, NULL);
+	share_cache = kmem_cache_create("Share", sizeof(struct Share), 0, NULL);
+	share_frames_cache = kmem_cache_create("FrameInfo*[]", SHARE_FRAMES_CACHE_ENTRIES * sizeof(struct FrameInfo*), 0, NULL);
+	if (ws_element_cache == NULL || share_cache == NULL || share_frames_cache == NULL)
+		panic("kmem_cache_init(): failed to create the kernel caches");
+}
+
+//==============================================
+// [2] CREATE A NEW CACHE:
+//==============================================
+//align: power of 2 (0 means word-aligned)
+//Return: ptr to the cache, NULL if the params are invalid or no more caches are available
+struct kmem_cache* kmem_cache_create(char* name, uint32 objsize, uint32 align, void (*ctor)(void*))
+{
+	if (kmemNumOfCaches == KMEM_CACHE_MAX_NUM)
+		return NULL;
+	if (align == 0)
+		align = sizeof(void*);
+	if ((align & (align - 1)) != 0 || objsize == 0)
+		return NULL;
+
+	objsize = ROUNDUP(objsize, align);
+	//largest number of objects that fit with the header & the free-index array
+	int n = (PAGE_SIZE - sizeof(struct kmem_slab)) / (objsize + sizeof(uint16));
+	while (n > 0 && ROUNDUP(sizeof(struct kmem_slab) + n * sizeof(uint16), align) + n * objsize > PAGE_SIZE)
+		n--;
+	if (n <= 0)
+		return NULL;
+
+	struct kmem_cache* cache = &kmemCaches[kmemNumOfCaches++];
+	memset(cache, 0, sizeof(struct kmem_cache));
+	strncpy(cache->name, name, KMEM_CACHE_NAME_LEN - 1);
+	cache->objsize = objsize;
+	cache->align = align;
+	cache->objs_per_slab = n;
+	cache->ctor = ctor;
+	LIST_INIT(&cache->slabs_full);
+	LIST_INIT(&cache->slabs_partial);
+	LIST_INIT(&cache->slabs_free);
+	return cache;
+}
+
+static struct kmem_slab* kmem_slab_create(struct kmem_cache* cache)
+{
+	struct kmem_slab* slab = kmalloc(PAGE_SIZE);
+	if (slab == NULL)
+		return NULL;
+	slab->cache = cache;
+	slab->free_idx = (uint16*)((uint32)slab + sizeof(struct kmem_slab));
+	slab->objects = (uint8*)ROUNDUP((uint32)slab->free_idx + cache->objs_per_slab * sizeof(uint16), cache->align);
+	slab->num_free = cache->objs_per_slab;
+	slab->free_top = 0;
+	//push in reverse order so that objects are given in address order
+	for (int i = cache->objs_per_slab - 1; i >= 0; --i)
+	{
+		slab->free_idx[slab->free_top++] = i;
+		if (cache->ctor != NULL)
+			cache->ctor(slab->objects + i * cache->objsize);
+	}
+	cache->num_slabs_created++;
+	return slab;
+}
+
+//==============================================
+// [3] ALLOCATE AN OBJECT:
+//==============================================
+void* kmem_cache_alloc(struct kmem_cache* cache)
+{
+	struct kmem_slab* slab = LIST_FIRST(&cache->slabs_partial);
+	if (slab == NULL)
+	{
+		slab = LIST_FIRST(&cache->slabs_free);
+		if (slab != NULL)
+			LIST_REMOVE(&cache->slabs_free, slab);
+		else if ((slab = kmem_slab_create(cache)) == NULL)
+			return NULL;
+		LIST_INSERT_HEAD(&cache->slabs_partial, slab);
+	}
+
+	uint16 idx = slab->free_idx[--slab->free_top];
+	slab->num_free--;
+	if (slab->num_free == 0)
+	{
+		LIST_REMOVE(&cache->slabs_partial, slab);
+		LIST_INSERT_HEAD(&cache->slabs_full, slab);
+	}
+	cache->num_active++;
+	cache->num_allocs++;
+	return slab->objects + idx * cache->objsize;
+}
+
+//==============================================
+// [4] FREE AN OBJECT:
+//==============================================
+void kmem_cache_free(struct kmem_cache* cache, void* obj)
+{
+	if (obj == NULL)
+		return;
+	struct kmem_slab* slab = (struct kmem_slab*)ROUNDDOWN((uint32)obj, PAGE_SIZE);
+	if (slab->cache != cache)
+		panic("kmem_cache_free(): object %x does not belong to cache \"%s\"", obj, cache->name);
+
+	uint32 offset = (uint8*)obj - slab->objects;
+	if (offset % cache->objsize != 0 || offset / cache->objsize >= cache->objs_per_slab)
+		panic("kmem_cache_free(): invalid object address %x in cache \"%s\"", obj, cache->name);
+
+	slab->free_idx[slab->free_top++] = offset / cache->objsize;
+	slab->num_free++;
+	cache->num_active--;
+	cache->num_frees++;
+
+	if (slab->num_free == 1)
+	{
+		LIST_REMOVE(&cache->slabs_full, slab);
+		LIST_INSERT_HEAD(&cache->slabs_partial, slab);
+	}
+	if (slab->num_free == cache->objs_per_slab)
+	{
+		LIST_REMOVE(&cache->slabs_partial, slab);
+		//keep ONE empty slab to avoid thrashing on alloc/free at a slab boundary
+		if (LIST_EMPTY(&cache->slabs_free))
+		{
+			LIST_INSERT_HEAD(&cache->slabs_free, slab);
+		}
+		else
+		{
+			slab->cache = NULL;
+			kfree(slab);
+			cache->num_slabs_destroyed++;
+		}
+	}
+}
+
+//==============================================
+// [5] PRINT CACHES STATS:
+//==============================================
+void kmem_cache_print_all()
+{
+	cprintf("objsize obj/slab   active  slabs  empty     allocs      frees  cache\n");
+	for (int i = 0; i < kmemNumOfCaches; ++i)
+	{
+		struct kmem_cache* c = &kmemCaches[i];
+		cprintf("%7d %8d %8d %6d %6d %10d %10d  %s\n", c->objsize, c->objs_per_slab, c->num_active,
+				c->num_slabs_created - c->num_slabs_destroyed, LIST_SIZE(&c->slabs_free), c->num_allocs, c->num_frees, c->name);
+	}
+}
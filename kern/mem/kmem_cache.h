@@ -0,0 +1,66 @@
+#ifndef FOS_KERN_KMEM_CACHE_H_
+#define FOS_KERN_KMEM_CACHE_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+#include <inc/queue.h>
+
+/*2025*/
+//Object caches (slab layer) on top of the kernel heap pages.
+//Each slab is ONE page: [struct kmem_slab | free-index array | objects...]
+//so the slab of any object is found by rounding its address down to the page.
+
+#define KMEM_CACHE_MAX_NUM 	16
+#define KMEM_CACHE_NAME_LEN	32
+
+struct kmem_cache;
+
+struct kmem_slab
+{
+	LIST_ENTRY(kmem_slab) prev_next_info;	/* linked list links */
+	struct kmem_cache* cache;				//owner cache
+	uint16 num_free;						//number of free objects in this slab
+	uint16 free_top;						//top of the free-index stack
+	uint16* free_idx;						//stack of free object indices
+	uint8* objects;							//start of the first object
+};
+LIST_HEAD(kmem_slab_List, kmem_slab);
+
+struct kmem_cache
+{
+	char name[KMEM_CACHE_NAME_LEN];
+	uint32 objsize;							//object size after alignment
+	uint32 align;
+	uint32 objs_per_slab;
+	void (*ctor)(void*);					//called ONCE on each object when its slab is created
+
+	struct kmem_slab_List slabs_full;
+	struct kmem_slab_List slabs_partial;
+	struct kmem_slab_List slabs_free;
+
+	//stats
+	uint32 num_active;						//allocated objects
+	uint32 num_allocs;
+	uint32 num_frees;
+	uint32 num_slabs_created;
+	uint32 num_slabs_destroyed;
+};
+
+//caches of the kernel hottest structures [created by kmem_cache_init()]
+struct kmem_cache* ws_element_cache;		//struct WorkingSetElement
+struct kmem_cache* share_cache;				//struct Share
+struct kmem_cache* share_frames_cache;		//struct FrameInfo* [SHARE_FRAMES_CACHE_ENTRIES]
+
+//max number of frames for a share to take its framesStorage from share_frames_cache
+#define SHARE_FRAMES_CACHE_ENTRIES 16
+
+void kmem_cache_init();
+struct kmem_cache* kmem_cache_create(char* name, uint32 objsize, uint32 align, void (*ctor)(void*));
+void* kmem_cache_alloc(struct kmem_cache* cache);
+void kmem_cache_free(struct kmem_cache* cache, void* obj);
+void kmem_cache_print_all();
+
+#endif // FOS_KERN_KMEM_CACHE_H_
@@ -25,6 +25,8 @@ FUNCTIONS:	to_physical_address, get_frame_info, tlb_invalidate
 #include <kern/cpu/sched.h>
 #include <kern/disk/pagefile_manager.h>
 #include "kheap.h"
+#include "writeback.h"
+#include "reclaimer.h"
 
 
 
@@ -76,6 +78,7 @@ void initialize_paging()
 	int i;
 	LIST_INIT(&MemFrameLists.free_frame_list);
 	LIST_INIT(&MemFrameLists.modified_frame_list);
+	LIST_INIT(&MemFrameLists.writeback_frame_list);
 
 	//Initialize the corresponding lock
 	init_kspinlock(&MemFrameLists.mfllock, "Frame Info Lock");
@@ -86,7 +89,8 @@ void initialize_paging()
 	ptr_zero_page = (uint8*) KERNEL_BASE+PAGE_SIZE;
 	ptr_temp_page = (uint8*) KERNEL_BASE+2*PAGE_SIZE;
 	i =0;
-	for(;i<1024; i++)
+	//2025: the whole zero page, it's also mapped as is on the fresh user pages (see the lazy zero-fill)
+	for(;i<PAGE_SIZE; i++)
 	{
 		ptr_zero_page[i]=0;
 		ptr_temp_page[i]=0;
@@ -162,12 +166,21 @@ int allocate_frame(struct FrameInfo **ptr_frame_info)
 	*ptr_frame_info = LIST_FIRST(&MemFrameLists.free_frame_list);
 	int c = 0;
 
+	/*2025*/ //No free frame: block till the write-back daemon writes back some of the modified frames or the reclaimer
+	//	takes some from the other envs (if it can block here). No disk I/O is done here under the mfllock.
+	while (*ptr_frame_info == NULL && !lock_already_held && reclaimer_wait_free_frame())
+	{
+		*ptr_frame_info = LIST_FIRST(&MemFrameLists.free_frame_list);
+	}
+
 	if (*ptr_frame_info == NULL)
 	{
 		panic("ERROR: Kernel run out of memory... allocate_frame cannot find a free frame.\n");
 	}
 
 	LIST_REMOVE(&MemFrameLists.free_frame_list,*ptr_frame_info);
+	/*2025*/ //below the low watermark: wake up the reclaimer
+	reclaimer_notify();
 
 	/******************* PAGE BUFFERING CODE *******************
 	 ***********************************************************/
@@ -176,6 +189,8 @@ int allocate_frame(struct FrameInfo **ptr_frame_info)
 	{
 		/*MUST UN-COMMENT THIS LINE*/
 		//pt_clear_page_table_entry((*ptr_frame_info)->proc->env_page_directory,(*ptr_frame_info)->va);
+		/*2025*/ //detach it from its page, keeping the marks of the page itself (e.g. PERM_UHPAGE)
+		unbuffer_frame(*ptr_frame_info);
 	}
 
 	/**********************************************************
@@ -585,7 +600,7 @@ struct freeFramesCounters calculate_available_frames()
 		}
 
 		/*2023: UPDATE based on suggestion from T112 2023.Term1*/
-		totalModified= LIST_SIZE(&MemFrameLists.modified_frame_list);
+		totalModified= LIST_SIZE(&MemFrameLists.modified_frame_list) + LIST_SIZE(&MemFrameLists.writeback_frame_list);
 		//	LIST_FOREACH(ptr, &modified_frame_list)
 		//	{
 		//		totalModified++ ;
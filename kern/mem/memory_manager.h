@@ -36,6 +36,10 @@ uint32 _UHeapPlacementStrategy;
 /*2025*/ //Replaced by setter & getter function
 static inline void set_uheap_strategy(uint32 strategy){_UHeapPlacementStrategy = strategy;}
 static inline uint32 get_uheap_strategy(){return _UHeapPlacementStrategy ;}
+/*2025*/ //DA mode of the user heaps (see DA_MODE_XXX in inc/dynamic_allocator.h), read by each env on its uheap_init()
+uint32 _UHeapDAMode;
+static inline void set_uheap_da_mode(uint32 mode){_UHeapDAMode = mode;}
+static inline uint32 get_uheap_da_mode(){return _UHeapDAMode ;}
 
 //***********************************
 //2018 Memory Threshold
@@ -0,0 +1,169 @@
+/*
+ * reclaimer.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "reclaimer.h"
+#include <kern/proc/user_environment.h>
+#include <kern/cpu/sched.h>
+#include <kern/cpu/cpu.h>
+#include "memory_manager.h"
+#include "working_set_manager.h"
+#include "writeback.h"
+
+static void reclaimer_daemon(void);
+
+//=====================================
+// [1] START THE RECLAIMER DAEMON:
+//=====================================
+void reclaimer_init()
+{
+	init_channel(&ReclaimerChannel, "reclaimer");
+	init_channel(&FreeFramesChannel, "free frames");
+	setReclaimWatermarks(memory_scarce_threshold_percentage, memory_scarce_threshold_percentage + RECLAIM_WATERMARKS_GAP_PERCENTAGE);
+
+	ReclaimerDaemon = env_create_kernel("reclaimer", reclaimer_daemon);
+	if (ReclaimerDaemon == NULL)
+		panic("reclaimer_init: can't create the reclaimer daemon");
+
+	//It starts BLOCKED on its channel till the free frames get below the low watermark
+	acquire_kspinlock(&ProcessQueues.qlock);
+	{
+		ReclaimerDaemon->env_status = ENV_BLOCKED;
+		enqueue(&(ReclaimerChannel.queue), ReclaimerDaemon);
+	}
+	release_kspinlock(&ProcessQueues.qlock);
+}
+
+//Watermarks as % of the frames (e.g. memory_scarce_threshold_percentage: the memory is scarce below it)
+void setReclaimWatermarks(uint32 lowPercentage, uint32 highPercentage)
+{
+	highPercentage = MIN(MAX(highPercentage, lowPercentage), 100);
+	_ReclaimLowWatermark = lowPercentage * number_of_frames / 100;
+	_ReclaimHighWatermark = highPercentage * number_of_frames / 100;
+}
+uint32 getReclaimLowWatermark() { return _ReclaimLowWatermark; }
+uint32 getReclaimHighWatermark() { return _ReclaimHighWatermark; }
+
+static inline uint32 num_of_free_frames()
+{
+	return LIST_SIZE(&MemFrameLists.free_frame_list);
+}
+
+//Is there a work for the daemon? the free frames are below the low watermark or someone waits for a free frame
+static int reclaim_pending()
+{
+	return num_of_free_frames() < _ReclaimLowWatermark || queue_size(&(FreeFramesChannel.queue)) > 0;
+}
+
+//=====================================
+// [2] CALLED BY THE FRAME ALLOCATOR:
+//=====================================
+//Wake up the daemon if the free frames get below the low watermark (the mfllock should be held)
+void reclaimer_notify()
+{
+	if (ReclaimerDaemon != NULL && queue_size(&(ReclaimerChannel.queue)) > 0 && reclaim_pending())
+		wakeup_one(&ReclaimerChannel);
+}
+
+//No free frame: block the running env till the daemon frees some (or the write-back daemon writes back some of the modified ones).
+//	The mfllock should be held by the caller itself (it's released while sleeping) & no other lock.
+//Returns 0 if it can't block here (e.g. no env, the daemon itself or other locks are held)
+int reclaimer_wait_free_frame()
+{
+	struct Env* cur = get_cpu_proc();
+	if (ReclaimerDaemon == NULL || cur == NULL || cur == ReclaimerDaemon || cur == WriteBackDaemon || mycpu()->ncli != 1)
+		return 0;
+	reclaimer_notify();
+	if (!LIST_EMPTY(&MemFrameLists.modified_frame_list) && queue_size(&(WriteBackChannel.queue)) > 0)
+		wakeup_one(&WriteBackChannel);
+	sleep(&FreeFramesChannel, &MemFrameLists.mfllock);
+	return 1;
+}
+
+//=====================================
+// [3] RECLAIM FRAMES:
+//=====================================
+//The READY/BLOCKED user env that ran least recently after "after" (i.e. with (lastRunTick, index) > after's).
+//	An env that's in the middle of its fault handling is skipped: its victim may be already chosen
+//	(e.g. it's blocked in allocate_frame() waiting for a free frame)
+static struct Env* reclaim_next_victim(struct Env* after)
+{
+	struct Env* victim = NULL;
+	for (int i = 0; i < NENV; i++)
+	{
+		struct Env* e = &envs[i];
+		if ((e->env_status != ENV_READY && e->env_status != ENV_BLOCKED) || e->page_WS_max_size == 0 || e->isHandlingFault)
+			continue;
+		if (after != NULL && (e->lastRunTick < after->lastRunTick || (e->lastRunTick == after->lastRunTick && e <= after)))
+			continue;
+		if (victim == NULL || e->lastRunTick < victim->lastRunTick)
+			victim = e;
+	}
+	return victim;
+}
+
+//Evict percentage_of_WS_pages_to_be_removed of the WS of the least recently run READY/BLOCKED envs, one env at a time,
+//	till the free frames reach the given watermark (or no env is left). Their dirty pages are written back to the page file.
+//Returns the number of freed frames
+uint32 reclaim_frames(uint32 highWatermark)
+{
+	uint32 numOfFreeBefore = num_of_free_frames();
+	struct Env* victim = NULL;
+	while (num_of_free_frames() < highWatermark && (victim = reclaim_next_victim(victim)) != NULL)
+	{
+		//it can't be scheduled while its WS is cut
+		pushcli();
+		{
+			uint32 size = LIST_SIZE(&(victim->page_WS_list)) + LIST_SIZE(&(victim->ActiveList)) + LIST_SIZE(&(victim->SecondList));
+			uint32 numOfPages = MAX(victim->percentage_of_WS_pages_to_be_removed * size / 100, 1);
+			env_page_ws_reclaim(victim, numOfPages);
+		}
+		popcli();
+		writeback_flush(LIST_SIZE(&MemFrameLists.modified_frame_list));
+	}
+	uint32 numOfFreeAfter = num_of_free_frames();
+	return numOfFreeAfter > numOfFreeBefore ? numOfFreeAfter - numOfFreeBefore : 0;
+}
+
+//=====================================
+// [4] THE DAEMON:
+//=====================================
+//Entered from the scheduler while holding the ProcessQueues.qlock (see env_create_kernel())
+static void reclaimer_daemon(void)
+{
+	release_kspinlock(&ProcessQueues.qlock);
+
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	while (1)
+	{
+		while (!reclaim_pending())
+		{
+			sleep(&ReclaimerChannel, &MemFrameLists.mfllock);
+		}
+		release_kspinlock(&MemFrameLists.mfllock);
+		uint32 numOfFreed = reclaim_frames(MAX(_ReclaimHighWatermark, 1));
+		acquire_kspinlock(&MemFrameLists.mfllock);
+
+		//the frames that are still being written back are freed by the write-back daemon
+		bool anyWaiting = queue_size(&(FreeFramesChannel.queue)) > 0;
+		if (anyWaiting && LIST_EMPTY(&MemFrameLists.free_frame_list) &&
+				LIST_EMPTY(&MemFrameLists.modified_frame_list) && LIST_EMPTY(&MemFrameLists.writeback_frame_list))
+			panic("ERROR: Kernel run out of memory... no frame can be reclaimed from the other envs.\n");
+		if (!LIST_EMPTY(&MemFrameLists.free_frame_list))
+			wakeup_all(&FreeFramesChannel);
+
+		//nothing left to take: wait till it's notified again
+		if (numOfFreed == 0)
+		{
+			sleep(&ReclaimerChannel, &MemFrameLists.mfllock);
+			continue;
+		}
+		//give-up the CPU between the rounds, the mfllock holds off the interrupts
+		release_kspinlock(&MemFrameLists.mfllock);
+		yield();
+		acquire_kspinlock(&MemFrameLists.mfllock);
+	}
+}
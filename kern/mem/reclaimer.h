@@ -0,0 +1,36 @@
+/*
+ * reclaimer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_MEM_RECLAIMER_H_
+#define KERN_MEM_RECLAIMER_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/environment_definitions.h>
+#include <kern/conc/channel.h>
+
+//High watermark = low watermark + this % of the frames (by default)
+#define RECLAIM_WATERMARKS_GAP_PERCENTAGE 5
+
+struct Env* ReclaimerDaemon;		//kernel-only env that takes frames from the idle envs under memory pressure
+struct Channel ReclaimerChannel;	//the daemon sleeps on it while the free frames are above the low watermark
+struct Channel FreeFramesChannel;	//allocate_frame() blocks on it while there's no free frame
+
+uint32 _ReclaimLowWatermark ;		//# free frames below which the daemon starts reclaiming (0: only on a blocked allocation)
+uint32 _ReclaimHighWatermark ;		//# free frames at which it stops
+
+void reclaimer_init();
+void setReclaimWatermarks(uint32 lowPercentage, uint32 highPercentage);
+uint32 getReclaimLowWatermark();
+uint32 getReclaimHighWatermark();
+void reclaimer_notify();
+int reclaimer_wait_free_frame();
+uint32 reclaim_frames(uint32 highWatermark);
+
+#endif /* KERN_MEM_RECLAIMER_H_ */
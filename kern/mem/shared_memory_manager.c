@@ -11,6 +11,7 @@
 #include <kern/proc/user_environment.h>
 #include <kern/trap/syscall.h>
 #include "kheap.h"
+#include "kmem_cache.h"
 #include "memory_manager.h"
 
 //==================================================================================//
@@ -86,7 +87,7 @@ int size_of_shared_object(int32 ownerID, char* shareName) {
 //=====================================
 struct Share* alloc_share(int32 ownerID, char* shareName, uint32 size,
 		uint8 isWritable) {
-	struct Share* sh = kmalloc(sizeof(struct Share));
+	struct Share* sh = kmem_cache_alloc(share_cache);
 	if (sh == NULL) {
 		return NULL;
 	}
@@ -106,9 +107,12 @@ struct Share* alloc_share(int32 ownerID, char* shareName, uint32 size,
 	if (pages == 0) {
 		pages = 1;
 	}
-	sh->framesStorage = kmalloc(pages * sizeof(struct FrameInfo*));
+	if (pages <= SHARE_FRAMES_CACHE_ENTRIES)
+		sh->framesStorage = kmem_cache_alloc(share_frames_cache);
+	else
+		sh->framesStorage = kmalloc(pages * sizeof(struct FrameInfo*));
 	if (sh->framesStorage == NULL) {
-		kfree(sh);
+		kmem_cache_free(share_cache, sh);
 		return NULL;
 	}
 
@@ -8,11 +8,85 @@
 #include <kern/trap/fault_handler.h>
 #include <kern/disk/pagefile_manager.h>
 #include "kheap.h"
+#include "kmem_cache.h"
 #include "memory_manager.h"
+#include "writeback.h"
 
 ///============================================================================================
 /// Dealing with environment working set
 #if USE_KHEAP
+//==============================
+// [0] WS HASH (VA -> WS ELEMENT)
+//==============================
+//Every WS element of the env (in page_WS_list or in the LRU Active/Second lists) is also chained
+//	in the bucket of its page number, so finding the element of a page needs no list walk.
+//	The lists themselves (i.e. their order) are NOT affected.
+#define PAGE_WS_HASH(va) ((ROUNDDOWN((va), PAGE_SIZE) >> PGSHIFT) & (PAGE_WS_HASH_SIZE - 1))
+
+void env_page_ws_hash_init(struct Env* e)
+{
+	e->page_WS_hash = kmalloc(PAGE_WS_HASH_SIZE * sizeof(struct WorkingSetElement*));
+	if (e->page_WS_hash == NULL)
+	{
+		panic("NOT ENOUGH KERNEL HEAP SPACE");
+	}
+	memset(e->page_WS_hash, 0, PAGE_WS_HASH_SIZE * sizeof(struct WorkingSetElement*));
+}
+
+void env_page_ws_hash_free(struct Env* e)
+{
+	if (e->page_WS_hash != NULL)
+	{
+		kfree(e->page_WS_hash);
+		e->page_WS_hash = NULL;
+	}
+}
+
+static void env_page_ws_hash_insert(struct Env* e, struct WorkingSetElement* wse)
+{
+	uint32 b = PAGE_WS_HASH(wse->virtual_address);
+	wse->hash_next = e->page_WS_hash[b];
+	e->page_WS_hash[b] = wse;
+}
+
+static void env_page_ws_hash_remove(struct Env* e, struct WorkingSetElement* wse)
+{
+	struct WorkingSetElement** pp = &(e->page_WS_hash[PAGE_WS_HASH(wse->virtual_address)]);
+	for (; *pp != NULL; pp = &((*pp)->hash_next))
+	{
+		if (*pp == wse)
+		{
+			*pp = wse->hash_next;
+			break;
+		}
+	}
+	wse->hash_next = NULL;
+}
+
+//Returns the WS element of the page at virtual_address, or NULL if it's not in the WS
+inline struct WorkingSetElement* env_page_ws_list_find_element(struct Env* e, uint32 virtual_address)
+{
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	struct WorkingSetElement* wse = e->page_WS_hash[PAGE_WS_HASH(virtual_address)];
+	for (; wse != NULL; wse = wse->hash_next)
+	{
+		if (wse->virtual_address == virtual_address)
+			return wse;
+	}
+	return NULL;
+}
+
+static void env_page_ws_ring_add(struct Env* e, struct WorkingSetElement* wse);
+static void env_page_ws_ring_remove(struct Env* e, struct WorkingSetElement* wse);
+
+//Free a WS element that is already removed from its list
+inline void env_page_ws_list_free_element(struct Env* e, struct WorkingSetElement* wse)
+{
+	env_page_ws_ring_remove(e, wse);
+	env_page_ws_hash_remove(e, wse);
+	kmem_cache_free(ws_element_cache, wse);
+}
+
 //==============================
 // [1] CREATE A NEW WS ELEMENT
 //==============================
@@ -20,7 +94,7 @@
 inline struct WorkingSetElement* env_page_ws_list_create_element(struct Env* e, uint32 virtual_address)
 {
 	assert(virtual_address >= 0 && virtual_address < USER_TOP);
-	struct WorkingSetElement *wse = kmalloc(sizeof(struct WorkingSetElement)) ;
+	struct WorkingSetElement *wse = kmem_cache_alloc(ws_element_cache) ;
 	if (wse == NULL)
 	{
 		panic("can't create a new WS element");
@@ -28,75 +102,231 @@ inline struct WorkingSetElement* env_page_ws_list_create_element(struct Env* e,
 	wse->virtual_address = ROUNDDOWN(virtual_address,PAGE_SIZE);
 	wse->sweeps_counter = 0;
 	wse->time_stamp = 0x00000000;
+	env_page_ws_hash_insert(e, wse);
+	env_page_ws_ring_add(e, wse);
 	return wse;
 }
+//==============================
+// [2] ARRAY CLOCK (WS RING)
+//==============================
+//An env created while it's enabled keeps, beside its page_WS_list, a ring of (VA, PTE ptr) entries, one per WS element,
+//	with the clock hand as an index, so the CLOCK sweeps walk a contiguous array & test/clear the USED bit
+//	through the cached PTEs. Each element knows its slot: a new one is added at the ring end, a victim is
+//	replaced in its slot & a freed one is swapped with the last entry, so the ring is updated in place in O(1).
+void enableWSRing(uint32 enableIt){_EnableWSRing = enableIt;}
+uint8 isWSRingEnabled(){  return _EnableWSRing ; }
+
+void env_page_ws_ring_init(struct Env* e)
+{
+	e->page_WS_ring = NULL;
+	e->page_WS_ring_size = 0;
+	e->page_WS_ring_hand = 0;
+	if (!isWSRingEnabled() || e->page_WS_max_size == 0)
+		return;
+	e->page_WS_ring = kmalloc(e->page_WS_max_size * sizeof(struct WSRingEntry));
+	if (e->page_WS_ring == NULL)
+	{
+		panic("NOT ENOUGH KERNEL HEAP SPACE");
+	}
+}
+
+void env_page_ws_ring_free(struct Env* e)
+{
+	if (e->page_WS_ring != NULL)
+	{
+		kfree(e->page_WS_ring);
+		e->page_WS_ring = NULL;
+	}
+	e->page_WS_ring_size = 0;
+}
+
+//Put the WS element (& its cached PTE) in the given ring slot
+static void env_page_ws_ring_set(struct Env* e, uint32 slot, struct WorkingSetElement* wse)
+{
+	uint32 *ptr_page_table = NULL;
+	struct WSRingEntry *entry = &(e->page_WS_ring[slot]);
+	get_page_table(e->env_page_directory, wse->virtual_address, &ptr_page_table);
+	entry->virtual_address = wse->virtual_address;
+	entry->ptr_pte = (ptr_page_table != NULL) ? &ptr_page_table[PTX(wse->virtual_address)] : NULL;
+	entry->wse = wse;
+	wse->ring_index = slot;
+}
+
+static inline int env_page_ws_ring_has(struct Env* e, struct WorkingSetElement* wse)
+{
+	return e->page_WS_ring != NULL && wse->ring_index < e->page_WS_ring_size && e->page_WS_ring[wse->ring_index].wse == wse;
+}
+
+//Add the new WS element at the ring end (if it has a room)
+static void env_page_ws_ring_add(struct Env* e, struct WorkingSetElement* wse)
+{
+	wse->ring_index = WS_RING_NONE;
+	if (e->page_WS_ring == NULL || e->page_WS_ring_size >= e->page_WS_max_size)
+		return;
+	env_page_ws_ring_set(e, e->page_WS_ring_size++, wse);
+}
+
+//Remove the WS element from the ring: the last entry takes its slot (with the hand, if it's at the last one)
+static void env_page_ws_ring_remove(struct Env* e, struct WorkingSetElement* wse)
+{
+	if (!env_page_ws_ring_has(e, wse))
+		return;
+	uint32 slot = wse->ring_index;
+	uint32 last = --(e->page_WS_ring_size);
+	if (slot != last)
+	{
+		e->page_WS_ring[slot] = e->page_WS_ring[last];
+		e->page_WS_ring[slot].wse->ring_index = slot;
+	}
+	if (e->page_WS_ring_hand == last)
+		e->page_WS_ring_hand = slot;
+	if (e->page_WS_ring_hand >= e->page_WS_ring_size)
+		e->page_WS_ring_hand = 0;
+	wse->ring_index = WS_RING_NONE;
+}
+
+//Rebuild the ring from the page_WS_list if it doesn't hold all of its elements (e.g. the replacement is changed
+//	or the ring is re-sized), that's not the case for any change of the list itself.
+//Returns 1 if the env has a ring that can be swept, 0 otherwise (i.e. use the list)
+int env_page_ws_ring_sync(struct Env* e)
+{
+	if (e->page_WS_ring == NULL)
+		return 0;
+	uint32 size = LIST_SIZE(&(e->page_WS_list));
+	if (size == 0 || size > e->page_WS_max_size)
+		return 0;
+	if (e->page_WS_ring_size == size)
+		return 1;
+
+	uint32 i = 0;
+	e->page_WS_ring_hand = 0;
+	struct WorkingSetElement *wse;
+	LIST_FOREACH(wse, &(e->page_WS_list))
+	{
+		env_page_ws_ring_set(e, i, wse);
+		if (wse == e->page_last_WS_element)
+			e->page_WS_ring_hand = i;
+		i++;
+	}
+	e->page_WS_ring_size = size;
+	return 1;
+}
+
+//Put the (new) WS element in place of the victim: same list position & ring slot,
+//	then advance the clock hand after it. The victim element is freed.
+inline void env_page_ws_replace_element(struct Env* e, struct WorkingSetElement* victim, struct WorkingSetElement* new_wse)
+{
+	LIST_INSERT_AFTER(&(e->page_WS_list), victim, new_wse);
+	LIST_REMOVE(&(e->page_WS_list), victim);
+
+	e->page_last_WS_element = LIST_NEXT(new_wse);
+	if (e->page_last_WS_element == NULL)
+		e->page_last_WS_element = LIST_FIRST(&(e->page_WS_list));
+
+	if (env_page_ws_ring_has(e, victim))
+	{
+		//the new element is just added at the ring end
+		uint32 slot = victim->ring_index;
+		env_page_ws_ring_remove(e, new_wse);
+		env_page_ws_ring_set(e, slot, new_wse);
+		victim->ring_index = WS_RING_NONE;
+		e->page_WS_ring_hand = (slot + 1) % e->page_WS_ring_size;
+	}
+
+	env_page_ws_list_free_element(e, victim);
+}
+
 inline void env_page_ws_invalidate(struct Env* e, uint32 virtual_address)
 {
 	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
 	{
-		bool found = 0;
-		struct WorkingSetElement *ptr_WS_element = NULL;
-		LIST_FOREACH(ptr_WS_element, &(e->ActiveList))
+		struct WorkingSetElement *ptr_WS_element = env_page_ws_list_find_element(e, virtual_address);
+		if (ptr_WS_element == NULL)
+			return;
+		//the Active pages are PRESENT while the Second ones are not
+		if (pt_get_page_permissions(e->env_page_directory, ptr_WS_element->virtual_address) & PERM_PRESENT)
 		{
-			if(ROUNDDOWN(ptr_WS_element->virtual_address,PAGE_SIZE) == ROUNDDOWN(virtual_address,PAGE_SIZE))
-			{
-				struct WorkingSetElement* ptr_tmp_WS_element = LIST_FIRST(&(e->SecondList));
-				unmap_frame(e->env_page_directory, ptr_WS_element->virtual_address);
+			struct WorkingSetElement* ptr_tmp_WS_element = LIST_FIRST(&(e->SecondList));
+			unmap_frame(e->env_page_directory, ptr_WS_element->virtual_address);
 
-				LIST_REMOVE(&(e->ActiveList), ptr_WS_element);
+			LIST_REMOVE(&(e->ActiveList), ptr_WS_element);
 
-				/*EDIT*/kfree(ptr_WS_element);
+			/*EDIT*/env_page_ws_list_free_element(e, ptr_WS_element);
 
-				if(ptr_tmp_WS_element != NULL)
-				{
-					LIST_REMOVE(&(e->SecondList), ptr_tmp_WS_element);
-					LIST_INSERT_TAIL(&(e->ActiveList), ptr_tmp_WS_element);
-					pt_set_page_permissions(e->env_page_directory, ptr_tmp_WS_element->virtual_address, PERM_PRESENT, 0);
-				}
-				found = 1;
-				break;
+			if(ptr_tmp_WS_element != NULL)
+			{
+				LIST_REMOVE(&(e->SecondList), ptr_tmp_WS_element);
+				LIST_INSERT_TAIL(&(e->ActiveList), ptr_tmp_WS_element);
+				pt_set_page_permissions(e->env_page_directory, ptr_tmp_WS_element->virtual_address, PERM_PRESENT, 0);
 			}
 		}
-
-		if (!found)
+		else
 		{
-			ptr_WS_element = NULL;
-			LIST_FOREACH(ptr_WS_element, &(e->SecondList))
-			{
-				if(ROUNDDOWN(ptr_WS_element->virtual_address,PAGE_SIZE) == ROUNDDOWN(virtual_address,PAGE_SIZE))
-				{
-					unmap_frame(e->env_page_directory, ptr_WS_element->virtual_address);
-					LIST_REMOVE(&(e->SecondList), ptr_WS_element);
-
-					kfree(ptr_WS_element);
+			unmap_frame(e->env_page_directory, ptr_WS_element->virtual_address);
+			LIST_REMOVE(&(e->SecondList), ptr_WS_element);
 
-					/*EDIT*/break;
-				}
-			}
+			env_page_ws_list_free_element(e, ptr_WS_element);
 		}
 	}
 	else
 	{
-		struct WorkingSetElement *wse;
-		LIST_FOREACH(wse, &(e->page_WS_list))
+		struct WorkingSetElement *wse = env_page_ws_list_find_element(e, virtual_address);
+		if (wse != NULL)
 		{
-			if(ROUNDDOWN(wse->virtual_address,PAGE_SIZE) == ROUNDDOWN(virtual_address,PAGE_SIZE))
-			{
+			//a buffered page keeps its frame till it's written back (see writeback_enqueue())
+			if ((pt_get_page_permissions(e->env_page_directory, wse->virtual_address) & PERM_BUFFERED) == 0)
 				unmap_frame(e->env_page_directory, wse->virtual_address);
 
-				if (e->page_last_WS_element == wse)
-				{
-					e->page_last_WS_element = LIST_NEXT(wse);
-				}
-				LIST_REMOVE(&(e->page_WS_list), wse);
+			if (e->page_last_WS_element == wse)
+			{
+				e->page_last_WS_element = LIST_NEXT(wse);
+			}
+			LIST_REMOVE(&(e->page_WS_list), wse);
 
-				kfree(wse);
+			env_page_ws_list_free_element(e, wse);
+		}
+	}
+}
+//invalidate all the WS pages in [virtual_address, virtual_address + size):
+//	one hash lookup per page, or a single walk of the WS if it's smaller than the range
+void env_page_ws_invalidate_range(struct Env* e, uint32 virtual_address, uint32 size)
+{
+	uint32 start_va = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	uint32 end_va = ROUNDUP(virtual_address + size, PAGE_SIZE);
+	uint32 num_of_pages = (end_va - start_va) / PAGE_SIZE;
 
-				break;
-			}
+	if (!isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX) && num_of_pages > LIST_SIZE(&(e->page_WS_list)))
+	{
+		struct WorkingSetElement *wse, *next_wse;
+		for (wse = LIST_FIRST(&(e->page_WS_list)); wse != NULL; wse = next_wse)
+		{
+			next_wse = LIST_NEXT(wse);
+			if (wse->virtual_address >= start_va && wse->virtual_address < end_va)
+				env_page_ws_invalidate(e, wse->virtual_address);
 		}
+		return;
+	}
+	for (uint32 va = start_va; va < end_va; va += PAGE_SIZE)
+	{
+		if (env_page_ws_list_find_element(e, va) != NULL)
+			env_page_ws_invalidate(e, va);
+	}
+}
+//retarget the WS element of the page at src_va (if any) to dst_va
+inline void env_page_ws_move(struct Env* e, uint32 src_va, uint32 dst_va)
+{
+	struct WorkingSetElement *wse = env_page_ws_list_find_element(e, src_va);
+	if (wse != NULL)
+	{
+		//re-chain it in the bucket of its new page & re-cache its PTE in its ring slot
+		env_page_ws_hash_remove(e, wse);
+		wse->virtual_address = ROUNDDOWN(dst_va, PAGE_SIZE);
+		env_page_ws_hash_insert(e, wse);
+		if (env_page_ws_ring_has(e, wse))
+			env_page_ws_ring_set(e, wse->ring_index, wse);
 	}
 }
+
 void env_page_ws_print(struct Env *e)
 {
 	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
@@ -169,6 +399,19 @@ inline void env_page_ws_invalidate(struct Env* e, uint32 virtual_address)
 	}
 }
 
+inline void env_page_ws_move(struct Env* e, uint32 src_va, uint32 dst_va)
+{
+	int i=0;
+	for(;i<e->page_WS_max_size; i++)
+	{
+		if(e->ptr_pageWorkingSet[i].empty == 0 && ROUNDDOWN(e->ptr_pageWorkingSet[i].virtual_address,PAGE_SIZE) == ROUNDDOWN(src_va,PAGE_SIZE))
+		{
+			e->ptr_pageWorkingSet[i].virtual_address = ROUNDDOWN(dst_va,PAGE_SIZE);
+			break;
+		}
+	}
+}
+
 inline void env_page_ws_set_entry(struct Env* e, uint32 entry_index, uint32 virtual_address)
 {
 	assert(entry_index >= 0 && entry_index < e->page_WS_max_size);
@@ -356,8 +599,141 @@ inline uint32 env_table_ws_is_entry_empty(struct Env* e, uint32 entry_index)
 ///=================================================================================================
 ///=================================================================================================
 
-// Change WS Sizes For PRIORITY  =========================================================
+#if USE_KHEAP
+// Change WS Sizes For PRIORITY & PFF =========================================================
+//Resize the WS of the page_WS_list algorithms (the LRU lists keep their sizes)
+
+//Evict the page of the given WS element (a dirty one is written back by the daemon), remove it from its list & free it
+static void env_page_ws_evict_element(struct Env* e, struct WS_List* list, struct WorkingSetElement* wse)
+{
+	uint32 va = wse->virtual_address;
+	uint32 perms = pt_get_page_permissions(e->env_page_directory, va);
+	fault_around_account(e, va, perms);
+	if (perms & PERM_MODIFIED)
+	{
+		uint32 *ptr_page_table = NULL;
+		writeback_enqueue(e, va, get_frame_info(e->env_page_directory, va, &ptr_page_table));
+	}
+	else
+	{
+		unmap_frame(e->env_page_directory, va);
+	}
+	LIST_REMOVE(list, wse);
+	env_page_ws_list_free_element(e, wse);
+}
+
+//Set the max WS size (& re-size the ring, if any). A full WS keeps its clock hand at page_last_WS_element
+static void env_page_ws_set_max_size(struct Env* e, uint32 newSize)
+{
+	struct WS_List *wl = &(e->page_WS_list);
+	if (e->page_WS_ring != NULL && newSize != e->page_WS_max_size)
+	{
+		e->page_WS_ring = krealloc(e->page_WS_ring, newSize * sizeof(struct WSRingEntry));
+		if (e->page_WS_ring == NULL)
+		{
+			panic("NOT ENOUGH KERNEL HEAP SPACE");
+		}
+		//it's already cut to the new size (if smaller), otherwise it's rebuilt on the next sweep
+		if (e->page_WS_ring_size > newSize)
+			e->page_WS_ring_size = 0;
+	}
+	e->page_WS_max_size = newSize;
+	if (LIST_SIZE(wl) >= newSize && e->page_last_WS_element == NULL)
+		e->page_last_WS_element = LIST_FIRST(wl);
+	if (e->page_last_WS_element != NULL)
+		e->prp = 1;
+}
 
+//Cut the WS pages from "from" (e.g. the clock hand) on till it has newSize pages:
+//	[1] the pages not used since the last sweep, [2] then (if cutUsed) the used ones in the list order.
+//	The hand is left at the page after the last cut one.
+//Returns the WS size after cutting
+static uint32 env_page_ws_cut(struct Env* e, struct WorkingSetElement* from, uint32 newSize, int cutUsed)
+{
+	struct WS_List *wl = &(e->page_WS_list);
+	struct WorkingSetElement *wse = (from != NULL) ? from : LIST_FIRST(wl);
+	int cut = 0;
+	for (int pass = 0; pass < (cutUsed ? 2 : 1) && LIST_SIZE(wl) > newSize; pass++)
+	{
+		uint32 n = LIST_SIZE(wl);
+		for (uint32 i = 0; i < n && LIST_SIZE(wl) > newSize; i++)
+		{
+			struct WorkingSetElement *next = LIST_NEXT(wse) ? LIST_NEXT(wse) : LIST_FIRST(wl);
+			if (pass == 1 || (pt_get_page_permissions(e->env_page_directory, wse->virtual_address) & PERM_USED) == 0)
+			{
+				env_page_ws_evict_element(e, wl, wse);
+				cut = 1;
+			}
+			wse = next;
+		}
+	}
+	if (cut)
+		e->page_last_WS_element = wse;
+	return LIST_SIZE(wl);
+}
+
+//Cut the WS down to newSize pages from newWS on (unused pages first) & paste the rest as is with the hand after the cut ones
+void cut_paste_WS(struct WorkingSetElement* newWS, int newSize, struct Env* e)
+{
+	if (newSize < 1)
+		newSize = 1;
+	env_page_ws_cut(e, newWS, newSize, 1);
+	env_page_ws_set_max_size(e, newSize);
+}
+
+//Double the max WS size, bounded by the free frames (WS_RESIZE_FREE_FRAMES_RESERVE of them are left for the others).
+//	isOneTimeOnly: only if it's not already enlarged beyond its initial size
+void double_WS_Size(struct Env* e, int isOneTimeOnly)
+{
+	if (isOneTimeOnly && e->page_WS_max_size > e->page_WS_init_size)
+		return;
+	struct freeFramesCounters counters = calculate_available_frames();
+	uint32 numOfFreeFrames = counters.freeBuffered + counters.freeNotBuffered;
+	if (numOfFreeFrames <= WS_RESIZE_FREE_FRAMES_RESERVE)
+		return;
+	uint32 extra = MIN(e->page_WS_max_size, numOfFreeFrames - WS_RESIZE_FREE_FRAMES_RESERVE);
+	env_page_ws_set_max_size(e, e->page_WS_max_size + extra);
+}
+
+//Halve the max WS size (not below WS_RESIZE_MIN_SIZE).
+//	isImmidiate: cut the extra pages now, otherwise only the unused ones are cut & the WS is shrunk as far as they allow
+void half_WS_Size(struct Env* e, int isImmidiate)
+{
+	uint32 newSize = MAX(e->page_WS_max_size / 2, WS_RESIZE_MIN_SIZE);
+	if (newSize >= e->page_WS_max_size)
+		return;
+	uint32 size = env_page_ws_cut(e, e->page_last_WS_element, newSize, isImmidiate);
+	env_page_ws_set_max_size(e, MAX(newSize, size));
+}
+
+//Take numOfPages frames from the WS of an env that is NOT running (e.g. by the memory reclaimer):
+//	- LRU lists: from the tail of the SecondList, then from the tail of the ActiveList
+//	- others: the unused pages from its clock hand on first (at least one page is kept), its max size is not changed
+//Returns the number of evicted pages
+uint32 env_page_ws_reclaim(struct Env* e, uint32 numOfPages)
+{
+	uint32 numOfEvicted = 0;
+	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+	{
+		struct WS_List *lruLists[2] = {&(e->SecondList), &(e->ActiveList)};
+		for (int l = 0; l < 2; l++)
+		{
+			while (numOfEvicted < numOfPages && !LIST_EMPTY(lruLists[l]))
+			{
+				env_page_ws_evict_element(e, lruLists[l], LIST_LAST(lruLists[l]));
+				numOfEvicted++;
+			}
+		}
+		return numOfEvicted;
+	}
+	uint32 size = LIST_SIZE(&(e->page_WS_list));
+	if (size <= 1)
+		return 0;
+	uint32 newSize = (size > numOfPages) ? MAX(size - numOfPages, 1) : 1;
+	return size - env_page_ws_cut(e, e->page_last_WS_element, newSize, 1);
+}
+
+#else
 void cut_paste_WS(struct WorkingSetElement* newWS, int newSize, struct Env* e)
 {
 	panic("not handled yet");
@@ -373,4 +749,40 @@ void half_WS_Size(struct Env* e, int isImmidiate)
 	panic("not handled yet");
 }
 
+uint32 env_page_ws_reclaim(struct Env* e, uint32 numOfPages)
+{
+	return 0;
+}
+#endif
+
+// PFF (Dynamic Local Replacement) =========================================================
+//Each window of the env ticks, its # page faults in the window decides its max WS size:
+//	above the high threshold: doubled (bounded by the free frames), below the low one: halved (unused pages only)
+void setPFFParameters(uint32 window, uint32 lowThreshold, uint32 highThreshold)
+{
+	_PFFWindow = MAX(window, 1);
+	_PFFLowThreshold = lowThreshold;
+	_PFFHighThreshold = MAX(highThreshold, lowThreshold);
+}
+uint32 getPFFWindow() { return _PFFWindow; }
+uint32 getPFFLowThreshold() { return _PFFLowThreshold; }
+uint32 getPFFHighThreshold() { return _PFFHighThreshold; }
+
+//Called on each clock tick of the running env
+void env_page_ws_pff_update(struct Env* e)
+{
+	if (e->page_WS_max_size == 0)
+		return;
+	if (++(e->pffTicks) < _PFFWindow)
+		return;
+
+	uint32 numOfFaults = e->pageFaultsCounter - e->pffLastFaultsCounter;
+	e->pffTicks = 0;
+	e->pffLastFaultsCounter = e->pageFaultsCounter;
+	if (numOfFaults > _PFFHighThreshold)
+		double_WS_Size(e, 0);
+	else if (numOfFaults < _PFFLowThreshold)
+		half_WS_Size(e, 0);
+}
+
 
@@ -10,13 +10,33 @@
 
 #include <inc/environment_definitions.h>
 
+/*2025*/
+uint32 _EnableWSRing ;
+
 // Page WS helper functions ===================================================
 void env_page_ws_print(struct Env *curenv);
 inline void env_page_ws_invalidate(struct Env* e, uint32 virtual_address);
+inline void env_page_ws_move(struct Env* e, uint32 src_va, uint32 dst_va);
 
 #if USE_KHEAP
 /*2024*/
 inline struct WorkingSetElement* env_page_ws_list_create_element(struct Env* e, uint32 virtual_address);
+/*2025*/
+//Num of buckets of the per-env page_WS_hash (power of 2, one page of pointers)
+#define PAGE_WS_HASH_SIZE (PAGE_SIZE / sizeof(struct WorkingSetElement*))
+void env_page_ws_hash_init(struct Env* e);
+void env_page_ws_hash_free(struct Env* e);
+inline struct WorkingSetElement* env_page_ws_list_find_element(struct Env* e, uint32 virtual_address);
+inline void env_page_ws_list_free_element(struct Env* e, struct WorkingSetElement* wse);
+void env_page_ws_invalidate_range(struct Env* e, uint32 virtual_address, uint32 size);
+
+//Array CLOCK (selected at env_create() time)
+void enableWSRing(uint32 enableIt);
+uint8 isWSRingEnabled();
+void env_page_ws_ring_init(struct Env* e);
+void env_page_ws_ring_free(struct Env* e);
+int env_page_ws_ring_sync(struct Env* e);
+inline void env_page_ws_replace_element(struct Env* e, struct WorkingSetElement* victim, struct WorkingSetElement* new_wse);
 #else
 inline uint32 env_page_ws_get_size(struct Env *e);
 inline void env_page_ws_set_entry(struct Env* e, uint32 entry_index, uint32 virtual_address);
@@ -38,9 +58,27 @@ inline uint32 env_table_ws_get_time_stamp(struct Env* e, uint32 entry_index);
 inline uint32 env_table_ws_is_entry_empty(struct Env* e, uint32 entry_index);
 void env_table_ws_print(struct Env *curenv);
 
-// Change WS Sizes For PRIORITY  =========================================================
+// Change WS Sizes For PRIORITY & PFF =========================================================
+/*2025*/
+#define WS_RESIZE_MIN_SIZE				4	//a shrunk WS keeps at least these pages
+#define WS_RESIZE_FREE_FRAMES_RESERVE	64	//free frames that an enlarged WS leaves for the others
 void cut_paste_WS(struct WorkingSetElement* newWS, int newSize, struct Env* e);
 void double_WS_Size(struct Env* e, int isOneTimeOnly);
 void half_WS_Size(struct Env* e, int isImmidiate);
+/*2025*/ uint32 env_page_ws_reclaim(struct Env* e, uint32 numOfPages);
+
+/*2025*/
+// PFF (dynamic local replacement): the WS size follows the env page fault frequency =========
+uint32 _PFFWindow ;				//# ticks of the env in each window
+uint32 _PFFLowThreshold ;		//# faults in a window below which the WS is halved
+uint32 _PFFHighThreshold ;		//# faults in a window above which the WS is doubled
+#define PFF_DEFAULT_WINDOW			10
+#define PFF_DEFAULT_LOW_THRESHOLD	1
+#define PFF_DEFAULT_HIGH_THRESHOLD	8
+void setPFFParameters(uint32 window, uint32 lowThreshold, uint32 highThreshold);
+uint32 getPFFWindow();
+uint32 getPFFLowThreshold();
+uint32 getPFFHighThreshold();
+void env_page_ws_pff_update(struct Env* e);
 
 #endif /* KERN_MEM_WORKING_SET_MANAGER_H_ */
@@ -0,0 +1,331 @@
+/*
+ * writeback.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "writeback.h"
+#include <kern/proc/user_environment.h>
+#include <kern/disk/pagefile_manager.h>
+#include <kern/cpu/sched.h>
+#include <kern/trap/fault_handler.h>
+#include <kern/conc/sleeplock.h>
+#include "memory_manager.h"
+#include "reclaimer.h"
+
+static void writeback_daemon(void);
+
+//The bounce page of the disk writes: each page is copied to it under the mfllock & written without it.
+//	One flush at a time owns it (see writeback_flush())
+static struct sleeplock writeback_lock;
+static uint8 writeback_bounce[PAGE_SIZE];
+
+//=====================================
+// [1] START THE WRITE-BACK DAEMON:
+//=====================================
+void writeback_init()
+{
+	init_channel(&WriteBackChannel, "write-back");
+	init_sleeplock(&writeback_lock, "write-back");
+	WriteBackDaemon = env_create_kernel("writeback", writeback_daemon);
+	if (WriteBackDaemon == NULL)
+		panic("writeback_init: can't create the write-back daemon");
+
+	//It starts BLOCKED on its channel till the first dirty frame is enqueued
+	acquire_kspinlock(&ProcessQueues.qlock);
+	{
+		WriteBackDaemon->env_status = ENV_BLOCKED;
+		enqueue(&(WriteBackChannel.queue), WriteBackDaemon);
+	}
+	release_kspinlock(&ProcessQueues.qlock);
+}
+
+//Is there a work for the daemon? with the modified buffer enabled, it waits till the buffer is full
+//	(unless someone is blocked in allocate_frame() for a free frame)
+static int writeback_pending()
+{
+	uint32 numOfModified = LIST_SIZE(&MemFrameLists.modified_frame_list);
+	if (isBufferingEnabled() && isModifiedBufferEnabled() && queue_size(&(FreeFramesChannel.queue)) == 0)
+		return numOfModified > 0 && numOfModified >= getModifiedBufferLength();
+	return numOfModified > 0;
+}
+
+//=====================================
+// [2] ENQUEUE A DIRTY VICTIM:
+//=====================================
+//Called by the fault handler INSTEAD of writing the dirty victim to the page file & unmapping it.
+//	The frame stays attached to its page (PRESENT = 0, BUFFERED = 1) till the daemon writes it back.
+void writeback_enqueue(struct Env* e, uint32 virtual_address, struct FrameInfo* ptr_frame_info)
+{
+	int wakeup = 0;
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	{
+		ptr_frame_info->proc = e;
+		ptr_frame_info->va = virtual_address;
+		ptr_frame_info->isBuffered = 1;
+		pt_set_page_permissions(e->env_page_directory, virtual_address, PERM_BUFFERED, PERM_PRESENT);
+		LIST_INSERT_TAIL(&MemFrameLists.modified_frame_list, ptr_frame_info);
+		wakeup = writeback_pending();
+	}
+	release_kspinlock(&MemFrameLists.mfllock);
+
+	if (wakeup)
+		wakeup_one(&WriteBackChannel);
+}
+
+//The list that holds the given buffered frame: dirty ones are in the modified list till they're written back
+//	(or in the write-back list while they're being written)
+static struct FrameInfo_List* buffered_frame_list(struct FrameInfo* ptr_frame_info)
+{
+	if (ptr_frame_info->isWritingBack)
+		return &MemFrameLists.writeback_frame_list;
+	uint32 perms = pt_get_page_permissions(ptr_frame_info->proc->env_page_directory, ptr_frame_info->va);
+	if (perms & PERM_MODIFIED)
+		return &MemFrameLists.modified_frame_list;
+	return &MemFrameLists.free_frame_list;
+}
+
+//Detach the given buffered frame from its page (PRESENT = BUFFERED = 0) keeping the other marks of the page (e.g. PERM_UHPAGE).
+//	It should be already removed from its list & the mfllock should be held.
+void unbuffer_frame(struct FrameInfo* ptr_frame_info)
+{
+	uint32 *ptr_page_table = NULL;
+	get_page_table(ptr_frame_info->proc->env_page_directory, ptr_frame_info->va, &ptr_page_table);
+	if (ptr_page_table != NULL)
+	{
+		ptr_page_table[PTX(ptr_frame_info->va)] &= (PERM_AVAILABLE & ~PERM_BUFFERED);
+		tlb_invalidate(ptr_frame_info->proc->env_page_directory, (void*)ptr_frame_info->va);
+	}
+	ptr_frame_info->isBuffered = 0;
+	ptr_frame_info->isWritingBack = 0;
+}
+
+//Copy the given buffered frame to "copy" (clears its MODIFIED) & return its dfn to be written later.
+//	It should be already removed from the modified list & the mfllock should be held.
+static uint32 writeback_copy_frame(struct FrameInfo* ptr_frame_info, void* copy)
+{
+	struct Env* e = ptr_frame_info->proc;
+
+	//the page is accessed through its VA, so switch to the env's directory (if not already)
+	uint32 cur_phys_pgdir = rcr3();
+	if (cur_phys_pgdir != e->env_cr3)
+		lcr3(e->env_cr3);
+
+	uint32 dfn = pf_copy_env_page(e, ptr_frame_info->va, copy);
+
+	if (cur_phys_pgdir != e->env_cr3)
+		lcr3(cur_phys_pgdir);
+	return dfn;
+}
+
+//The given frame is written back: keep it as a clean buffered frame at the tail of the free list
+//	(with buffering), otherwise free it. The mfllock should be held
+static void writeback_done(struct FrameInfo* ptr_frame_info)
+{
+	if (isBufferingEnabled())
+	{
+		LIST_INSERT_TAIL(&MemFrameLists.free_frame_list, ptr_frame_info);
+	}
+	else
+	{
+		unbuffer_frame(ptr_frame_info);
+		decrement_references(ptr_frame_info);
+	}
+}
+
+//Write the given frame of the write-back list through the bounce page without holding the mfllock
+//	(which should be held on entry & exit, with the writeback_lock)
+static void writeback_frame_unlocked(struct FrameInfo* ptr_frame_info)
+{
+	uint32 dfn = writeback_copy_frame(ptr_frame_info, writeback_bounce);
+	release_kspinlock(&MemFrameLists.mfllock);
+	{
+		write_disk_page(dfn, writeback_bounce);
+	}
+	acquire_kspinlock(&MemFrameLists.mfllock);
+
+	//still there: nobody took it while it's being written
+	if (ptr_frame_info->isWritingBack)
+	{
+		LIST_REMOVE(&MemFrameLists.writeback_frame_list, ptr_frame_info);
+		ptr_frame_info->isWritingBack = 0;
+		writeback_done(ptr_frame_info);
+	}
+}
+
+//=====================================
+// [3] FLUSH THE MODIFIED LIST:
+//=====================================
+//Write back at most "max_num_of_pages" frames from the head of the modified list,
+//	in batches of WRITEBACK_BATCH_SIZE, each written in ascending order of their disk frames.
+//	Each batch is detached from the list first, so a nested allocate_frame() can't pick it again.
+//	With buffering, the written frames stay attached to their pages as clean buffered frames
+//	at the tail of the free list, otherwise they're freed.
+//	The mfllock should NOT be held by the caller: it's released while writing each page, the page is copied
+//	to the bounce page first & its frame waits in the write-back list meanwhile.
+//	A frame that's taken from there in between (e.g. soft fault or freed page) is left to whoever took it.
+//Returns the number of written frames
+uint32 writeback_flush(uint32 max_num_of_pages)
+{
+	struct FrameInfo* batch[WRITEBACK_BATCH_SIZE];
+	uint32 dfns[WRITEBACK_BATCH_SIZE];
+	uint32 total = 0;
+
+	assert(!holding_kspinlock(&MemFrameLists.mfllock));
+	acquire_sleeplock(&writeback_lock);
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	while (total < max_num_of_pages && !LIST_EMPTY(&MemFrameLists.modified_frame_list))
+	{
+		//[1] detach the next batch & sort it by the disk frame numbers (insertion sort)
+		uint32 n = 0;
+		for (; n < WRITEBACK_BATCH_SIZE && total + n < max_num_of_pages; n++)
+		{
+			struct FrameInfo* ptr_fi = LIST_FIRST(&MemFrameLists.modified_frame_list);
+			if (ptr_fi == NULL)
+				break;
+			LIST_REMOVE(&MemFrameLists.modified_frame_list, ptr_fi);
+			ptr_fi->isWritingBack = 1;
+			LIST_INSERT_TAIL(&MemFrameLists.writeback_frame_list, ptr_fi);
+
+			uint32 dfn = pf_get_env_page_dfn(ptr_fi->proc, ptr_fi->va);
+			int j = n;
+			for (; j > 0 && dfns[j-1] > dfn; j--)
+			{
+				batch[j] = batch[j-1];
+				dfns[j] = dfns[j-1];
+			}
+			batch[j] = ptr_fi;
+			dfns[j] = dfn;
+		}
+		//[2] write them back
+		for (uint32 i = 0; i < n; i++)
+		{
+			//unless it's already taken from the write-back list while the lock was released for a previous page
+			if (batch[i]->isWritingBack)
+			{
+				writeback_frame_unlocked(batch[i]);
+			}
+		}
+		total += n;
+	}
+	release_kspinlock(&MemFrameLists.mfllock);
+	release_sleeplock(&writeback_lock);
+	return total;
+}
+
+//=====================================
+// [4] DROP A BUFFERED PAGE:
+//=====================================
+//Drop the buffered frame of the page at virtual_address WITHOUT writing it (e.g. the page itself is freed)
+void writeback_cancel(struct Env* e, uint32 virtual_address)
+{
+	uint32 *ptr_page_table = NULL;
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	{
+		struct FrameInfo* ptr_fi = get_frame_info(e->env_page_directory, virtual_address, &ptr_page_table);
+		if (ptr_fi != NULL && ptr_fi->isBuffered)
+		{
+			LIST_REMOVE(buffered_frame_list(ptr_fi), ptr_fi);
+			unbuffer_frame(ptr_fi);
+			decrement_references(ptr_fi);
+		}
+	}
+	release_kspinlock(&MemFrameLists.mfllock);
+}
+
+//=====================================
+// [5] PAGE BUFFERING:
+//=====================================
+//Replace the page at virtual_address WITHOUT any disk I/O: its frame stays attached to it (PRESENT = 0, BUFFERED = 1)
+//	- if dirty: at the tail of the modified list, till the daemon writes it back
+//	- if clean: at the tail of the free list, till it's re-allocated (allocate_frame() takes the head)
+void buffer_victim_frame(struct Env* e, uint32 virtual_address, struct FrameInfo* ptr_frame_info)
+{
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	if (pt_get_page_permissions(e->env_page_directory, virtual_address) & PERM_MODIFIED)
+	{
+		writeback_enqueue(e, virtual_address, ptr_frame_info);
+		return;
+	}
+	//a clean page on a frame that's shared with others (e.g. the zero frame or a program cached frame)
+	//	has nothing to keep & its frame can't be re-allocated: just drop it
+	if (ptr_frame_info->references > 1)
+	{
+		unmap_frame(e->env_page_directory, virtual_address);
+		return;
+	}
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	{
+		ptr_frame_info->proc = e;
+		ptr_frame_info->va = virtual_address;
+		ptr_frame_info->isBuffered = 1;
+		pt_set_page_permissions(e->env_page_directory, virtual_address, PERM_BUFFERED, PERM_PRESENT);
+		LIST_INSERT_TAIL(&MemFrameLists.free_frame_list, ptr_frame_info);
+	}
+	release_kspinlock(&MemFrameLists.mfllock);
+}
+
+//Soft fault: take back the frame of the page at virtual_address from the free/modified list (if still buffered)
+//	and map it again with its content (and MODIFIED) as is. One that's being written back is kept MODIFIED,
+//	as its write may not be done yet.
+//Returns the reclaimed frame, or NULL if the page has no buffered frame
+struct FrameInfo* reclaim_buffered_frame(struct Env* e, uint32 virtual_address)
+{
+	uint32 *ptr_page_table = NULL;
+	struct FrameInfo* ptr_fi = NULL;
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	{
+		ptr_fi = get_frame_info(e->env_page_directory, virtual_address, &ptr_page_table);
+		if (ptr_fi != NULL && ptr_fi->isBuffered)
+		{
+			uint32 wasWritingBack = ptr_fi->isWritingBack;
+			LIST_REMOVE(buffered_frame_list(ptr_fi), ptr_fi);
+			ptr_fi->isBuffered = 0;
+			ptr_fi->isWritingBack = 0;
+			ptr_fi->proc = NULL;
+			pt_set_page_permissions(e->env_page_directory, virtual_address, PERM_PRESENT | PERM_USED | (wasWritingBack ? PERM_MODIFIED : 0), PERM_BUFFERED);
+		}
+		else
+		{
+			ptr_fi = NULL;
+		}
+	}
+	release_kspinlock(&MemFrameLists.mfllock);
+	return ptr_fi;
+}
+
+//=====================================
+// [6] THE DAEMON:
+//=====================================
+//Entered from the scheduler while holding the ProcessQueues.qlock (see env_create_kernel())
+static void writeback_daemon(void)
+{
+	release_kspinlock(&ProcessQueues.qlock);
+
+	acquire_kspinlock(&MemFrameLists.mfllock);
+	while (1)
+	{
+		while (!writeback_pending())
+		{
+			sleep(&WriteBackChannel, &MemFrameLists.mfllock);
+		}
+		//the modified buffer is flushed in one go once it's full
+		uint32 numOfPages = WRITEBACK_BATCH_SIZE;
+		if (isBufferingEnabled() && isModifiedBufferEnabled())
+			numOfPages = LIST_SIZE(&MemFrameLists.modified_frame_list);
+
+		//flushed without holding the mfllock during the disk writes, then give-up the CPU between batches
+		release_kspinlock(&MemFrameLists.mfllock);
+		uint32 numOfWritten = writeback_flush(numOfPages);
+		acquire_kspinlock(&MemFrameLists.mfllock);
+		//the written frames are free (or clean buffered) now
+		if (numOfWritten > 0 && !LIST_EMPTY(&MemFrameLists.free_frame_list))
+			wakeup_all(&FreeFramesChannel);
+		release_kspinlock(&MemFrameLists.mfllock);
+		yield();
+		acquire_kspinlock(&MemFrameLists.mfllock);
+	}
+}
@@ -0,0 +1,34 @@
+/*
+ * writeback.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_MEM_WRITEBACK_H_
+#define KERN_MEM_WRITEBACK_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/environment_definitions.h>
+#include <kern/conc/channel.h>
+
+//Max number of modified frames written by the daemon before it gives up the CPU
+#define WRITEBACK_BATCH_SIZE 32
+
+struct Env* WriteBackDaemon;		//kernel-only env that writes the modified frames back to the page file
+struct Channel WriteBackChannel;	//the daemon sleeps on it while the modified list is empty
+
+void writeback_init();
+void writeback_enqueue(struct Env* e, uint32 virtual_address, struct FrameInfo* ptr_frame_info);
+uint32 writeback_flush(uint32 max_num_of_pages);
+void writeback_cancel(struct Env* e, uint32 virtual_address);
+
+//Page buffering ==============================================================
+void buffer_victim_frame(struct Env* e, uint32 virtual_address, struct FrameInfo* ptr_frame_info);
+struct FrameInfo* reclaim_buffered_frame(struct Env* e, uint32 virtual_address);
+void unbuffer_frame(struct FrameInfo* ptr_frame_info);
+
+#endif /* KERN_MEM_WRITEBACK_H_ */
@@ -0,0 +1,250 @@
+/*
+ * program_cache.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "program_cache.h"
+#include <inc/string.h>
+#include <inc/assert.h>
+#include <kern/proc/user_environment.h>
+#include <kern/mem/kheap.h>
+#include <kern/mem/memory_manager.h>
+
+void enableProgramCache(uint32 enableIt){_EnableProgramCache = enableIt;}
+uint8 isProgramCacheEnabled(){  return _EnableProgramCache ; }
+
+//=====================================
+// [1] CREATE THE CACHE OF A PROGRAM:
+//=====================================
+//List the pages of the loadable segments in "pages" sorted by their va (a page shared by two segments is listed once).
+//	If "pages" is NULL, just count them (including the shared ones)
+static uint32 program_cache_list_pages(uint8* ptr_program_start, struct ProgramCachedPage* pages)
+{
+	uint32 n = 0;
+	struct ProgramSegment* seg = NULL;
+	PROGRAM_SEGMENT_FOREACH(seg, ptr_program_start)
+	{
+		uint32 start = ROUNDDOWN((uint32)seg->virtual_address, PAGE_SIZE);
+		uint32 end = ROUNDUP((uint32)seg->virtual_address + seg->size_in_memory, PAGE_SIZE);
+		for (uint32 va = start; va < end; va += PAGE_SIZE)
+		{
+			if (pages == NULL)
+			{
+				n++;
+				continue;
+			}
+			int j = n;
+			while (j > 0 && pages[j-1].va > va)
+				j--;
+			if (j > 0 && pages[j-1].va == va)
+				continue;
+			memmove(&pages[j+1], &pages[j], (n - j) * sizeof(struct ProgramCachedPage));
+			pages[j].va = va;
+			pages[j].frame = NULL;
+			n++;
+		}
+	}
+	return n;
+}
+
+//Get the frame cache of the given program (created empty on its first env): its frames are built on demand
+struct ProgramFrameCache* program_cache_get(struct UserProgramInfo* ptr_program_info)
+{
+	if (ptr_program_info->frameCache != NULL)
+		return ptr_program_info->frameCache;
+
+	struct ProgramFrameCache* cache = kmalloc(sizeof(struct ProgramFrameCache));
+	if (cache == NULL)
+		panic("program_cache_get(): NOT ENOUGH KERNEL HEAP SPACE");
+	cache->prog = ptr_program_info;
+	cache->numOfFrames = 0;
+	cache->pages = NULL;
+	cache->numOfPages = program_cache_list_pages(ptr_program_info->ptr_start, NULL);
+	if (cache->numOfPages > 0)
+	{
+		cache->pages = kmalloc(cache->numOfPages * sizeof(struct ProgramCachedPage));
+		if (cache->pages == NULL)
+			panic("program_cache_get(): NOT ENOUGH KERNEL HEAP SPACE");
+		cache->numOfPages = program_cache_list_pages(ptr_program_info->ptr_start, cache->pages);
+	}
+	ptr_program_info->frameCache = cache;
+	return cache;
+}
+
+//Binary search for the page at virtual_address (NULL if it's not a page of the program)
+static struct ProgramCachedPage* program_cache_find(struct ProgramFrameCache* cache, uint32 virtual_address)
+{
+	int lo = 0, hi = (int)cache->numOfPages - 1;
+	while (lo <= hi)
+	{
+		int mid = (lo + hi) / 2;
+		if (cache->pages[mid].va == virtual_address)
+			return &cache->pages[mid];
+		if (cache->pages[mid].va < virtual_address)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return NULL;
+}
+
+//Write the pristine content of the page at virtual_address from the program image:
+//	its bytes in the file of each segment, zeros elsewhere.
+//	The page should be mapped writable on the current directory
+static void program_cache_fill_page(uint8* ptr_program_start, uint32 virtual_address)
+{
+	memset((void*)virtual_address, 0, PAGE_SIZE);
+	struct ProgramSegment* seg = NULL;
+	PROGRAM_SEGMENT_FOREACH(seg, ptr_program_start)
+	{
+		uint32 seg_va = (uint32)seg->virtual_address;
+		uint32 start = MAX(seg_va, virtual_address);
+		uint32 end = MIN(seg_va + seg->size_in_file, virtual_address + PAGE_SIZE);
+		if (start < end)
+			memcpy((void*)start, seg->ptr_start + (start - seg_va), end - start);
+	}
+}
+
+//=====================================
+// [2] MAP A PAGE FROM THE CACHE:
+//=====================================
+//Map the page at virtual_address of the given env (on the current directory) read-only on its cached frame,
+//	building the frame first if it's not cached yet.
+//Returns 0 if it's not a page of its program
+int program_cache_map_page(struct Env* e, uint32 virtual_address)
+{
+	struct ProgramFrameCache* cache = e->progCache;
+	if (cache == NULL)
+		return 0;
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	struct ProgramCachedPage* page = program_cache_find(cache, virtual_address);
+	if (page == NULL)
+		return 0;
+
+	if (page->frame == NULL)
+	{
+		struct FrameInfo* ptr_frame_info = NULL;
+		allocate_frame(&ptr_frame_info);
+		map_frame(e->env_page_directory, ptr_frame_info, virtual_address, PERM_USER | PERM_WRITEABLE);
+		program_cache_fill_page(cache->prog->ptr_start, virtual_address);
+		pt_set_page_permissions(e->env_page_directory, virtual_address, 0, PERM_WRITEABLE | PERM_MODIFIED);
+
+		//the cache holds its own reference, so the frame outlives the envs that map it
+		ptr_frame_info->references++;
+		page->frame = ptr_frame_info;
+		cache->numOfFrames++;
+	}
+	else
+	{
+		map_frame(e->env_page_directory, page->frame, virtual_address, PERM_USER);
+	}
+	e->nProgCachePages++;
+	return 1;
+}
+
+//A page that's not in the page file has just been mapped on a new frame by the fault handler.
+//	If it's a page of the env program:
+//	- read fault: map it on its cached frame instead, which frees the new frame
+//	- write fault: fill the new frame from the program image (it'd be copied on the write anyway)
+//Returns 0 if it's not a page of its program
+int program_cache_fresh_page(struct Env* e, uint32 virtual_address, uint8 isWrite)
+{
+	if (!program_cache_has_page(e, virtual_address))
+		return 0;
+	if (isWrite)
+	{
+		program_cache_fill_page(e->progCache->prog->ptr_start, ROUNDDOWN(virtual_address, PAGE_SIZE));
+		return 1;
+	}
+	return program_cache_map_page(e, virtual_address);
+}
+
+//Write on a page that's still mapped on its cached frame: give it its own copy (copy-on-write),
+//	its WS element is kept as is.
+//Returns 0 if it's not such a page
+int program_cache_cow(struct Env* e, uint32 virtual_address)
+{
+	if (e->progCache == NULL)
+		return 0;
+	virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	struct ProgramCachedPage* page = program_cache_find(e->progCache, virtual_address);
+	if (page == NULL || page->frame == NULL)
+		return 0;
+	uint32 perms = pt_get_page_permissions(e->env_page_directory, virtual_address);
+	if ((perms & PERM_PRESENT) == 0 || (perms & PERM_WRITEABLE))
+		return 0;
+	uint32 *ptr_page_table = NULL;
+	if (get_frame_info(e->env_page_directory, virtual_address, &ptr_page_table) != page->frame)
+		return 0;
+
+	struct FrameInfo *ptr_frame_info = NULL;
+	allocate_frame(&ptr_frame_info);
+	map_frame(e->env_page_directory, ptr_frame_info, virtual_address, PERM_USER | PERM_WRITEABLE | PERM_USED);
+	//the cached frame is never written, so its copy is just the pristine page
+	program_cache_fill_page(e->progCache->prog->ptr_start, virtual_address);
+	return 1;
+}
+
+//Is the given page a page of the program of the env (loaded from its frame cache)?
+uint8 program_cache_has_page(struct Env* e, uint32 virtual_address)
+{
+	if (e->progCache == NULL)
+		return 0;
+	return program_cache_find(e->progCache, ROUNDDOWN(virtual_address, PAGE_SIZE)) != NULL;
+}
+
+//=====================================
+// [3] FLUSH THE CACHES:
+//=====================================
+static int program_cache_in_use(struct ProgramFrameCache* cache)
+{
+	for (int i = 0; i < NENV; i++)
+	{
+		if (envs[i].env_status != ENV_FREE && envs[i].progCache == cache)
+			return 1;
+	}
+	return 0;
+}
+
+//Drop the cache of each program that has no env now, which frees its frames.
+//Returns the number of freed frames
+uint32 program_cache_flush()
+{
+	uint32 numOfFrames = 0;
+	for (int i = 0; i < NUM_USER_PROGS; i++)
+	{
+		struct ProgramFrameCache* cache = ptr_UserPrograms[i].frameCache;
+		if (cache == NULL || program_cache_in_use(cache))
+			continue;
+
+		acquire_kspinlock(&MemFrameLists.mfllock);
+		{
+			for (uint32 j = 0; j < cache->numOfPages; j++)
+			{
+				if (cache->pages[j].frame != NULL)
+					decrement_references(cache->pages[j].frame);
+			}
+		}
+		release_kspinlock(&MemFrameLists.mfllock);
+		numOfFrames += cache->numOfFrames;
+
+		if (cache->pages != NULL)
+			kfree(cache->pages);
+		kfree(cache);
+		ptr_UserPrograms[i].frameCache = NULL;
+	}
+	return numOfFrames;
+}
+
+void program_cache_print()
+{
+	cprintf("Program frame cache is %s for the new envs\n", isProgramCacheEnabled() ? "ENABLED" : "DISABLED");
+	for (int i = 0; i < NUM_USER_PROGS; i++)
+	{
+		struct ProgramFrameCache* cache = ptr_UserPrograms[i].frameCache;
+		if (cache != NULL)
+			cprintf("	%s: %d of %d pages cached\n", ptr_UserPrograms[i].name, cache->numOfFrames, cache->numOfPages);
+	}
+}
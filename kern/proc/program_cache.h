@@ -0,0 +1,47 @@
+/*
+ * program_cache.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_PROC_PROGRAM_CACHE_H_
+#define KERN_PROC_PROGRAM_CACHE_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/environment_definitions.h>
+#include <kern/proc/user_programs.h>
+
+//One page of the loadable segments of a program
+struct ProgramCachedPage
+{
+	uint32 va;
+	struct FrameInfo* frame;		//its pristine content (mapped read-only), NULL till it's first needed
+};
+
+//Frames of a program that are shared among all its envs: a page that's written gets its own copy (COW)
+struct ProgramFrameCache
+{
+	struct UserProgramInfo* prog;
+	uint32 numOfPages;
+	struct ProgramCachedPage* pages;	//sorted by va
+	uint32 numOfFrames;				//# built pages (each one holds a reference on its frame)
+};
+
+uint32 _EnableProgramCache ;		//load the new envs from the frame cache of their programs instead of the page file
+
+void enableProgramCache(uint32 enableIt);
+uint8 isProgramCacheEnabled();
+
+struct ProgramFrameCache* program_cache_get(struct UserProgramInfo* ptr_program_info);
+int program_cache_map_page(struct Env* e, uint32 virtual_address);
+int program_cache_fresh_page(struct Env* e, uint32 virtual_address, uint8 isWrite);
+int program_cache_cow(struct Env* e, uint32 virtual_address);
+uint8 program_cache_has_page(struct Env* e, uint32 virtual_address);
+uint32 program_cache_flush();
+void program_cache_print();
+
+#endif /* KERN_PROC_PROGRAM_CACHE_H_ */
@@ -11,14 +11,17 @@
 #include <kern/proc/user_environment.h>
 #include <kern/trap/trap.h>
 #include <kern/trap/fault_handler.h>
+#include <kern/trap/page_trace.h>
 #include <inc/queue.h>
 #include "../cmd/command_prompt.h"
 #include <kern/cpu/sched.h>
 #include <kern/cpu/cpu.h>
 #include "../disk/pagefile_manager.h"
 #include "../mem/kheap.h"
+#include "../mem/kmem_cache.h"
 #include "../mem/memory_manager.h"
 #include "../mem/shared_memory_manager.h"
+#include "program_cache.h"
 
 /******************************/
 /* DATA & DECLARATIONS */
@@ -28,37 +31,6 @@ struct Env* envs = NULL;		// All environments
 
 static struct Env_list env_free_list;	// Free Environment list
 
-//Contains information about each program segment (e.g. start address, size, virtual address...)
-//It will be used below in "env_create" to load each program segment into the user environment
-
-struct ProgramSegment {
-	uint8 *ptr_start;
-	uint32 size_in_file;
-	uint32 size_in_memory;
-	uint8 *virtual_address;
-
-	// for use only with PROGRAM_SEGMENT_FOREACH
-	uint32 segment_id;
-};
-
-// Used inside the PROGRAM_SEGMENT_FOREACH macro to get the first program segment
-// and then iterate on the next ones
-struct ProgramSegment* PROGRAM_SEGMENT_NEXT(struct ProgramSegment* seg,
-		uint8* ptr_program_start);
-struct ProgramSegment PROGRAM_SEGMENT_FIRST(uint8* ptr_program_start);
-
-// Used inside "env_create" function to get information about each program segment inside the user program
-#define	PROGRAM_SEGMENT_FOREACH(Seg, ptr_program_start)					\
-		struct ProgramSegment* first; \
-		struct ProgramSegment tmp; \
-		tmp = (PROGRAM_SEGMENT_FIRST(ptr_program_start));	 \
-		first = &tmp; \
-		if(first->segment_id == -1) first = NULL;\
-		Seg = first; \
-		for (;				\
-		Seg;							\
-		Seg = PROGRAM_SEGMENT_NEXT(Seg,ptr_program_start) )
-
 // Helper functions to be used below
 int allocate_environment(struct Env** e);
 void free_environment(struct Env* e);
@@ -74,6 +46,7 @@ void initialize_environment(struct Env* e, uint32* ptr_user_page_directory,
 		unsigned int phys_user_page_directory);
 void complete_environment_initialization(struct Env* e);
 void set_environment_entry_point(struct Env* e, uint8* ptr_program_start);
+void cleanup_buffers(struct Env* e);
 
 ///=========================================================
 
@@ -177,6 +150,7 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size,
 
 		//2016
 		e->page_WS_max_size = page_WS_size;
+		e->page_WS_init_size = page_WS_size;
 
 		//2020
 		if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX)) {
@@ -194,6 +168,13 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size,
 
 		initialize_environment(e, ptr_user_page_directory,
 				phys_user_page_directory);
+#if USE_KHEAP
+		/*2025*/
+		env_page_ws_ring_init(e);
+#endif
+		/*2025*/ //share the frames of its program with its other envs
+		if (isProgramCacheEnabled())
+			e->progCache = program_cache_get(ptr_user_program_info);
 
 		// We want to load the program into the user virtual space
 		// each program is constructed from one or more segments,
@@ -243,10 +224,19 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size,
 					cprintf("SEGMENT: remaining WS pages after allocation = %d",
 							remaining_ws_pages));
 
+			/*2025*/ //the pages of a cached program are not written to the page file:
+			//	they're faulted from its cache till they're written back (see program_cache_fresh_page())
+			if (e->progCache != NULL)
+				continue;
+
 			/// 7.2) temporary initialize 1st page in memory then writing it on page file
 			uint32 dataSrc_va = (uint32) seg->ptr_start;
 			uint32 seg_va = (uint32) seg->virtual_address;
 
+			/*2025*/ //lay out the segment on consecutive disk frames (if failed, each page gets its own frame below)
+			pf_reserve_env_pages(e, ROUNDDOWN(seg_va, PAGE_SIZE),
+					(ROUNDUP(seg_va + seg->size_in_memory, PAGE_SIZE) - ROUNDDOWN(seg_va, PAGE_SIZE)) / PAGE_SIZE);
+
 			uint32 start_first_page = ROUNDDOWN(seg_va, PAGE_SIZE);
 			uint32 end_first_page = ROUNDUP(seg_va, PAGE_SIZE);
 			uint32 offset_first_page = seg_va - start_first_page;
@@ -419,7 +409,11 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size,
 			}
 
 			//add this page to the page file
-			int success = pf_add_empty_env_page(e, (uint32) stackVa, 1);
+			//2025: with the lazy zero-fill, it's added on its first write-back only (see pf_update_env_page())
+			if (!isZeroFillEnabled())
+			{
+				int success = pf_add_empty_env_page(e, (uint32) stackVa, 1);
+			}
 			//if(success == 0) LOG_STATMENT(cprintf("STACK Page added to page file successfully\n"));
 		}
 
@@ -465,6 +459,35 @@ struct Env* env_create(char* user_program_name, unsigned int page_WS_size,
 	return e;
 }
 
+/*2025*/
+//=====================================
+// 1.5) CREATE NEW KERNEL-ONLY ENV:
+//=====================================
+// Allocates a new env with no user part that runs "entry" in the kernel on its own kernel stack.
+// "entry" is switched to by the scheduler while holding the ProcessQueues.qlock (as env_start()),
+// so it should release it first, and it should never return.
+struct Env* env_create_kernel(char* name, void (*entry)(void)) {
+	struct Env* e = NULL;
+	pushcli();
+	{
+		if (allocate_environment(&e) < 0) {
+			popcli();
+			return NULL;
+		}
+		strncpy(e->prog_name, name, PROGNAMELEN - 1);
+		e->page_WS_max_size = e->page_WS_init_size = 0;
+
+		uint32* ptr_page_directory = create_user_directory();
+		initialize_environment(e, ptr_page_directory,
+				kheap_physical_address((uint32) ptr_page_directory));
+
+		//start directly at the entry instead of env_start() then trapret()
+		e->context->eip = (uint32) entry;
+	}
+	popcli();
+	return e;
+}
+
 //===============================
 // 2) START EXECUTING THE PROCESS:
 //===============================
@@ -504,21 +527,37 @@ void env_free(struct Env *e) {
 	//Comment the following line
 	//panic("env_free() is not implemented yet...!!");
 	// [1] [NOT REQUIRED] [If BUFFERING is Enabled] Un-buffer any BUFFERED page belong to this environment from the free/modified lists
+	cleanup_buffers(e);
 	// [2] Free the pages in the PAGE working set from the main memory
 	struct WorkingSetElement *ele;
 	while (!LIST_EMPTY(&e->page_WS_list)) {
 		ele = LIST_FIRST(&e->page_WS_list);
 		unmap_frame(e->env_page_directory, ele->virtual_address);
 		LIST_REMOVE(&e->page_WS_list, ele);
-		kfree(ele);
+		env_page_ws_list_free_element(e, ele);
 
 	}
+	//     (with LRU lists, the WS pages are in the Active & Second lists instead)
+	struct WS_List *lruLists[2] = {&e->ActiveList, &e->SecondList};
+	for (int l = 0; l < 2; l++) {
+		while (!LIST_EMPTY(lruLists[l])) {
+			ele = LIST_FIRST(lruLists[l]);
+			unmap_frame(e->env_page_directory, ele->virtual_address);
+			LIST_REMOVE(lruLists[l], ele);
+			env_page_ws_list_free_element(e, ele);
+		}
+	}
 	// [3] free the PAGE working set itself from the main memory
-	if (e->page_last_WS_element != NULL) {
-		kfree(e->page_last_WS_element);
-		e->page_last_WS_element = NULL;
-
+	//     (page_last_WS_element points inside the list which is already freed)
+	e->page_last_WS_element = NULL;
+	env_page_ws_hash_free(e);
+	env_page_ws_ring_free(e);
+	page_trace_free(e);
+	if (e->referenceStream != NULL) {
+		kfree(e->referenceStream);
+		e->referenceStream = NULL;
 	}
+	e->referenceStreamSize = e->referenceStreamCapacity = 0;
 	// [4] free the USER HEAP block allocator [if exists]
 	for (uint32 i = 0; i < e->num_heap_blocks; i++) {
 		if (e->heap_blocks[i] != NULL) {
@@ -806,13 +845,21 @@ static int program_segment_alloc_map_copy_workingset(struct Env *e,
 		remaining_ws_pages = remaining_ws_pages < 9 ? remaining_ws_pages : 9;
 	/*==========================================================================================*/
 	for (; iVA < end_vaddr && i < remaining_ws_pages; i++, iVA += PAGE_SIZE) {
-		// Allocate a page
-		allocate_frame(&p);
+		/*2025*/ //Map it read-only on the frame cache of the program (if any), else allocate a private page
+		if (e->progCache != NULL)
+		{
+			program_cache_map_page(e, iVA);
+		}
+		else
+		{
+			// Allocate a page
+			allocate_frame(&p);
 
-		LOG_STRING("segment page allocated");
-		loadtime_map_frame(e->env_page_directory, p, iVA,
-		PERM_USER | PERM_WRITEABLE);
-		LOG_STRING("segment page mapped");
+			LOG_STRING("segment page allocated");
+			loadtime_map_frame(e->env_page_directory, p, iVA,
+			PERM_USER | PERM_WRITEABLE);
+			LOG_STRING("segment page mapped");
+		}
 
 #if USE_KHEAP
 		struct WorkingSetElement* wse = env_page_ws_list_create_element(e, iVA);
@@ -883,6 +930,10 @@ static int program_segment_alloc_map_copy_workingset(struct Env *e,
 		/// DON'T MAKE IT " *allocated_pages ++ " EVER !
 		(*allocated_pages)++;
 	}
+	/*2025*/ //the cached pages are already filled
+	if (e->progCache != NULL)
+		return 0;
+
 	uint8 *src_ptr = (uint8 *) (seg->ptr_start);
 	uint8 *dst_ptr = (uint8 *) seg->virtual_address;
 
@@ -1039,7 +1090,13 @@ void initialize_environment(struct Env* e, uint32* ptr_user_page_directory,
 #if USE_KHEAP == 1
 	{
 		LIST_INIT(&(e->page_WS_list));
-		LIST_INIT(&(e->referenceStreamList));
+		LIST_INIT(&(e->ActiveList));
+		LIST_INIT(&(e->SecondList));
+		env_page_ws_hash_init(e);
+		e->page_WS_ring = NULL;
+		e->page_WS_ring_size = 0;
+		e->referenceStream = NULL;
+		e->referenceStreamSize = e->referenceStreamCapacity = 0;
 	}
 #else
 	{
@@ -1095,6 +1152,23 @@ void initialize_environment(struct Env* e, uint32* ptr_user_page_directory,
 	e->nPageIn = 0;
 	e->nPageOut = 0;
 	e->nNewPageAdded = 0;
+	e->nFaultAroundPages = 0;
+	e->nFaultAroundHits = 0;
+	e->nFaultAroundMisses = 0;
+	e->nSoftPageFaults = 0;
+	e->nHardPageFaults = 0;
+	e->nZeroMappedPages = 0;
+	e->nZeroFillCOWFaults = 0;
+	e->progCache = NULL;
+	e->nProgCachePages = 0;
+	e->nProgCOWFaults = 0;
+	e->pageTrace = NULL;
+	e->pageTraceNext = e->pageTraceCount = 0;
+	e->pffTicks = 0;
+	e->pffLastFaultsCounter = 0;
+	e->isHandlingFault = 0;
+
+	e->uheapDABreak = USER_HEAP_START;
 
 //e->shared_free_address = USER_SHARED_MEM_START;
 
@@ -1139,6 +1213,12 @@ void complete_environment_initialization(struct Env* e) {
 //========================================================
 	e->env_status = ENV_NEW;
 	e->env_runs = 0;
+	e->lastRunTick = ticks;
+	e->sleepTimer = NULL;
+	e->readyTick = ticks;
+	e->nice = 0;
+	e->recentCPU = fix_int(0);
+	e->recentCPUSecond = bsd_seconds;
 
 // Clear out all the saved register state,
 // to prevent the register values
@@ -1248,8 +1328,11 @@ void cleanup_buffers(struct Env* e) {
 		acquire_kspinlock(&MemFrameLists.mfllock);
 	}
 	{
-		LIST_FOREACH(ptr_fi, &MemFrameLists.modified_frame_list)
+		struct FrameInfo *ptr_next = NULL;
+		for (ptr_fi = LIST_FIRST(&MemFrameLists.modified_frame_list); ptr_fi != NULL; ptr_fi = ptr_next)
 		{
+			//free_frame() re-links it into the free list, so get the next one first
+			ptr_next = LIST_NEXT(ptr_fi);
 			if (ptr_fi->proc == e) {
 				/*MUST UN-COMMENT THIS LINE*/
 				//pt_clear_page_table_entry(ptr_fi->proc->env_page_directory,ptr_fi->va);
@@ -1263,6 +1346,24 @@ void cleanup_buffers(struct Env* e) {
 				//cprintf("==================\n");
 			}
 		}
+		/*2025*/ //its frames that are being written back are freed too (see writeback_flush())
+		for (ptr_fi = LIST_FIRST(&MemFrameLists.writeback_frame_list); ptr_fi != NULL; ptr_fi = ptr_next)
+		{
+			ptr_next = LIST_NEXT(ptr_fi);
+			if (ptr_fi->proc == e) {
+				LIST_REMOVE(&MemFrameLists.writeback_frame_list, ptr_fi);
+				free_frame(ptr_fi);
+			}
+		}
+		/*2025*/ //its clean buffered frames remain in the free list as normal free frames
+		LIST_FOREACH(ptr_fi, &MemFrameLists.free_frame_list)
+		{
+			if (ptr_fi->isBuffered && ptr_fi->proc == e) {
+				ptr_fi->isBuffered = 0;
+				ptr_fi->proc = NULL;
+				ptr_fi->references = 0;
+			}
+		}
 	}
 	if (!lock_already_held) {
 		release_kspinlock(&MemFrameLists.mfllock);
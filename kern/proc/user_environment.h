@@ -15,6 +15,37 @@ extern struct UserProgramInfo* ptr_UserPrograms;
 extern struct Env *envs;		// All environments
 //extern struct Env *curenv;	// Current environment
 
+//Contains information about each program segment (e.g. start address, size, virtual address...)
+//It's used by "env_create" to load each program segment into the user environment (and by the program frame cache)
+
+struct ProgramSegment {
+	uint8 *ptr_start;
+	uint32 size_in_file;
+	uint32 size_in_memory;
+	uint8 *virtual_address;
+
+	// for use only with PROGRAM_SEGMENT_FOREACH
+	uint32 segment_id;
+};
+
+// Used inside the PROGRAM_SEGMENT_FOREACH macro to get the first program segment
+// and then iterate on the next ones
+struct ProgramSegment* PROGRAM_SEGMENT_NEXT(struct ProgramSegment* seg,
+		uint8* ptr_program_start);
+struct ProgramSegment PROGRAM_SEGMENT_FIRST(uint8* ptr_program_start);
+
+// Used inside "env_create" function to get information about each program segment inside the user program
+#define	PROGRAM_SEGMENT_FOREACH(Seg, ptr_program_start)					\
+		struct ProgramSegment* first; \
+		struct ProgramSegment tmp; \
+		tmp = (PROGRAM_SEGMENT_FIRST(ptr_program_start));	 \
+		first = &tmp; \
+		if(first->segment_id == -1) first = NULL;\
+		Seg = first; \
+		for (;				\
+		Seg;							\
+		Seg = PROGRAM_SEGMENT_NEXT(Seg,ptr_program_start) )
+
 ///===================================================================================
 struct Env* get_cpu_proc(void);			// get the the current running process on the CPU
 void set_cpu_proc(struct Env* p);		// set the process to be run on CPU
@@ -25,6 +56,8 @@ int envid2env(int32  envid, struct Env **env_store, bool checkperm);
 void env_init(void);
 /*Create new environment, initialize it, load the EXE into its memory and adjust its address space*/
 struct Env* env_create(char* user_program_name, unsigned int page_WS_size, unsigned int LRU_second_list_size, unsigned int percent_WS_pages_to_remove);
+/*Create new kernel-only environment that runs the given entry function*/
+struct Env* env_create_kernel(char* name, void (*entry)(void));
 /*Free (delete) the environment by freeing its allocated memory and other resources (if any)*/
 void env_free(struct Env *e);
 
@@ -51,6 +51,7 @@ struct UserProgramInfo userPrograms[] = {
 		/********************************************/
 		{ "tpr1", "Tests page replacement (allocation of Memory and PageFile)", PTR_START_OF(tst_page_replacement_alloc)},
 		{ "tpr2", "tests page replacement (handling new stack and modified pages)", PTR_START_OF(tst_page_replacement_stack)},
+		/*2025*/{ "tzf", "Tests the lazy zero-fill of the fresh heap & stack pages (shared zero frame, copy on the first write)", PTR_START_OF(tst_zero_fill)},
 		{ "dummy_process", "[Slave program] contains nested loops with random bounds to consume time", PTR_START_OF(dummy_process)},
 		{ "toptimal1", "Tests page replacement (OPTIMAL algorithm 1) - no change in DS", PTR_START_OF(tst_page_replacement_optimal_1)},
 		{ "toptimal2", "Tests page replacement (OPTIMAL algorithm 2) - placement", PTR_START_OF(tst_page_replacement_optimal_2)},
@@ -60,6 +61,12 @@ struct UserProgramInfo userPrograms[] = {
 		{ "tmodclk1", "Tests page replacement (modified clock algorithm)", PTR_START_OF(tst_page_replacement_mod_clock_1)},
 		{ "tmodclk2", "Tests page replacement (modified clock algorithm) after free", PTR_START_OF(tst_page_replacement_mod_clock_2)},
 		{ "tlru", "Tests page replacement (LRU algorithm)", PTR_START_OF(tst_page_replacement_lru)},
+		/*2025*/{ "tlruinv", "Tests the LRU lists invariants while demoting, soft faulting & evicting pages", PTR_START_OF(tst_lru_lists_invariants)},
+		/*2025*/{ "nclkbench", "Benchmarks the Nth chance CLOCK: # page in/out for N = 1..5 of its NORMAL & MODIFIED versions", PTR_START_OF(nclock_bench)},
+		/*2025*/{ "trecl", "Tests the memory reclaimer: its watermarks, the blocked allocations & skipping the envs in a page fault", PTR_START_OF(tst_reclaimer)},
+		/*2025*/{ "tReclSlave", "[Slave program] of tst_reclaimer", PTR_START_OF(tst_reclaimer_slave)},
+		/*2025*/{ "tpcache", "Tests the program frame cache: sharing the frames among 2 envs of a program, copy-on-write & flushing", PTR_START_OF(tst_program_cache)},
+		/*2025*/{ "tPCacheSlave", "[Slave program] of tst_program_cache", PTR_START_OF(tst_program_cache_slave)},
 		/********************************************/
 		/************/
 		/*USER HEAP */
@@ -112,6 +119,7 @@ struct UserProgramInfo userPrograms[] = {
 		{ "ksem1Slave", "[Slave program] of tst_ksemaphore_1master", PTR_START_OF(tst_ksemaphore_1slave)},
 		{ "tst_ksem2", "Tests the KERNEL Semaphores only [multiprograms enter the same CS]", PTR_START_OF(tst_ksemaphore_2master)},
 		{ "ksem2Slave", "[Slave program] of tst_ksemaphore_2master", PTR_START_OF(tst_ksemaphore_2slave)},
+		/*2025*/{ "tsleepns", "Tests the timed sleeps (sys_sleep_ns & the kernel semaphore wait with a timeout) & their lengths", PTR_START_OF(tst_sleep_ns)},
 		/********************************************/
 		{ "tst_chan_all", "Tests sleep & wakeup ALL on a channel", PTR_START_OF(tst_chan_all_master)},
 		{ "tstChanAllSlave", "Slave program of tst_chan_all", PTR_START_OF(tst_chan_all_slave)},
@@ -25,6 +25,7 @@ struct UserProgramInfo {
 	const char *name;
 	const char *desc;
 	uint8* ptr_start;
+	struct ProgramFrameCache* frameCache;	//2025: frames shared by its envs (see kern/proc/program_cache.h)
 };
 
 struct UserProgramInfo*  get_user_program_info(char* user_program_name);
@@ -75,6 +76,7 @@ DECLARE_START_OF(tst_invalid_access_slave4)
 /********************************************/
 DECLARE_START_OF(tst_page_replacement_alloc)
 DECLARE_START_OF(tst_page_replacement_stack)
+/*2025*/DECLARE_START_OF(tst_zero_fill);
 DECLARE_START_OF(tst_page_replacement_optimal_1);
 DECLARE_START_OF(tst_page_replacement_optimal_2);
 DECLARE_START_OF(tst_page_replacement_optimal_3);
@@ -83,6 +85,12 @@ DECLARE_START_OF(tst_page_replacement_mod_clock_2);
 DECLARE_START_OF(tst_page_replacement_clock_1);
 DECLARE_START_OF(tst_page_replacement_clock_2);
 DECLARE_START_OF(tst_page_replacement_lru)
+/*2025*/DECLARE_START_OF(nclock_bench);
+/*2025*/DECLARE_START_OF(tst_lru_lists_invariants);
+/*2025*/DECLARE_START_OF(tst_reclaimer);
+/*2025*/DECLARE_START_OF(tst_reclaimer_slave);
+/*2025*/DECLARE_START_OF(tst_program_cache);
+/*2025*/DECLARE_START_OF(tst_program_cache_slave);
 DECLARE_START_OF(dummy_process);
 /********************************************/
 
@@ -141,6 +149,7 @@ DECLARE_START_OF(tst_ksemaphore_1master);
 DECLARE_START_OF(tst_ksemaphore_1slave);
 DECLARE_START_OF(tst_ksemaphore_2master);
 DECLARE_START_OF(tst_ksemaphore_2slave);
+/*2025*/DECLARE_START_OF(tst_sleep_ns);
 /********************************************/
 DECLARE_START_OF(tst_chan_all_master);
 DECLARE_START_OF(tst_chan_all_slave);
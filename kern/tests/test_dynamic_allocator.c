@@ -11,6 +11,8 @@
 #include <inc/assert.h>
 #include <inc/dynamic_allocator.h>
 #include <inc/memlayout.h>
+#include <inc/x86.h>
+#include <kern/cpu/kclock.h>
 
 //NOTE: ALL tests in this file shall work with USE_KHEAP = 0
 
@@ -664,4 +666,67 @@ void test_realloc_block()
 }
 
 
+/*2025*/
+//=====================================================
+// BENCHMARK: ops/sec of DA_MODE_LIST vs DA_MODE_BITMAP
+//=====================================================
+#define BENCH_NUM_OF_BLOCKS 1024
+#define BENCH_NUM_OF_ROUNDS 4
+void* benchBlocks[BENCH_NUM_OF_BLOCKS];
+
+//alloc then free BENCH_NUM_OF_BLOCKS of each size (free in interleaved order to fragment the pages)
+static uint64 bench_dyn_alloc_mode(uint32 mode, uint32 *numOfOps)
+{
+	set_dyn_alloc_mode(mode);
+	initialize_dynamic_allocator(KERNEL_HEAP_START - DYN_ALLOC_MAX_SIZE, KERNEL_HEAP_START);
+
+	*numOfOps = 0;
+	uint64 start = read_tsc();
+	for (int r = 0; r < BENCH_NUM_OF_ROUNDS; ++r)
+	{
+		for (uint32 size = DYN_ALLOC_MIN_BLOCK_SIZE; size <= DYN_ALLOC_MAX_BLOCK_SIZE; size <<= 1)
+		{
+			for (int i = 0; i < BENCH_NUM_OF_BLOCKS; ++i)
+			{
+				benchBlocks[i] = alloc_block(size);
+				if (benchBlocks[i] == NULL)
+					panic("bench_dyn_alloc_mode: alloc_block(%d) failed", size);
+			}
+			for (int i = 0; i < BENCH_NUM_OF_BLOCKS; i += 2)
+				free_block(benchBlocks[i]);
+			for (int i = 1; i < BENCH_NUM_OF_BLOCKS; i += 2)
+				free_block(benchBlocks[i]);
+			*numOfOps += 2 * BENCH_NUM_OF_BLOCKS;
+		}
+	}
+	return read_tsc() - start;
+}
+
+void test_dyn_alloc_bench()
+{
+#if USE_KHEAP
+	panic("test_dyn_alloc_bench: the kernel heap should be disabled. make sure USE_KHEAP = 0");
+	return;
+#endif
+	uint32 oldMode = get_dyn_alloc_mode();
+	//calibrated against the PIT at boot (see kclock_tsc_khz())
+	uint64 cyclesPerMS = kclock_tsc_khz();
+	cprintf_colored(TEXT_cyan, "TSC = %d cycles/ms\n", (uint32)cyclesPerMS);
+
+	char* modeNames[] = {"LIST", "BITMAP"};
+	uint32 modes[] = {DA_MODE_LIST, DA_MODE_BITMAP};
+	for (int m = 0; m < 2; ++m)
+	{
+		uint32 numOfOps;
+		uint64 cycles = bench_dyn_alloc_mode(modes[m], &numOfOps);
+		uint32 opsPerSec = (uint32)(((uint64)numOfOps * cyclesPerMS * 1000) / (cycles ? cycles : 1));
+		cprintf_colored(TEXT_light_green, "DA_MODE_%s: %d ops in %d cycles => %d cycles/op, %d ops/sec\n",
+				modeNames[m], numOfOps, (uint32)cycles, (uint32)(cycles / numOfOps), opsPerSec);
+	}
+
+	set_dyn_alloc_mode(oldMode);
+	initialize_dynamic_allocator(KERNEL_HEAP_START - DYN_ALLOC_MAX_SIZE, KERNEL_HEAP_START);
+}
+
+
 /********************Helper Functions***************************/
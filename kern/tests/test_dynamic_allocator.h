@@ -16,6 +16,7 @@ int  test_initialize_dynamic_allocator();
 void test_alloc_block();
 void test_free_block();
 void test_realloc_block();
+void test_dyn_alloc_bench();
 int check_dynalloc_datastruct(void* va, void* expectedVA, uint32 expectedSize, uint8 expectedFlag);
 
 
@@ -0,0 +1,170 @@
+/*
+ * test_kmem_cache.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: HP
+ */
+
+#include "test_kmem_cache.h"
+#include <inc/assert.h>
+#include <inc/stdio.h>
+#include <inc/string.h>
+#include <inc/memlayout.h>
+#include "../mem/kmem_cache.h"
+
+extern uint32 sys_calculate_free_frames() ;
+
+//The test cache: 20-byte objects aligned on 32 bytes, with a constructor.
+//	It's created on the first run only (the caches are never destroyed) & left empty by each run.
+#define TST_KMC_OBJ_SIZE	20
+#define TST_KMC_ALIGN		32
+#define TST_KMC_CTOR_MAGIC	0xC0DEC0DE
+#define TST_KMC_NUM_OF_SLABS	3
+#define TST_KMC_MAX_OBJS	(TST_KMC_NUM_OF_SLABS * PAGE_SIZE / TST_KMC_ALIGN)
+
+static struct kmem_cache* tstCache = NULL;
+static uint32 tstNumOfCtorCalls = 0;
+static void* tstObjs[TST_KMC_MAX_OBJS];
+
+static void tst_kmem_cache_ctor(void* obj)
+{
+	tstNumOfCtorCalls++;
+	*(uint32*)obj = TST_KMC_CTOR_MAGIC;
+}
+
+int test_kmem_cache()
+{
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+	cprintf_colored(TEXT_yellow,"MAKE SURE to have NO running programs while running this test\n");
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+
+	if (tstCache == NULL)
+		tstCache = kmem_cache_create("tst_kmem_cache", TST_KMC_OBJ_SIZE, TST_KMC_ALIGN, tst_kmem_cache_ctor);
+	if (tstCache == NULL)
+		panic("test_kmem_cache: can't create the test cache (no more caches?)");
+	if (tstCache->num_active != 0)
+		panic("test_kmem_cache: the test cache is not empty at the start of the test");
+
+	uint32 perSlab = tstCache->objs_per_slab;
+	//2 full slabs & one more object (the 3rd slab)
+	uint32 n = (TST_KMC_NUM_OF_SLABS - 1) * perSlab + 1;
+	//the empty slab kept by a previous run (if any) is taken first, its objects are already constructed
+	uint32 numOfReusedObjs = LIST_EMPTY(&tstCache->slabs_free) ? 0 : perSlab;
+	uint32 createdBefore = tstCache->num_slabs_created;
+	uint32 destroyedBefore = tstCache->num_slabs_destroyed;
+	uint32 ctorCallsBefore = tstNumOfCtorCalls;
+	assert(n <= TST_KMC_MAX_OBJS);
+
+	int eval = 0;
+	int correct = 1;
+
+	//1. Alloc & alignment
+	cprintf_colored(TEXT_cyan,"\n1. Alloc %d objects & check their size & alignment [20%]\n", n);
+	{
+		if (kmem_cache_create("tst_invalid_align", TST_KMC_OBJ_SIZE, 24, NULL) != NULL ||
+			kmem_cache_create("tst_invalid_size", 0, 0, NULL) != NULL)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"a cache is created with an invalid alignment/size\n"); }
+		if (tstCache->objsize != ROUNDUP(TST_KMC_OBJ_SIZE, TST_KMC_ALIGN))
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong object size! Expected = %d, Actual = %d\n", ROUNDUP(TST_KMC_OBJ_SIZE, TST_KMC_ALIGN), tstCache->objsize); }
+		for (uint32 i = 0; i < n; i++)
+		{
+			tstObjs[i] = kmem_cache_alloc(tstCache);
+			if (tstObjs[i] == NULL)
+				panic("test_kmem_cache: kmem_cache_alloc() failed at object #%d", i);
+			if ((uint32)tstObjs[i] % TST_KMC_ALIGN != 0)
+			{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"object #%d @ %x is not aligned on %d\n", i, tstObjs[i], TST_KMC_ALIGN); break; }
+		}
+		if (tstCache->num_active != n)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # active objects! Expected = %d, Actual = %d\n", n, tstCache->num_active); }
+	}
+	if (correct) eval += 20;
+	correct = 1;
+
+	//2. Constructor on the first use
+	cprintf_colored(TEXT_cyan,"\n2. Check the constructor is called once per object on its slab creation [20%]\n");
+	{
+		uint32 numOfNewSlabs = tstCache->num_slabs_created - createdBefore;
+		if (tstNumOfCtorCalls - ctorCallsBefore != numOfNewSlabs * perSlab)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # constructor calls! Expected = %d, Actual = %d\n", numOfNewSlabs * perSlab, tstNumOfCtorCalls - ctorCallsBefore); }
+		for (uint32 i = numOfReusedObjs; i < n; i++)
+		{
+			if (*(uint32*)tstObjs[i] != TST_KMC_CTOR_MAGIC)
+			{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"object #%d is not constructed\n", i); break; }
+		}
+		//fill them, a freed object keeps its content (it's not constructed again)
+		for (uint32 i = 0; i < n; i++)
+			memset(tstObjs[i], (uint8)i, TST_KMC_OBJ_SIZE);
+		uint32 ctorCalls = tstNumOfCtorCalls;
+		void* first = tstObjs[0];
+		kmem_cache_free(tstCache, first);
+		tstObjs[0] = kmem_cache_alloc(tstCache);
+		if (tstObjs[0] != first)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the last freed object is not re-allocated first! Expected = %x, Actual = %x\n", first, tstObjs[0]); }
+		else if (tstNumOfCtorCalls != ctorCalls || *(uint8*)first != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"a re-allocated object is constructed again\n"); }
+	}
+	if (correct) eval += 20;
+	correct = 1;
+
+	//3. Growing past one slab
+	cprintf_colored(TEXT_cyan,"\n3. Check the cache grows to %d slabs (%d objects/slab) [20%]\n", TST_KMC_NUM_OF_SLABS, perSlab);
+	{
+		uint32 numOfSlabs = tstCache->num_slabs_created - tstCache->num_slabs_destroyed;
+		if (numOfSlabs != TST_KMC_NUM_OF_SLABS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # slabs! Expected = %d, Actual = %d\n", TST_KMC_NUM_OF_SLABS, numOfSlabs); }
+		if (LIST_SIZE(&tstCache->slabs_full) != TST_KMC_NUM_OF_SLABS - 1 || LIST_SIZE(&tstCache->slabs_partial) != 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # full/partial slabs! Expected = %d/1, Actual = %d/%d\n", TST_KMC_NUM_OF_SLABS - 1, LIST_SIZE(&tstCache->slabs_full), LIST_SIZE(&tstCache->slabs_partial)); }
+		//the objects of a new slab are given in the address order (a reused slab gives them in its free order)
+		for (uint32 i = 0; i < n && correct; i++)
+		{
+			struct kmem_slab* slab = (struct kmem_slab*)ROUNDDOWN((uint32)tstObjs[i], PAGE_SIZE);
+			uint32 expected = (uint32)slab->objects + (i % perSlab) * tstCache->objsize;
+			if (slab->cache != tstCache || (i >= numOfReusedObjs && (uint32)tstObjs[i] != expected))
+			{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"object #%d @ %x is not at its place in its slab (expected @ %x)\n", i, tstObjs[i], expected); }
+			if (i % perSlab != 0 && ROUNDDOWN((uint32)tstObjs[i-1], PAGE_SIZE) != (uint32)slab)
+			{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"objects #%d & #%d are not in the same slab\n", i-1, i); }
+		}
+	}
+	if (correct) eval += 20;
+	correct = 1;
+
+	//4. Content (no overlap)
+	cprintf_colored(TEXT_cyan,"\n4. Check the content of the objects [10%]\n");
+	{
+		for (uint32 i = 0; i < n && correct; i++)
+		{
+			uint8* ptr = (uint8*)tstObjs[i];
+			for (int j = 0; j < TST_KMC_OBJ_SIZE; j++)
+			{
+				if (ptr[j] != (uint8)i)
+				{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"invalid content of object #%d\n", i); break; }
+			}
+		}
+	}
+	if (correct) eval += 10;
+	correct = 1;
+
+	//5. Free all: the empty slabs go back to the kernel heap (except one)
+	cprintf_colored(TEXT_cyan,"\n5. Free all & check the empty slabs are returned to the kernel heap [30%]\n");
+	{
+		uint32 freeFramesBefore = sys_calculate_free_frames();
+		for (uint32 i = 0; i < n; i++)
+			kmem_cache_free(tstCache, tstObjs[i]);
+		uint32 freeFramesAfter = sys_calculate_free_frames();
+
+		if (tstCache->num_active != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # active objects! Expected = 0, Actual = %d\n", tstCache->num_active); }
+		if (!LIST_EMPTY(&tstCache->slabs_full) || !LIST_EMPTY(&tstCache->slabs_partial) || LIST_SIZE(&tstCache->slabs_free) != 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong slabs lists! Expected (full, partial, empty) = (0, 0, 1), Actual = (%d, %d, %d)\n", LIST_SIZE(&tstCache->slabs_full), LIST_SIZE(&tstCache->slabs_partial), LIST_SIZE(&tstCache->slabs_free)); }
+		uint32 numOfDestroyed = tstCache->num_slabs_destroyed - destroyedBefore;
+		if (numOfDestroyed != TST_KMC_NUM_OF_SLABS - 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # slabs returned to the kernel heap! Expected = %d, Actual = %d\n", TST_KMC_NUM_OF_SLABS - 1, numOfDestroyed); }
+		if (freeFramesAfter - freeFramesBefore < TST_KMC_NUM_OF_SLABS - 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the frames of the empty slabs are not freed! Expected >= %d, Actual = %d\n", TST_KMC_NUM_OF_SLABS - 1, freeFramesAfter - freeFramesBefore); }
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	cprintf_colored(TEXT_light_green,"\ntest_kmem_cache is finished. Evaluation = %d%\n", eval);
+	return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * test_kmem_cache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_TESTS_TEST_KMEM_CACHE_H_
+#define KERN_TESTS_TEST_KMEM_CACHE_H_
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+//2025: Slab caches (kmem_cache) Tests
+int test_kmem_cache();
+
+#endif /* KERN_TESTS_TEST_KMEM_CACHE_H_ */
@@ -0,0 +1,143 @@
+/*
+ * test_pagefile.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: HP
+ */
+
+#include "test_pagefile.h"
+#include <inc/assert.h>
+#include <inc/stdio.h>
+#include <inc/string.h>
+#include <inc/error.h>
+#include <kern/disk/pagefile_manager.h>
+
+//The test runs on a synthetic state of the disk frames bitmap (all allocated except the frames it frees),
+//	the actual one is saved at its start & restored at its end
+static uint32 savedFreeMap[PAGES_PER_FILE / 32];
+static uint32 savedNumOfFreeFrames;
+static uint32 savedNextHint;
+
+static void tst_pf_allocate_all()
+{
+	memset(DiskFrameLists.disk_free_map, 0, sizeof(DiskFrameLists.disk_free_map));
+	DiskFrameLists.disk_num_of_free_frames = 0;
+	DiskFrameLists.disk_next_hint = 1;
+}
+static void tst_pf_free_frames(uint32 dfn, uint32 num)
+{
+	for (uint32 i = 0; i < num; i++)
+		free_disk_frame(dfn + i);
+}
+static bool tst_pf_is_free(uint32 dfn)
+{
+	return (DiskFrameLists.disk_free_map[dfn / 32] & (1 << (dfn % 32))) != 0;
+}
+//Are the given frames all allocated/free?
+static bool tst_pf_check_frames(uint32 dfn, uint32 num, bool isFree)
+{
+	for (uint32 i = 0; i < num; i++)
+		if (tst_pf_is_free(dfn + i) != isFree)
+			return 0;
+	return 1;
+}
+
+int test_pagefile_extents()
+{
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+	cprintf_colored(TEXT_yellow,"MAKE SURE to have NO running programs while running this test\n");
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+
+	memcpy(savedFreeMap, DiskFrameLists.disk_free_map, sizeof(savedFreeMap));
+	savedNumOfFreeFrames = DiskFrameLists.disk_num_of_free_frames;
+	savedNextHint = DiskFrameLists.disk_next_hint;
+
+	int eval = 0;
+	int correct = 1;
+	uint32 dfn = 0;
+
+	//1. Contiguous allocation: [100, 131] are free (they span 2 bitmap words)
+	cprintf_colored(TEXT_cyan,"\n1. Allocate consecutive frames near a hint & after the last allocation [25%]\n");
+	{
+		tst_pf_allocate_all();
+		tst_pf_free_frames(100, 32);
+		if (DiskFrameLists.disk_num_of_free_frames != 32)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # free frames! Expected = %d, Actual = %d\n", 32, DiskFrameLists.disk_num_of_free_frames); }
+		if (allocate_disk_frames(10, 50, &dfn) != 0 || dfn != 100)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the 1st extent is not allocated at its place! Expected = %d, Actual = %d\n", 100, dfn); }
+		else if (!tst_pf_check_frames(100, 10, 0) || !tst_pf_check_frames(110, 22, 1) || DiskFrameLists.disk_num_of_free_frames != 22)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the frames of the 1st extent are not marked correctly\n"); }
+		//no hint: right after the last allocation (crossing the bitmap word)
+		if (allocate_disk_frames(20, 0, &dfn) != 0 || dfn != 110)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the 2nd extent is not allocated after the 1st one! Expected = %d, Actual = %d\n", 110, dfn); }
+		else if (!tst_pf_check_frames(110, 20, 0) || DiskFrameLists.disk_num_of_free_frames != 2)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the frames of the 2nd extent are not marked correctly\n"); }
+	}
+	if (correct) eval += 25;
+	correct = 1;
+
+	//2. Merge: the freed extents & the 2 free frames left form one extent again
+	cprintf_colored(TEXT_cyan,"\n2. Free the extents: they should merge with their free neighbors [25%]\n");
+	{
+		tst_pf_free_frames(110, 20);
+		tst_pf_free_frames(100, 10);
+		if (DiskFrameLists.disk_num_of_free_frames != 32 || !tst_pf_check_frames(100, 32, 1))
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the freed frames are not marked correctly! # free frames = %d\n", DiskFrameLists.disk_num_of_free_frames); }
+		if (allocate_disk_frames(32, 1, &dfn) != 0 || dfn != 100)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the freed extents are not merged! Expected = %d, Actual = %d\n", 100, dfn); }
+	}
+	if (correct) eval += 25;
+	correct = 1;
+
+	//3. Full & fragmented page file
+	cprintf_colored(TEXT_cyan,"\n3. Allocate from a full & a fragmented page file: it should fail cleanly [20%]\n");
+	{
+		uint32 nextHint = DiskFrameLists.disk_next_hint;
+		dfn = 0;
+		if (DiskFrameLists.disk_num_of_free_frames != 0 || allocate_disk_frame(&dfn) != E_NO_PAGE_FILE_SPACE || dfn != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"a frame is allocated from a full page file\n"); }
+		if (allocate_disk_frames(0, 0, &dfn) != E_NO_PAGE_FILE_SPACE)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"an empty extent is allocated\n"); }
+		//2 free frames with no 2 consecutive ones
+		tst_pf_free_frames(200, 1);
+		tst_pf_free_frames(202, 1);
+		if (allocate_disk_frames(2, 200, &dfn) != E_NO_PAGE_FILE_SPACE)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"an extent is allocated on non-consecutive frames\n"); }
+		if (DiskFrameLists.disk_num_of_free_frames != 2 || !tst_pf_is_free(200) || !tst_pf_is_free(202) || DiskFrameLists.disk_next_hint != nextHint)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"a failed allocation changes the bitmap\n"); }
+		if (allocate_disk_frame(&dfn) != 0 || dfn != 200)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"a free frame is not allocated from a fragmented page file! Expected = %d, Actual = %d\n", 200, dfn); }
+	}
+	if (correct) eval += 20;
+	correct = 1;
+
+	//4. The last bitmap word: an extent can end at the last frame but can't wrap around to the first ones
+	cprintf_colored(TEXT_cyan,"\n4. Allocate at the end of the page file (the last bitmap word) [30%]\n");
+	{
+		uint32 lastWordStart = PAGES_PER_FILE - 32;
+		tst_pf_allocate_all();
+		tst_pf_free_frames(lastWordStart, 32);
+		if (allocate_disk_frames(32, lastWordStart, &dfn) != 0 || dfn != lastWordStart || DiskFrameLists.disk_num_of_free_frames != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the last word is not allocated as one extent! Expected = %d, Actual = %d\n", lastWordStart, dfn); }
+		tst_pf_free_frames(PAGES_PER_FILE - 8, 8);
+		tst_pf_free_frames(1, 4);
+		if (allocate_disk_frames(12, PAGES_PER_FILE - 8, &dfn) != E_NO_PAGE_FILE_SPACE)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"an extent wraps around the end of the page file\n"); }
+		//searching from the last frames goes on from the start
+		if (allocate_disk_frames(4, PAGES_PER_FILE - 2, &dfn) != 0 || dfn != 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the search doesn't go on from the start of the page file! Expected = %d, Actual = %d\n", 1, dfn); }
+		if (allocate_disk_frames(8, 0, &dfn) != 0 || dfn != PAGES_PER_FILE - 8)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"the last frames are not allocated! Expected = %d, Actual = %d\n", PAGES_PER_FILE - 8, dfn); }
+		if (DiskFrameLists.disk_num_of_free_frames != 0 || tst_pf_is_free(0))
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR,"wrong # free frames at the end! Expected = 0, Actual = %d\n", DiskFrameLists.disk_num_of_free_frames); }
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	memcpy(DiskFrameLists.disk_free_map, savedFreeMap, sizeof(savedFreeMap));
+	DiskFrameLists.disk_num_of_free_frames = savedNumOfFreeFrames;
+	DiskFrameLists.disk_next_hint = savedNextHint;
+
+	cprintf_colored(TEXT_light_green,"\ntest_pagefile_extents is finished. Evaluation = %d%\n", eval);
+	return 0;
+}
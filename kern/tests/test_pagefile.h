@@ -0,0 +1,17 @@
+/*
+ * test_pagefile.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_TESTS_TEST_PAGEFILE_H_
+#define KERN_TESTS_TEST_PAGEFILE_H_
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+//2025: Page file extents (disk frames bitmap) Tests
+int test_pagefile_extents();
+
+#endif /* KERN_TESTS_TEST_PAGEFILE_H_ */
@@ -0,0 +1,147 @@
+/*
+ * test_timer_wheel.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "test_timer_wheel.h"
+#include <inc/assert.h>
+#include <kern/cpu/timer_wheel.h>
+#include <kern/cpu/kclock.h>
+#include <kern/cpu/sched.h>
+#include <kern/cpu/cpu.h>
+#include <inc/stdio.h>
+
+//The tests run the wheel with times ahead of the clock (in wheel units), so no timer should be pending
+#define TW_TST_NS(units)	((uint64)(units) << TW_UNIT_SHIFT)
+
+static int numOfFiredTestTimers = 0;
+static void test_timer_fired(struct Timer* timer)
+{
+	numOfFiredTestTimers++;
+}
+
+static void test_timer_init(struct Timer* timer)
+{
+	timer->func = test_timer_fired;
+	timer->slot = NULL;
+	timer->env = NULL;
+	timer->chan = NULL;
+	timer->fired = 0;
+}
+
+static int test_timer_check(struct Timer* timer, char* name, int expectedLevel, uint8 expectedFired)
+{
+	int level = timer_level(timer);
+	if (level != expectedLevel || timer->fired != expectedFired)
+	{
+		cprintf_colored(TEXT_TESTERR_CLR, "timer %s: expected (level = %d, fired = %d), actual (level = %d, fired = %d)\n",
+				name, expectedLevel, expectedFired, level, timer->fired);
+		return 0;
+	}
+	return 1;
+}
+
+static int test_timer_next_expiry(uint64 now_ns, int expectedPending, uint64 expectedDelta)
+{
+	uint64 delta = 0;
+	acquire_kspinlock(&ProcessQueues.qlock);
+	int pending = timer_next_expiry(now_ns, &delta);
+	release_kspinlock(&ProcessQueues.qlock);
+	if (pending != expectedPending || (pending && delta != expectedDelta))
+	{
+		cprintf_colored(TEXT_TESTERR_CLR, "timer_next_expiry: expected (pending = %d, delta = %d units), actual (pending = %d, delta = %d units)\n",
+				expectedPending, (uint32)(expectedDelta >> TW_UNIT_SHIFT), pending, (uint32)(delta >> TW_UNIT_SHIFT));
+		return 0;
+	}
+	return 1;
+}
+
+//Three timers are placed in the levels 0, 1 & 2 of the wheel, then it's run step by step:
+//	each timer should be cascaded down to level 0 before its expiration & expire on its time,
+//	timer_next_expiry() should give the first expiration or cascade. A cancelled timer should never fire
+int test_timer_wheel()
+{
+	int eval = 0;
+	bool correct = 1;
+	struct Timer t0, t1, t2, t3;
+	test_timer_init(&t0);
+	test_timer_init(&t1);
+	test_timer_init(&t2);
+	test_timer_init(&t3);
+	numOfFiredTestTimers = 0;
+
+	/*DISABLE THE INTERRUPT DURING THE TEST TO AVOID CLOCK INTERRUPTS*/
+	pushcli();
+
+	uint64 now = kclock_now_ns();
+	uint64 dummy;
+	acquire_kspinlock(&ProcessQueues.qlock);
+	int anyPending = timer_next_expiry(now, &dummy);
+	release_kspinlock(&ProcessQueues.qlock);
+	if (anyPending)
+	{
+		popcli();
+		cprintf_colored(TEXT_TESTERR_CLR, "some timers are pending, run it while no env is sleeping\n");
+		return 0;
+	}
+
+	//expirations (in units) at the middle of the slots of levels 0/1, so they're exactly known after the rounding
+	uint64 w = now >> TW_UNIT_SHIFT;
+	uint64 e0 = w + 3;
+	uint64 e1 = ((w >> TW_SLOT_BITS) + 2) << TW_SLOT_BITS | (TW_SLOTS / 2);
+	uint64 e2 = ((w >> (2 * TW_SLOT_BITS)) + 2) << (2 * TW_SLOT_BITS) | (TW_SLOTS / 2) << TW_SLOT_BITS | (TW_SLOTS / 2);
+
+	cprintf_colored(TEXT_cyan, "\n1. Placement\n");
+	{
+		acquire_kspinlock(&ProcessQueues.qlock);
+		timer_add(&t0, TW_TST_NS(e0));
+		timer_add(&t1, TW_TST_NS(e1));
+		timer_add(&t2, TW_TST_NS(e2));
+		timer_add(&t3, TW_TST_NS(e0 + 1));
+		timer_cancel(&t3);
+		release_kspinlock(&ProcessQueues.qlock);
+
+		correct = test_timer_check(&t0, "t0", 0, 0) & test_timer_check(&t1, "t1", 1, 0)
+				& test_timer_check(&t2, "t2", 2, 0) & test_timer_check(&t3, "t3 (cancelled)", -1, 0);
+		if (correct) eval += 20;
+	}
+	cprintf_colored(TEXT_cyan, "\n2. Next expiry\n");
+	{
+		correct = test_timer_next_expiry(now, 1, TW_TST_NS(e0) - now);
+		timer_run(TW_TST_NS(e0));
+		if (numOfFiredTestTimers != 1 || !test_timer_check(&t0, "t0", -1, 1)) correct = 0;
+		//the next one is the cascade of the level 1 slot of t1
+		if (!test_timer_next_expiry(TW_TST_NS(e0), 1, TW_TST_NS(e1 - TW_SLOTS / 2) - TW_TST_NS(e0))) correct = 0;
+		if (correct) eval += 20;
+	}
+	cprintf_colored(TEXT_cyan, "\n3. Cascading from level 1\n");
+	{
+		timer_run(TW_TST_NS(e1 - 1));
+		correct = test_timer_check(&t1, "t1", 0, 0);
+		timer_run(TW_TST_NS(e1));
+		if (numOfFiredTestTimers != 2 || !test_timer_check(&t1, "t1", -1, 1)) correct = 0;
+		if (correct) eval += 20;
+	}
+	cprintf_colored(TEXT_cyan, "\n4. Cascading from level 2\n");
+	{
+		timer_run(TW_TST_NS((e2 >> (2 * TW_SLOT_BITS)) << (2 * TW_SLOT_BITS)));
+		correct = test_timer_check(&t2, "t2", 1, 0);
+		timer_run(TW_TST_NS(e2 - 1));
+		if (!test_timer_check(&t2, "t2", 0, 0)) correct = 0;
+		timer_run(TW_TST_NS(e2));
+		if (numOfFiredTestTimers != 3 || !test_timer_check(&t2, "t2", -1, 1)) correct = 0;
+		if (correct) eval += 20;
+	}
+	cprintf_colored(TEXT_cyan, "\n5. Empty wheel\n");
+	{
+		correct = test_timer_next_expiry(TW_TST_NS(e2), 0, 0);
+		if (t3.fired) { correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "timer t3: fired after it's cancelled\n"); }
+		if (correct) eval += 20;
+	}
+	popcli();
+
+	cprintf_colored(TEXT_light_green, "\ntest_timer_wheel is finished. Eval = %d%\n", eval);
+	return eval;
+}
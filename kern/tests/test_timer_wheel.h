@@ -0,0 +1,17 @@
+/*
+ * test_timer_wheel.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_TESTS_TEST_TIMER_WHEEL_H_
+#define KERN_TESTS_TEST_TIMER_WHEEL_H_
+
+#ifndef FOS_KERNEL
+#error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+int test_timer_wheel();
+
+#endif /* KERN_TESTS_TEST_TIMER_WHEEL_H_ */
@@ -8,9 +8,46 @@
 #include <kern/tests/test_working_set.h>
 #include <kern/proc/user_environment.h>
 #include <kern/mem/working_set_manager.h>
+#include <kern/mem/memory_manager.h>
 #include <kern/cpu/cpu.h>
 #include <kern/cpu/kclock.h>
 
+//Check the LRU lists invariants: their sizes are within their limits, each Active page is PRESENT,
+//	each Second page is NOT PRESENT but still has its frame & each element is reachable from the WS hash
+static int check_LRU_lists_invariants(struct Env* env)
+{
+	struct WorkingSetElement* ptr_WS_element;
+	if (LIST_SIZE(&env->ActiveList) > env->ActiveListSize || LIST_SIZE(&env->SecondList) > env->SecondListSize)
+	{
+		cprintf("LRU lists: size exceeds its limit [active = %d/%d, second = %d/%d]\n",
+				LIST_SIZE(&env->ActiveList), env->ActiveListSize, LIST_SIZE(&env->SecondList), env->SecondListSize);
+		return 0;
+	}
+	LIST_FOREACH(ptr_WS_element, &(env->ActiveList))
+	{
+		uint32 va = ptr_WS_element->virtual_address;
+		if (!(pt_get_page_permissions(env->env_page_directory, va) & PERM_PRESENT)
+				|| env_page_ws_list_find_element(env, va) != ptr_WS_element)
+		{
+			cprintf("LRU lists: invalid active page [%x]\n", va);
+			return 0;
+		}
+	}
+	LIST_FOREACH(ptr_WS_element, &(env->SecondList))
+	{
+		uint32 va = ptr_WS_element->virtual_address;
+		uint32 *ptr_page_table = NULL;
+		if ((pt_get_page_permissions(env->env_page_directory, va) & PERM_PRESENT)
+				|| get_frame_info(env->env_page_directory, va, &ptr_page_table) == NULL
+				|| env_page_ws_list_find_element(env, va) != ptr_WS_element)
+		{
+			cprintf("LRU lists: invalid second page [%x]\n", va);
+			return 0;
+		}
+	}
+	return 1;
+}
+
 //2020
 int sys_check_LRU_lists(uint32* active_list_content, uint32* second_list_content, int actual_active_list_size, int actual_second_list_size)
 {
@@ -71,6 +108,24 @@ int sys_check_LRU_lists(uint32* active_list_content, uint32* second_list_content
 	return active_list_validation&second_list_validation;
 }
 
+//2025
+int sys_check_LRU_lists_invariants()
+{
+	int invariants_validation = 1;
+
+	/*DISABLE THE INTERRUPT DURING THE CHECKING TO AVOID CLOCK INTERRUPTS*/
+	pushcli(); kclock_stop();
+	{
+		struct Env* cur_env = get_cpu_proc();
+		assert(cur_env != NULL);
+		invariants_validation = check_LRU_lists_invariants(cur_env);
+	}
+	/*REENABLE THE INTERRUPT */
+	popcli(); kclock_resume();
+
+	return invariants_validation;
+}
+
 
 //2020
 int sys_check_LRU_lists_free(uint32* list_content, int list_size)
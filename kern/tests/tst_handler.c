@@ -19,6 +19,9 @@
 #include "../tests/test_commands.h"
 #include "../tests/test_dynamic_allocator.h"
 #include "../tests/test_scheduler.h"
+#include "../tests/test_timer_wheel.h"
+#include "../tests/test_kmem_cache.h"
+#include "../tests/test_pagefile.h"
 
 struct Test tests[] = {
 		{"3functions", "Env Load: test the creation of new dir, tables and pages WS", tst_three_creation_functions},
@@ -31,6 +34,9 @@ struct Test tests[] = {
 		{"mlfq_sc4","Scenario#4: MLFQ",tst_sc_MLFQ },
 		{"bsd_nice", "BSD Scheduler: check order of running multiple instances of same program with different nice values", tst_bsd_nice},
 		{"priorityRR", "Priority RR Scheduler: check order of running multiple instances of same program with different priority values", tst_priorityRR},
+		/*2025*/{"timers", "Timer Wheel: test the placement of the timers in its levels, their cascading & the next expiry", tst_timer_wheel},
+		/*2025*/{"kmemcache", "Kernel Heap: test the slab caches (alloc/free, alignment, ctor, growing & recycling the slabs)", tst_kmem_cache},
+		/*2025*/{"pfextents", "Page File: test the extents of the disk frames bitmap (contiguous allocation, merging, full page file & its last word)", tst_pagefile_extents},
 
 		//2022
 		{"str2lower", "Test str2lower function", tst_str2lower},
@@ -208,6 +214,39 @@ int tst_priorityRR(int number_of_arguments, char **arguments)
 	}
 	return 0;
 }
+/*2025*/
+int tst_timer_wheel(int number_of_arguments, char **arguments)
+{
+	if (number_of_arguments != 1)
+	{
+		cprintf("Invalid number of arguments! USAGE: tst timers\n");
+		return 0;
+	}
+	test_timer_wheel();
+	return 0;
+}
+/*2025*/
+int tst_kmem_cache(int number_of_arguments, char **arguments)
+{
+	if (number_of_arguments != 1)
+	{
+		cprintf("Invalid number of arguments! USAGE: tst kmemcache\n");
+		return 0;
+	}
+	test_kmem_cache();
+	return 0;
+}
+/*2025*/
+int tst_pagefile_extents(int number_of_arguments, char **arguments)
+{
+	if (number_of_arguments != 1)
+	{
+		cprintf("Invalid number of arguments! USAGE: tst pfextents\n");
+		return 0;
+	}
+	test_pagefile_extents();
+	return 0;
+}
 int tst_str2lower(int number_of_arguments, char **arguments)
 {
 	if (number_of_arguments != 1)
@@ -285,6 +324,11 @@ int tst_dyn_alloc(int number_of_arguments, char **arguments)
 	{
 		test_realloc_block();
 	}
+	// Benchmark of LIST vs BITMAP modes: tst dynalloc bench
+	else if(strcmp(arguments[1], "bench") == 0)
+	{
+		test_dyn_alloc_bench();
+	}
 	return 0;
 }
 
@@ -53,6 +53,10 @@ int tst_kheap(int number_of_arguments, char **arguments);
 
 /*2024*/
 int tst_priorityRR(int number_of_arguments, char **arguments);
+/*2025*/
+int tst_timer_wheel(int number_of_arguments, char **arguments);
+int tst_kmem_cache(int number_of_arguments, char **arguments);
+int tst_pagefile_extents(int number_of_arguments, char **arguments);
 
 
 #endif /* KERN_TESTS_TST_HANDLER_H_ */
@@ -15,6 +15,8 @@
 #include <kern/cpu/cpu.h>
 #include <kern/disk/pagefile_manager.h>
 #include <kern/mem/memory_manager.h>
+#include <kern/mem/reclaimer.h>
+#include <kern/proc/program_cache.h>
 #include "../cons/console.h"
 
 #include <kern/trap/fault_handler.h>
@@ -153,6 +155,9 @@ struct sleeplock __tstslplk__;
 int __numOfSlaves = 0;
 #define __maxNumOfKSems (10)
 struct ksemaphore __ksems[__maxNumOfKSems];
+/*2025*/
+int __firstTimeHeldFrames = 1;
+struct FrameInfo_List __tstHeldFrames;
 void sys_utilities(char* utilityName, int value)
 {
 #if USE_KHEAP
@@ -274,6 +279,11 @@ void sys_utilities(char* utilityName, int value)
 		}
 		cons_unlock();
 	}
+	/*2025*/
+	else if (strcmp(utilityName, "__FastNthClkRepl__") == 0)
+	{
+		setFASTNchanceCLOCK(value != 0);
+	}
 	else if (strcmp(utilityName, "__Sleep__") == 0)
 	{
 		if (__firstTimeSleep)
@@ -461,9 +471,9 @@ void sys_utilities(char* utilityName, int value)
 		int numOfRefs = strtol(tokens[1], NULL, 10);
 		assert(numOfRefs < MAX_REF_CNT);
 		struct Env* env = get_cpu_proc() ;
-		if (numOfRefs != LIST_SIZE(&(env->referenceStreamList)))
+		if (numOfRefs != env->referenceStreamSize)
 		{
-			cprintf("num of references MISMATCHED! Expected = %d, Actual = %d\n", numOfRefs, LIST_SIZE(&(env->referenceStreamList)));
+			cprintf("num of references MISMATCHED! Expected = %d, Actual = %d\n", numOfRefs, env->referenceStreamSize);
 			*correct = 0;
 			return;
 		}
@@ -471,16 +481,14 @@ void sys_utilities(char* utilityName, int value)
 		uint32 *expectedRefStream = (uint32 *)strtol(tokens[2], NULL, 10);
 
 		//Check the expected reference stream against the calculated one
-		struct PageRefElement *curRef = LIST_FIRST(&(env->referenceStreamList));
 		for (int i = 0; i < numOfRefs; ++i)
 		{
-			if (ROUNDDOWN(expectedRefStream[i], PAGE_SIZE) != ROUNDDOWN(curRef->virtual_address, PAGE_SIZE))
+			if (ROUNDDOWN(expectedRefStream[i], PAGE_SIZE) != ROUNDDOWN(env->referenceStream[i], PAGE_SIZE))
 			{
-				cprintf("Ref#%d MISMATCHED! Expected = %d, Actual = %d\n", ROUNDDOWN(expectedRefStream[i], PAGE_SIZE), ROUNDDOWN(curRef->virtual_address, PAGE_SIZE));
+				cprintf("Ref#%d MISMATCHED! Expected = %d, Actual = %d\n", ROUNDDOWN(expectedRefStream[i], PAGE_SIZE), ROUNDDOWN(env->referenceStream[i], PAGE_SIZE));
 				*correct = 0;
 				return;
 			}
-			curRef = LIST_NEXT(curRef);
 		}
 	}
 	else if (strcmp(utilityName, "__InvPage__") == 0)
@@ -523,6 +531,12 @@ void sys_utilities(char* utilityName, int value)
 		{
 			wait_ksemaphore(&(__ksems[semNum]));
 		}
+		/*2025*/ //value: the timeout in ms, set to 1 if it's acquired or 0 if it's timed out
+		else if (strcmp(tokens[2], "WaitTimeout") == 0)
+		{
+			int *val = ((int*)value);
+			*val = wait_ksemaphore_timeout(&(__ksems[semNum]), (uint64)(*val) * 1000000);
+		}
 		else if (strcmp(tokens[2], "Signal") == 0)
 		{
 			signal_ksemaphore(&(__ksems[semNum]));
@@ -533,6 +547,205 @@ void sys_utilities(char* utilityName, int value)
 			*val = __ksems[semNum].count;
 		}
 	}
+	/*2025*/
+	else if (strncmp(utilityName, "__Reclaimer@", strlen("__Reclaimer@")) == 0)
+	{
+		int number_of_tokens;
+		char *tokens[MAX_REF_CNT];
+		strsplit(utilityName, "@", tokens, &number_of_tokens) ;
+		if (__firstTimeHeldFrames)
+		{
+			__firstTimeHeldFrames = 0;
+			LIST_INIT(&__tstHeldFrames);
+		}
+		//value: uint32[2] = {low, high} watermarks (in frames)
+		if (strcmp(tokens[1], "SetWM") == 0)
+		{
+			uint32* wm = (uint32*) value ;
+			_ReclaimLowWatermark = wm[0];
+			_ReclaimHighWatermark = MAX(wm[1], wm[0]);
+		}
+		else if (strcmp(tokens[1], "GetWM") == 0)
+		{
+			uint32* wm = (uint32*) value ;
+			wm[0] = getReclaimLowWatermark();
+			wm[1] = getReclaimHighWatermark();
+		}
+		//tokens[2]: envID, value: the isHandlingFault to set
+		else if (strcmp(tokens[1], "HandlingFault") == 0)
+		{
+			int envID = strtol(tokens[2], NULL, 10);
+			struct Env* env = NULL ;
+			envid2env(envID, &env, 0);
+			assert(env->env_id == envID) ;
+			env->isHandlingFault = value;
+		}
+		//tokens[2]: envID, value: uint32* = # resident pages of its WS (incl. the LRU lists)
+		else if (strcmp(tokens[1], "WSSize") == 0)
+		{
+			int envID = strtol(tokens[2], NULL, 10);
+			struct Env* env = NULL ;
+			envid2env(envID, &env, 0);
+			assert(env->env_id == envID) ;
+			*((uint32*) value) = LIST_SIZE(&(env->page_WS_list)) + LIST_SIZE(&(env->ActiveList)) + LIST_SIZE(&(env->SecondList));
+		}
+		//value: uint32* = 1 if the daemon is sleeping on its channel
+		else if (strcmp(tokens[1], "IsIdle") == 0)
+		{
+			acquire_kspinlock(&ProcessQueues.qlock);
+			{
+				*((uint32*) value) = (ReclaimerDaemon->env_status == ENV_BLOCKED && ReclaimerDaemon->channel == &ReclaimerChannel);
+			}
+			release_kspinlock(&ProcessQueues.qlock);
+		}
+		//value: uint32* = # frames to take from the free list (set to the # taken ones), they're held till "Release"
+		else if (strcmp(tokens[1], "Take") == 0)
+		{
+			uint32* numOfFrames = (uint32*) value ;
+			uint32 numOfTaken = 0;
+			acquire_kspinlock(&MemFrameLists.mfllock);
+			{
+				struct FrameInfo* ptr_fi ;
+				for (; numOfTaken < *numOfFrames && !LIST_EMPTY(&MemFrameLists.free_frame_list); numOfTaken++)
+				{
+					allocate_frame(&ptr_fi) ;
+					LIST_INSERT_HEAD(&__tstHeldFrames, ptr_fi);
+				}
+			}
+			release_kspinlock(&MemFrameLists.mfllock);
+			*numOfFrames = numOfTaken;
+		}
+		//Take ALL the free frames then allocate one more: it should block till the daemon frees some.
+		//value: uint32* = # taken frames before the blocking allocation
+		else if (strcmp(tokens[1], "TakeAllAndWait") == 0)
+		{
+			uint32* numOfTaken = (uint32*) value ;
+			*numOfTaken = 0;
+			struct FrameInfo* ptr_fi ;
+			acquire_kspinlock(&MemFrameLists.mfllock);
+			{
+				while (!LIST_EMPTY(&MemFrameLists.free_frame_list))
+				{
+					allocate_frame(&ptr_fi) ;
+					LIST_INSERT_HEAD(&__tstHeldFrames, ptr_fi);
+					(*numOfTaken)++;
+				}
+			}
+			release_kspinlock(&MemFrameLists.mfllock);
+			allocate_frame(&ptr_fi) ;
+			LIST_INSERT_HEAD(&__tstHeldFrames, ptr_fi);
+		}
+		else if (strcmp(tokens[1], "Release") == 0)
+		{
+			acquire_kspinlock(&MemFrameLists.mfllock);
+			{
+				while (!LIST_EMPTY(&__tstHeldFrames))
+				{
+					struct FrameInfo* ptr_fi = LIST_FIRST(&__tstHeldFrames);
+					LIST_REMOVE(&__tstHeldFrames, ptr_fi);
+					free_frame(ptr_fi);
+				}
+			}
+			release_kspinlock(&MemFrameLists.mfllock);
+		}
+	}
+	else if (strncmp(utilityName, "__ProgCache@", strlen("__ProgCache@")) == 0)
+	{
+		int number_of_tokens;
+		char *tokens[MAX_REF_CNT];
+		strsplit(utilityName, "@", tokens, &number_of_tokens) ;
+		if (strcmp(tokens[1], "Enabled") == 0)
+		{
+			*((uint32*) value) = isProgramCacheEnabled();
+		}
+		//tokens[2]: envID, tokens[3]: va
+		//value: uint32[3] = {is it mapped on the cached frame of its program, refs of its frame, refs of the cached frame (0 if none)}
+		else if (strcmp(tokens[1], "Page") == 0)
+		{
+			int envID = strtol(tokens[2], NULL, 10);
+			uint32 va = ROUNDDOWN((uint32)strtol(tokens[3], NULL, 10), PAGE_SIZE);
+			uint32* info = (uint32*) value ;
+			struct Env* env = NULL ;
+			envid2env(envID, &env, 0);
+			assert(env->env_id == envID) ;
+			uint32 *ptr_page_table = NULL;
+			struct FrameInfo* ptr_fi = get_frame_info(env->env_page_directory, va, &ptr_page_table);
+			struct FrameInfo* cachedFrame = NULL;
+			for (uint32 j = 0; env->progCache != NULL && j < env->progCache->numOfPages; j++)
+				if (env->progCache->pages[j].va == va)
+					cachedFrame = env->progCache->pages[j].frame;
+			info[0] = (ptr_fi != NULL && ptr_fi == cachedFrame);
+			info[1] = ptr_fi != NULL ? ptr_fi->references : 0;
+			info[2] = cachedFrame != NULL ? cachedFrame->references : 0;
+		}
+		//tokens[2], tokens[3]: IDs of 2 envs of the same program
+		//value: uint32[2] = {# pages that both map on the cached frames, # cached frames whose refs != 1 (the cache) + # envs mapping them}
+		else if (strcmp(tokens[1], "Shared") == 0)
+		{
+			struct Env* envPair[2] = {NULL, NULL};
+			for (int k = 0; k < 2; k++)
+			{
+				int envID = strtol(tokens[2+k], NULL, 10);
+				envid2env(envID, &envPair[k], 0);
+				assert(envPair[k]->env_id == envID) ;
+			}
+			uint32* info = (uint32*) value ;
+			info[0] = info[1] = 0;
+			struct ProgramFrameCache* cache = envPair[0]->progCache;
+			assert(cache != NULL && cache == envPair[1]->progCache);
+			for (uint32 j = 0; j < cache->numOfPages; j++)
+			{
+				struct FrameInfo* cachedFrame = cache->pages[j].frame;
+				if (cachedFrame == NULL)
+					continue;
+				uint32 numOfMappings = 0;
+				for (int k = 0; k < 2; k++)
+				{
+					uint32 *ptr_page_table = NULL;
+					if (get_frame_info(envPair[k]->env_page_directory, cache->pages[j].va, &ptr_page_table) == cachedFrame)
+						numOfMappings++;
+				}
+				if (numOfMappings == 2)
+					info[0]++;
+				if (cachedFrame->references != 1 + numOfMappings)
+					info[1]++;
+			}
+		}
+		//tokens[2]: program name, value: int* = # frames in its cache (-1 if it has no cache)
+		else if (strcmp(tokens[1], "Frames") == 0)
+		{
+			struct UserProgramInfo* prog = get_user_program_info(tokens[2]);
+			*((int*) value) = (prog != NULL && prog->frameCache != NULL) ? (int)prog->frameCache->numOfFrames : -1;
+		}
+		//value: uint32* = # freed frames
+		else if (strcmp(tokens[1], "Flush") == 0)
+		{
+			*((uint32*) value) = program_cache_flush();
+		}
+	}
+	else if (strncmp(utilityName, "__ZeroFill@", strlen("__ZeroFill@")) == 0)
+	{
+		int number_of_tokens;
+		char *tokens[MAX_REF_CNT];
+		strsplit(utilityName, "@", tokens, &number_of_tokens) ;
+		if (strcmp(tokens[1], "Enabled") == 0)
+		{
+			*((uint32*) value) = isZeroFillEnabled();
+		}
+		//value: uint32[4] = {[in] va (of the current env), [out] is it mapped on the zero frame,
+		//	[out] refs of its frame (0 if not mapped), [out] refs of the zero frame}
+		else if (strcmp(tokens[1], "Page") == 0)
+		{
+			uint32* info = (uint32*) value ;
+			uint32 va = ROUNDDOWN(info[0], PAGE_SIZE);
+			struct Env* env = get_cpu_proc() ;
+			uint32 *ptr_page_table = NULL;
+			struct FrameInfo* ptr_fi = get_frame_info(env->env_page_directory, va, &ptr_page_table);
+			info[1] = (ptr_fi != NULL && ptr_fi == get_zero_frame_info());
+			info[2] = ptr_fi != NULL ? ptr_fi->references : 0;
+			info[3] = get_zero_frame_info()->references;
+		}
+	}
 
 	if ((int)value < 0)
 	{
@@ -12,6 +12,10 @@
 #include <kern/disk/pagefile_manager.h>
 #include <kern/mem/memory_manager.h>
 #include <kern/mem/kheap.h>
+#include <kern/mem/kmem_cache.h>
+#include <kern/mem/writeback.h>
+#include "page_trace.h"
+#include <kern/proc/program_cache.h>
 
 //2014 Test Free(): Set it to bypass the PAGE FAULT on an instruction with this length and continue executing the next one
 // 0 means don't bypass the PAGE FAULT
@@ -54,10 +58,439 @@ uint8 isBufferingEnabled(){  return _EnableBuffering ; }
 void setModifiedBufferLength(uint32 length) { _ModifiedBufferLength = length;}
 uint32 getModifiedBufferLength() { return _ModifiedBufferLength;}
 
+//===============================
+// FAULT-AROUND
+//===============================
+/*2025*/
+void setFaultAroundWindow(uint32 numOfPages) { _FaultAroundWindow = MIN(numOfPages, FAULT_AROUND_MAX_WINDOW);}
+uint32 getFaultAroundWindow() { return _FaultAroundWindow;}
+
+//Account a prefetched page on its first check: referenced (hit) or about to be evicted before use (miss)
+void fault_around_account(struct Env* e, uint32 virtual_address, uint32 perms)
+{
+	if (perms & PERM_PREFETCHED)
+	{
+		if (perms & PERM_USED)
+			e->nFaultAroundHits++;
+		else
+			e->nFaultAroundMisses++;
+		pt_set_page_permissions(e->env_page_directory, virtual_address, 0, PERM_PREFETCHED);
+	}
+}
+
+static void fault_around(struct Env* e, uint32 fault_va);
+
+//===============================
+// LAZY ZERO-FILL
+//===============================
+/*2025*/
+void enableZeroFill(uint32 enableIt){_EnableZeroFill = enableIt;}
+uint8 isZeroFillEnabled(){  return _EnableZeroFill ; }
+
+//The shared zero frame: the same one the program loader fills the bss from (see ptr_zero_page).
+//	Its own reference is kept since the frames init, so unmapping it never frees it
+struct FrameInfo* get_zero_frame_info() { return to_frame_info(PAGE_SIZE); }
+
+//Is the given page in the user heap or the stack? (a page of them that's not in the page file is a fresh page)
+static uint8 is_heap_or_stack_page(uint32 va)
+{
+	return (va >= USER_HEAP_START && va < USER_HEAP_MAX) || (va >= USTACKBOTTOM && va < USTACKTOP);
+}
+
+//Read fault on a fresh heap/stack page (not in the page file): map it on the shared zero frame (read-only),
+//	so no frame is allocated for it. A page that's never written stays clean, so it's dropped on its eviction
+//	& never stored in the page file.
+//Returns 0 if it's not such a fault
+static int zero_fill_map_fresh_page(struct Env* e, uint32 fault_va, uint8 isWrite)
+{
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+	if (!isZeroFillEnabled() || isWrite || !is_heap_or_stack_page(va) || pf_get_env_page_dfn(e, va) != 0)
+		return 0;
+	map_frame(e->env_page_directory, get_zero_frame_info(), va, PERM_USER | PERM_USED);
+	e->nZeroMappedPages++;
+	return 1;
+}
+
+//The faulted page is not in the page file & its new frame is already mapped: a fresh heap/stack page
+//	is zero-filled, a page of the env program is loaded from its cache, any other page is an invalid
+//	access (the env is killed)
+static void fault_fresh_page(struct Env* e, uint32 fault_va, uint8 isWrite)
+{
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+	if (is_heap_or_stack_page(va))
+	{
+		if (isZeroFillEnabled())
+			memset((void*)va, 0, PAGE_SIZE);
+	}
+	else if (!program_cache_fresh_page(e, va, isWrite))
+		env_exit();
+}
+
+//Bring the faulted page in: map a new frame with the given perms & read it from the page file
+//	(see fault_fresh_page() if it's not there), unless it's mapped on the zero frame (see zero_fill_map_fresh_page()).
+//	A page that's re-faulted while its dirty frame still waits for the write-back daemon takes it back as is,
+//	with no disk I/O (soft fault).
+//Returns 0 if it's read from the page file, FAULT_PAGE_RECLAIMED if its frame is taken back,
+//	E_PAGE_NOT_EXIST_IN_PF otherwise
+#define FAULT_PAGE_RECLAIMED 1
+static int fault_read_page(struct Env* e, uint32 fault_va, uint32 perms, uint8 isWrite)
+{
+	if ((pt_get_page_permissions(e->env_page_directory, fault_va) & PERM_BUFFERED) && reclaim_buffered_frame(e, fault_va) != NULL)
+	{
+		pt_set_page_permissions(e->env_page_directory, fault_va, perms, 0);
+		e->nSoftPageFaults++;
+		return FAULT_PAGE_RECLAIMED;
+	}
+	if (zero_fill_map_fresh_page(e, fault_va, isWrite))
+		return E_PAGE_NOT_EXIST_IN_PF;
+
+	struct FrameInfo *ptr_frame_info = NULL;
+	allocate_frame(&ptr_frame_info);
+	map_frame(e->env_page_directory, ptr_frame_info, fault_va, perms);
+	int ret = pf_read_env_page(e, (void*)fault_va);
+	if (ret == E_PAGE_NOT_EXIST_IN_PF)
+		fault_fresh_page(e, fault_va, isWrite);
+	return ret;
+}
+
+//Write on a page that's still mapped on the shared zero frame (by the user, or by the kernel on its behalf):
+//	give it its own zeroed frame (copy-on-write), its WS element is kept as is.
+//Returns 0 if it's not such a page
+static int zero_fill_cow(struct Env* e, uint32 fault_va)
+{
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+	uint32 *ptr_page_table = NULL;
+	uint32 perms = pt_get_page_permissions(e->env_page_directory, va);
+	if ((perms & PERM_PRESENT) == 0 || (perms & PERM_WRITEABLE))
+		return 0;
+	if (get_frame_info(e->env_page_directory, va, &ptr_page_table) != get_zero_frame_info())
+		return 0;
+
+	struct FrameInfo *ptr_frame_info = NULL;
+	allocate_frame(&ptr_frame_info);
+	map_frame(e->env_page_directory, ptr_frame_info, va, PERM_USER | PERM_WRITEABLE | PERM_USED);
+	memset((void*)va, 0, PAGE_SIZE);
+	return 1;
+}
+
+//===============================
+// CLOCK SWEEPS
+//===============================
+/*2025*/
+static void clock_sweep_account(uint32 numOfPassedPages)
+{
+	uint32 b = 0;
+	for (; numOfPassedPages > 0 && b < CLOCK_SWEEP_HIST_SIZE - 1; numOfPassedPages >>= 1)
+		b++;
+	ClockSweepHistogram[b]++;
+}
+
+void reset_clock_sweep_histogram()
+{
+	memset(ClockSweepHistogram, 0, sizeof(ClockSweepHistogram));
+}
+
+void print_clock_sweep_histogram()
+{
+	cprintf("CLOCK sweep length (# pages passed before the victim):\n");
+	for (int b = 0; b < CLOCK_SWEEP_HIST_SIZE; b++)
+	{
+		if (b == 0)
+			cprintf("     0        : %d\n", ClockSweepHistogram[b]);
+		else if (b == CLOCK_SWEEP_HIST_SIZE - 1)
+			cprintf("%6d+       : %d\n", 1 << (b-1), ClockSweepHistogram[b]);
+		else
+			cprintf("%6d..%6d: %d\n", 1 << (b-1), (1 << b) - 1, ClockSweepHistogram[b]);
+	}
+}
+
 //===============================
 // FAULT HANDLERS
 //===============================
 
+//Array CLOCK: the same sweep over the env ring, the hand is left at the victim slot (see env_page_ws_replace_element())
+static struct WorkingSetElement* clock_ring_find_victim(struct Env* e)
+{
+	struct WSRingEntry *ring = e->page_WS_ring;
+	uint32 hand = e->page_WS_ring_hand;
+	uint32 numOfPassedPages = 0;
+	while (1)
+	{
+		uint32 *ptr_pte = ring[hand].ptr_pte;
+		if (ptr_pte != NULL && (*ptr_pte & PERM_PRESENT))
+		{
+			if ((*ptr_pte & PERM_USED) == 0)
+				break;
+			fault_around_account(e, ring[hand].virtual_address, *ptr_pte & 0xFFF);
+			*ptr_pte &= ~PERM_USED;
+			tlb_invalidate(e->env_page_directory, (void*)ring[hand].virtual_address);
+		}
+		hand = (hand + 1) % e->page_WS_ring_size;
+		numOfPassedPages++;
+	}
+	e->page_WS_ring_hand = hand;
+	clock_sweep_account(numOfPassedPages);
+	return ring[hand].wse;
+}
+
+//Modified CLOCK: [1] a page with (USED, MODIFIED) = (0, 0) with no change on the way,
+//	else [2] a page with USED = 0 clearing the USED bits on the way, repeated till a victim is found
+static struct WorkingSetElement* modified_clock_ring_find_victim(struct Env* e)
+{
+	struct WSRingEntry *ring = e->page_WS_ring;
+	uint32 n = e->page_WS_ring_size;
+	uint32 hand = e->page_WS_ring_hand;
+	uint32 numOfPassedPages = 0;
+	while (1)
+	{
+		for (uint32 i = 0; i < n; i++, numOfPassedPages++, hand = (hand + 1) % n)
+		{
+			uint32 *ptr_pte = ring[hand].ptr_pte;
+			if (ptr_pte != NULL && (*ptr_pte & PERM_PRESENT) && (*ptr_pte & (PERM_USED | PERM_MODIFIED)) == 0)
+				goto found;
+		}
+		for (uint32 i = 0; i < n; i++, numOfPassedPages++, hand = (hand + 1) % n)
+		{
+			uint32 *ptr_pte = ring[hand].ptr_pte;
+			if (ptr_pte == NULL || (*ptr_pte & PERM_PRESENT) == 0)
+				continue;
+			if ((*ptr_pte & PERM_USED) == 0)
+				goto found;
+			*ptr_pte &= ~PERM_USED;
+			tlb_invalidate(e->env_page_directory, (void*)ring[hand].virtual_address);
+		}
+	}
+found:
+	e->page_WS_ring_hand = hand;
+	clock_sweep_account(numOfPassedPages);
+	return ring[hand].wse;
+}
+
+static struct WorkingSetElement* modified_clock_find_victim(struct Env* e)
+{
+	if (env_page_ws_ring_sync(e))
+		return modified_clock_ring_find_victim(e);
+
+	struct WorkingSetElement *wse = e->page_last_WS_element;
+	uint32 numOfPassedPages = 0;
+	while (1)
+	{
+		//TRY 1: USED = 0 & MODIFIED = 0 (no change on the way)
+		for (int i = 0; i < e->page_WS_max_size; i++, numOfPassedPages++)
+		{
+			uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+			if ((perms & (PERM_USED | PERM_MODIFIED)) == 0)
+				goto found;
+			wse = LIST_NEXT(wse);
+			if (wse == NULL)
+				wse = LIST_FIRST(&(e->page_WS_list));
+		}
+		//TRY 2: USED = 0 (clear all used = 1 on the way)
+		for (int i = 0; i < e->page_WS_max_size; i++, numOfPassedPages++)
+		{
+			uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+			if ((perms & PERM_USED) == 0)
+				goto found;
+			pt_set_page_permissions(e->env_page_directory, wse->virtual_address, 0, PERM_USED);
+			wse = LIST_NEXT(wse);
+			if (wse == NULL)
+				wse = LIST_FIRST(&(e->page_WS_list));
+		}
+	}
+found:
+	clock_sweep_account(numOfPassedPages);
+	return wse;
+}
+
+//CLOCK: sweep from the clock hand, giving a 2nd chance (USED = 0) to each used page till finding an unused one
+static struct WorkingSetElement* clock_find_victim(struct Env* e)
+{
+	if (env_page_ws_ring_sync(e))
+		return clock_ring_find_victim(e);
+
+	struct WS_List *wl = &e->page_WS_list;
+	struct WorkingSetElement *wse = e->page_last_WS_element;
+	uint32 numOfPassedPages = 0;
+	while (1){
+		if (!wse)
+			wse = LIST_FIRST(wl);
+
+		if(!wse)
+			panic("WS is empty");
+
+		uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+
+		if (!(perms & PERM_PRESENT)) {
+			wse = LIST_NEXT(wse);
+			numOfPassedPages++;
+			continue;
+		}
+
+		if (perms & PERM_USED)
+		{
+			fault_around_account(e, wse->virtual_address, perms);
+			pt_set_page_permissions(e->env_page_directory, wse->virtual_address, 0, PERM_USED);
+			wse = LIST_NEXT(wse);
+			numOfPassedPages++;
+		}
+		else
+		{
+			clock_sweep_account(numOfPassedPages);
+			return wse;
+		}
+	}
+}
+
+//Nth chance CLOCK: #sweeps of the hand over an unused page before it's replaced (N),
+//	in the MODIFIED ver. (N < 0), a modified page gets one more sweep to save its write
+static inline uint32 nchance_clock_max_sweeps(uint32 perms)
+{
+	if (page_WS_max_sweeps < 0)
+		return -page_WS_max_sweeps + ((perms & PERM_MODIFIED) ? 1 : 0);
+	return page_WS_max_sweeps;
+}
+
+//FAST Nth chance CLOCK: the same victim & the same final state of the step-by-step sweep, without turning the hand
+//	N times around the WS: [1] one pass finds the #rounds of the hand each page needs till it's replaced
+//	(the first one met with the min #rounds is the victim), [2] another pass applies these rounds at once
+static struct WorkingSetElement* fast_nchance_clock_find_victim(struct Env* e)
+{
+	struct WS_List *wl = &e->page_WS_list;
+	struct WorkingSetElement *start = e->page_last_WS_element ? e->page_last_WS_element : LIST_FIRST(wl);
+	struct WorkingSetElement *wse = start, *victim = NULL;
+	uint32 n = LIST_SIZE(wl);
+	uint32 minRounds = 0xFFFFFFFF, victimIdx = 0;
+
+	for (uint32 i = 0; i < n; i++)
+	{
+		uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+		if (perms & PERM_PRESENT)
+		{
+			uint32 maxSweeps = nchance_clock_max_sweeps(perms);
+			uint32 rounds;
+			if (perms & PERM_USED)	//its 1st visit only clears the USED
+				rounds = MAX(maxSweeps, 1);
+			else
+				rounds = (wse->sweeps_counter + 1 >= maxSweeps) ? 0 : maxSweeps - wse->sweeps_counter - 1;
+			if (rounds < minRounds)
+			{
+				minRounds = rounds;
+				victim = wse;
+				victimIdx = i;
+			}
+		}
+		wse = LIST_NEXT(wse) ? LIST_NEXT(wse) : LIST_FIRST(wl);
+	}
+	if (victim == NULL)
+		panic("Nth chance CLOCK: no page is present in the WS");
+
+	//the pages before the victim are visited (minRounds + 1) times, the ones after it minRounds times
+	wse = start;
+	for (uint32 i = 0; i < n; i++)
+	{
+		uint32 visits = minRounds + (i < victimIdx ? 1 : 0);
+		if (wse != victim && visits > 0)
+		{
+			uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+			if (perms & PERM_USED)
+			{
+				fault_around_account(e, wse->virtual_address, perms);
+				pt_set_page_permissions(e->env_page_directory, wse->virtual_address, 0, PERM_USED);
+				wse->sweeps_counter = visits - 1;
+			}
+			else if (perms & PERM_PRESENT)
+			{
+				wse->sweeps_counter += visits;
+			}
+		}
+		wse = LIST_NEXT(wse) ? LIST_NEXT(wse) : LIST_FIRST(wl);
+	}
+	clock_sweep_account(minRounds * n + victimIdx);
+	return victim;
+}
+
+//Nth chance CLOCK: sweep from the clock hand, a used page is cleared (USED = 0, sweeps = 0),
+//	an unused one is counted till it's left unused for N sweeps
+static struct WorkingSetElement* nchance_clock_find_victim(struct Env* e)
+{
+	if (FASTNchanceCLOCK)
+		return fast_nchance_clock_find_victim(e);
+
+	struct WS_List *wl = &e->page_WS_list;
+	struct WorkingSetElement *wse = e->page_last_WS_element ? e->page_last_WS_element : LIST_FIRST(wl);
+	uint32 numOfPassedPages = 0;
+	while (1)
+	{
+		uint32 perms = pt_get_page_permissions(e->env_page_directory, wse->virtual_address);
+		if (perms & PERM_PRESENT)
+		{
+			if (perms & PERM_USED)
+			{
+				fault_around_account(e, wse->virtual_address, perms);
+				pt_set_page_permissions(e->env_page_directory, wse->virtual_address, 0, PERM_USED);
+				wse->sweeps_counter = 0;
+			}
+			else if (++(wse->sweeps_counter) >= nchance_clock_max_sweeps(perms))
+			{
+				break;
+			}
+		}
+		wse = LIST_NEXT(wse) ? LIST_NEXT(wse) : LIST_FIRST(wl);
+		numOfPassedPages++;
+	}
+	clock_sweep_account(numOfPassedPages);
+	return wse;
+}
+
+//LRU time approx: the page with the min time stamp (the first one met on ties)
+static struct WorkingSetElement* lru_time_find_victim(struct Env* e)
+{
+	struct WorkingSetElement *wse = NULL;
+	struct WorkingSetElement *victim = NULL;
+	uint32 min_age = 0xFFFFFFFF;
+	LIST_FOREACH(wse, &(e->page_WS_list))
+	{
+		if (wse->time_stamp < min_age)
+		{
+			min_age = wse->time_stamp;
+			victim = wse;
+		}
+	}
+	return victim;
+}
+
+//The victim of the current replacement in the page_WS_list (the page buffering uses CLOCK),
+//	NULL if it's not selected by a sweep of the list (e.g. OPTIMAL)
+static struct WorkingSetElement* find_victim(struct Env* e)
+{
+	if (isBufferingEnabled() || isPageReplacmentAlgorithmCLOCK() || isPageReplacmentAlgorithmDynamicLocal())
+		return clock_find_victim(e);
+	if (isPageReplacmentAlgorithmModifiedCLOCK())
+		return modified_clock_find_victim(e);
+	if (isPageReplacmentAlgorithmNchanceCLOCK())
+		return nchance_clock_find_victim(e);
+	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX))
+		return lru_time_find_victim(e);
+	return NULL;
+}
+
+//Evict the page of the victim: a dirty one is written back by the daemon (it keeps the frame till then),
+//	with the page buffering its frame is buffered (see buffer_victim_frame()).
+//	Its WS element is left as is to be replaced by the caller.
+static void evict_victim_page(struct Env* e, struct WorkingSetElement* victim)
+{
+	uint32 victim_va = victim->virtual_address;
+	uint32 victim_perms = pt_get_page_permissions(e->env_page_directory, victim_va);
+	uint32 *ptr_page_table = NULL;
+	fault_around_account(e, victim_va, victim_perms);
+	if (isBufferingEnabled())
+		buffer_victim_frame(e, victim_va, get_frame_info(e->env_page_directory, victim_va, &ptr_page_table));
+	else if (victim_perms & PERM_MODIFIED)
+		writeback_enqueue(e, victim_va, get_frame_info(e->env_page_directory, victim_va, &ptr_page_table));
+	else
+		unmap_frame(e->env_page_directory, victim_va);
+}
+
 //==================
 // [0] INIT HANDLER:
 //==================
@@ -70,6 +503,15 @@ void fault_handler_init()
 	enableBuffering(0);
 	enableModifiedBuffer(0) ;
 	setModifiedBufferLength(1000);
+	setFaultAroundWindow(0);
+	setFASTNchanceCLOCK(0);
+	setPFFParameters(PFF_DEFAULT_WINDOW, PFF_DEFAULT_LOW_THRESHOLD, PFF_DEFAULT_HIGH_THRESHOLD);
+	enableWSRing(0);
+	reset_clock_sweep_histogram();
+	enablePageTrace(0);
+	enablePageTraceCOM1(0);
+	enableZeroFill(0);
+	enableProgramCache(0);
 }
 //==================
 // [1] MAIN HANDLER:
@@ -88,6 +530,7 @@ void fault_handler(struct Trapframe *tf)
 	/******************************************************/
 	// Read processor's CR2 register to find the faulting address
 	uint32 fault_va = rcr2();
+	/*2025*/ uint8 isWrite = (tf->tf_err & FEC_WR) ? 1 : 0;
 	//cprintf("************Faulted VA = %x************\n", fault_va);
 	//	print_trapframe(tf);
 	/******************************************************/
@@ -149,12 +592,27 @@ void fault_handler(struct Trapframe *tf)
 		print_trapframe(tf);
 		panic("faulted env == NULL!");
 	}
+	/*2025*/ //the reclaimer should leave its WS as is till the fault is handled (restored at the end, a kernel fault may be nested)
+	uint8 wasHandlingFault = faulted_env->isHandlingFault;
+	faulted_env->isHandlingFault = 1;
 	//check the faulted address, is it a table or not ?
 	//If the directory entry of the faulted address is NOT PRESENT then
 	if ( (faulted_env->env_page_directory[PDX(fault_va)] & PERM_PRESENT) != PERM_PRESENT)
 	{
 		faulted_env->tableFaultsCounter ++ ;
 		table_fault_handler(faulted_env, fault_va);
+		if (isPageTraceEnabled())
+			page_trace_record(faulted_env, fault_va, PG_TRACE_TABLE);
+	}
+	/*2025*/ //Copy-on-write: a write on a page that's still on a shared read-only frame
+	//	(the zero frame or a frame of the program cache) is not an access violation
+	else if (isZeroFillEnabled() && isWrite && zero_fill_cow(faulted_env, fault_va))
+	{
+		faulted_env->nZeroFillCOWFaults++ ;
+	}
+	else if (isWrite && program_cache_cow(faulted_env, fault_va))
+	{
+		faulted_env->nProgCOWFaults++ ;
 	}
 	else
 	{
@@ -200,13 +658,31 @@ void fault_handler(struct Trapframe *tf)
 //				env_page_ws_print(faulted_env);
 		//int ffb = sys_calculate_free_frames();
 
+		/*2025*/
+		uint32 nSoftPageFaults = faulted_env->nSoftPageFaults;
+#if USE_KHEAP
+		uint8 wsFull = (LIST_SIZE(&(faulted_env->page_WS_list)) >= faulted_env->page_WS_max_size);
+#else
+		uint8 wsFull = 0;
+#endif
+
 		if(isBufferingEnabled())
 		{
-			__page_fault_handler_with_buffering(faulted_env, fault_va);
+			__page_fault_handler_with_buffering(faulted_env, fault_va, isWrite);
 		}
 		else
 		{
-			page_fault_handler(faulted_env, fault_va);
+			page_fault_handler(faulted_env, fault_va, isWrite);
+		}
+
+		if (isPageTraceEnabled())
+		{
+			uint8 type = PG_TRACE_PLACEMENT;
+			if (faulted_env->nSoftPageFaults != nSoftPageFaults)
+				type = PG_TRACE_SOFT;
+			else if (wsFull)
+				type = PG_TRACE_REPLACEMENT;
+			page_trace_record(faulted_env, fault_va, type);
 		}
 
 		//		cprintf("\nPage working set AFTER fault handler...\n");
@@ -215,6 +691,8 @@ void fault_handler(struct Trapframe *tf)
 		//		cprintf("fault handling @%x: difference in free frames (after - before = %d)\n", fault_va, ffa - ffb);
 	}
 
+	/*2025*/ faulted_env->isHandlingFault = wasHandlingFault;
+
 	/*************************************************************/
 	//Refresh the TLB cache
 	tlbflush();
@@ -252,99 +730,386 @@ void table_fault_handler(struct Env * curenv, uint32 fault_va)
  *
  * 	IMPORTANT: This function SHOULD NOT change any of the given lists
  */
-int get_optimal_num_faults(struct WS_List *initWorkingSet, int maxWSSize, struct PageRef_List *pageReferences)
+//OPTIMAL (Belady) simulator ===================================================
+//Max-heap of the next-use times (ref indices) of the resident pages. Each next use (< n) belongs to one page only,
+//	so pos[t] (heap index of the key t, -1 if not in the heap) tells whether the page referenced at t is resident.
+#define OPTIMAL_NEVER	0xFFFFFFFF
+
+static void optimal_heap_swap(uint32 *heap, int32 *pos, uint32 i, uint32 j)
+{
+	uint32 tmp = heap[i];
+	heap[i] = heap[j];
+	heap[j] = tmp;
+	pos[heap[i]] = i;
+	pos[heap[j]] = j;
+}
+
+static void optimal_heap_sift_up(uint32 *heap, int32 *pos, uint32 i)
+{
+	while (i > 0 && heap[(i-1)/2] < heap[i])
+	{
+		optimal_heap_swap(heap, pos, i, (i-1)/2);
+		i = (i-1)/2;
+	}
+}
+
+static void optimal_heap_sift_down(uint32 *heap, int32 *pos, uint32 size, uint32 i)
+{
+	while (1)
+	{
+		uint32 largest = i, l = 2*i + 1, r = 2*i + 2;
+		if (l < size && heap[l] > heap[largest])
+			largest = l;
+		if (r < size && heap[r] > heap[largest])
+			largest = r;
+		if (largest == i)
+			return;
+		optimal_heap_swap(heap, pos, i, largest);
+		i = largest;
+	}
+}
+
+//remove the key at heap index i
+static void optimal_heap_remove(uint32 *heap, int32 *pos, uint32 *size, uint32 i)
+{
+	pos[heap[i]] = -1;
+	(*size)--;
+	if (i == *size)
+		return;
+	heap[i] = heap[*size];
+	pos[heap[i]] = i;
+	optimal_heap_sift_up(heap, pos, i);
+	optimal_heap_sift_down(heap, pos, *size, pos[heap[i]]);
+}
+
+static void optimal_heap_push(uint32 *heap, int32 *pos, uint32 *size, uint32 key)
+{
+	heap[*size] = key;
+	pos[key] = *size;
+	(*size)++;
+	optimal_heap_sift_up(heap, pos, *size - 1);
+}
+
+//order of the ref indices by (VA, index)
+static inline int optimal_ref_before(uint32 *refs, uint32 i, uint32 j)
+{
+	return refs[i] < refs[j] || (refs[i] == refs[j] && i < j);
+}
+
+static void optimal_sort_sift_down(uint32 *refs, uint32 *idx, uint32 size, uint32 i)
+{
+	while (1)
+	{
+		uint32 largest = i, l = 2*i + 1, r = 2*i + 2;
+		if (l < size && optimal_ref_before(refs, idx[largest], idx[l]))
+			largest = l;
+		if (r < size && optimal_ref_before(refs, idx[largest], idx[r]))
+			largest = r;
+		if (largest == i)
+			return;
+		uint32 tmp = idx[i]; idx[i] = idx[largest]; idx[largest] = tmp;
+		i = largest;
+	}
+}
+
+//heap sort of the ref indices by (VA, index), in place
+static void optimal_sort_refs(uint32 *refs, uint32 *idx, uint32 n)
+{
+	for (uint32 i = n/2; i > 0; i--)
+		optimal_sort_sift_down(refs, idx, n, i - 1);
+	for (uint32 size = n - 1; size > 0; size--)
+	{
+		uint32 tmp = idx[0]; idx[0] = idx[size]; idx[size] = tmp;
+		optimal_sort_sift_down(refs, idx, size, 0);
+	}
+}
+
+//Number of page faults of the OPTIMAL replacement on the given reference stream, starting by the given WS.
+//	[1] one sort of the refs by (VA, index) gives the next use of each ref & the first use of each initial WS page,
+//	[2] then each fault evicts the resident page with the farthest next use from the heap (pages never used again first)
+//	O(n log n) time, 2 words per ref
+int get_optimal_num_faults(struct WS_List *initWorkingSet, int maxWSSize, uint32 *pageReferences, uint32 numOfReferences)
 {
 	//TODO: [PROJECT'25.IM#1] FAULT HANDLER II - #2 get_optimal_num_faults
-	//Your code is here
-	//Comment the following line
-	//panic("get_optimal_num_faults() is not implemented yet...!!");
-    struct WS_List tempWS;
-    LIST_INIT(&tempWS);
-    struct WorkingSetElement *orig, *copy;
-    LIST_FOREACH(orig, initWorkingSet)
-    {
-        copy = (struct WorkingSetElement*) kmalloc(sizeof(struct WorkingSetElement));
-        copy->virtual_address = orig->virtual_address;
-        LIST_INSERT_TAIL(&tempWS, copy);
-    }
-
-    int faults = 0;
-    struct PageRefElement *ref;
-    LIST_FOREACH(ref, pageReferences)
-    {
-        uint32 va = ref->virtual_address;
-        int found = 0;
-        struct WorkingSetElement *ws_e;
-        LIST_FOREACH(ws_e, &tempWS)
-        {
-            if (ws_e->virtual_address == va)
-            {
-                found = 1;
-                break;
-            }
-        }
-        if (found)
-            continue;
-        faults++;
-        if (LIST_SIZE(&tempWS) < maxWSSize)
-        {
-           struct WorkingSetElement *newItem = (struct WorkingSetElement*) kmalloc(sizeof(struct WorkingSetElement));
-            newItem->virtual_address = va;
-            LIST_INSERT_TAIL(&tempWS, newItem);
-            continue;
-        }
-        int far = -1;
-        struct WorkingSetElement *victim = NULL;
-        LIST_FOREACH(ws_e, &tempWS)
-        {
-            int dis = 0;
-            int found_again = 0;
-            struct PageRefElement *future = ref->prev_next_info.le_next;
-            while (future)
-            {
-                if (future->virtual_address == ws_e->virtual_address)
-                {
-                    found_again = 1;
-                    break;
-                }
-                dis++;
-                future = future->prev_next_info.le_next;
-            }
-
-            if (!found_again)
-            {
-                victim = ws_e;
-                far = 1000000000;
-                break;
-            }
-            else if (dis > far)
-            {
-                far = dis;
-                victim = ws_e;
-            }
-        }
-        LIST_REMOVE(&tempWS, victim);
-        kfree(victim);
-        struct WorkingSetElement *new_item = (struct WorkingSetElement*) kmalloc(sizeof(struct WorkingSetElement));
-        new_item->virtual_address = va;
-        LIST_INSERT_TAIL(&tempWS, new_item);
-    }
-    while (!LIST_EMPTY(&tempWS))
-    {
-        struct WorkingSetElement *ptr = LIST_FIRST(&tempWS);
-        LIST_REMOVE(&tempWS, ptr);
-        kfree(ptr);
-    }
-
-    return faults;
+	uint32 n = numOfReferences;
+	if (n == 0)
+		return 0;
+	uint32 *nextUse = kmalloc(n * sizeof(uint32));
+	int32 *pos = kmalloc(n * sizeof(int32));
+	uint32 *heap = kmalloc(MAX((uint32)maxWSSize, LIST_SIZE(initWorkingSet)) * sizeof(uint32));
+	if (nextUse == NULL || pos == NULL || heap == NULL)
+		panic("get_optimal_num_faults(): NOT ENOUGH KERNEL HEAP SPACE");
+
+	//[1] next use of each ref (pos is used as the sorted index array here)
+	uint32 *idx = (uint32*) pos;
+	for (uint32 i = 0; i < n; i++)
+		idx[i] = i;
+	optimal_sort_refs(pageReferences, idx, n);
+	for (uint32 k = 0; k < n; k++)
+	{
+		if (k + 1 < n && pageReferences[idx[k+1]] == pageReferences[idx[k]])
+			nextUse[idx[k]] = idx[k+1];
+		else
+			nextUse[idx[k]] = OPTIMAL_NEVER;
+	}
+
+	//the initial WS pages are resident till their first use (binary search in the sorted refs)
+	uint32 heapSize = 0, numOfDeadPages = 0;
+	struct WorkingSetElement *wse;
+	LIST_FOREACH(wse, initWorkingSet)
+	{
+		uint32 lo = 0, hi = n;
+		while (lo < hi)
+		{
+			uint32 mid = (lo + hi) / 2;
+			if (pageReferences[idx[mid]] < wse->virtual_address)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo < n && pageReferences[idx[lo]] == wse->virtual_address)
+			heap[heapSize++] = idx[lo];
+		else
+			numOfDeadPages++;
+	}
+	for (uint32 i = 0; i < n; i++)
+		pos[i] = -1;
+	uint32 numOfInitPages = heapSize;
+	heapSize = 0;
+	for (uint32 i = 0; i < numOfInitPages; i++)
+	{
+		if (pos[heap[i]] < 0)
+			optimal_heap_push(heap, pos, &heapSize, heap[i]);
+	}
+
+	//[2] simulate
+	int faults = 0;
+	for (uint32 t = 0; t < n; t++)
+	{
+		if (pos[t] >= 0)
+		{
+			//hit: the page is resident till its next use
+			optimal_heap_remove(heap, pos, &heapSize, pos[t]);
+		}
+		else
+		{
+			faults++;
+			if (heapSize + numOfDeadPages >= maxWSSize)
+			{
+				if (numOfDeadPages > 0)
+					numOfDeadPages--;
+				else
+					optimal_heap_remove(heap, pos, &heapSize, 0);
+			}
+		}
+		if (nextUse[t] == OPTIMAL_NEVER)
+			numOfDeadPages++;
+		else
+			optimal_heap_push(heap, pos, &heapSize, nextUse[t]);
+	}
+
+	kfree(nextUse);
+	kfree(pos);
+	kfree(heap);
+	return faults;
+}
+
+
+
+//LRU lists: the ActiveList (FIFO) holds the PRESENT pages, the SecondList (LRU) holds the pages that are still in memory
+//	but with PRESENT = 0, so a reference to one of them faults & moves it back to the Active head without any disk I/O
+
+//Remove the victim from the given list (dirty ones are written back by the daemon)
+static void lru_lists_evict(struct Env* e, struct WS_List* list, struct WorkingSetElement* victim)
+{
+	uint32 victim_va = victim->virtual_address;
+	uint32 victim_perms = pt_get_page_permissions(e->env_page_directory, victim_va);
+	fault_around_account(e, victim_va, victim_perms);
+	if (victim_perms & PERM_MODIFIED)
+	{
+		uint32 *ptr_table = NULL;
+		writeback_enqueue(e, victim_va, get_frame_info(e->env_page_directory, victim_va, &ptr_table));
+	}
+	else
+	{
+		unmap_frame(e->env_page_directory, victim_va);
+	}
+	LIST_REMOVE(list, victim);
+	env_page_ws_list_free_element(e, victim);
+}
+
+//Make a room at the Active head: its tail goes to the Second head (PRESENT = 0), evicting the Second tail if it's full
+static void lru_lists_make_room_in_active(struct Env* e)
+{
+	if (LIST_SIZE(&(e->ActiveList)) < e->ActiveListSize)
+		return;
+	struct WorkingSetElement *last = LIST_LAST(&(e->ActiveList));
+	if (e->SecondListSize == 0)
+	{
+		lru_lists_evict(e, &(e->ActiveList), last);
+		return;
+	}
+	if (LIST_SIZE(&(e->SecondList)) >= e->SecondListSize)
+		lru_lists_evict(e, &(e->SecondList), LIST_LAST(&(e->SecondList)));
+
+	LIST_REMOVE(&(e->ActiveList), last);
+	pt_set_page_permissions(e->env_page_directory, last->virtual_address, 0, PERM_PRESENT);
+	LIST_INSERT_HEAD(&(e->SecondList), last);
+}
+
+static void lru_lists_page_fault(struct Env* e, uint32 fault_va, uint8 isWrite)
+{
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+
+	//[1] Soft fault: the page is in the SecondList
+	struct WorkingSetElement *wse = env_page_ws_list_find_element(e, va);
+	if (wse != NULL)
+	{
+		LIST_REMOVE(&(e->SecondList), wse);
+		lru_lists_make_room_in_active(e);
+		pt_set_page_permissions(e->env_page_directory, va, PERM_PRESENT | PERM_USED, 0);
+		LIST_INSERT_HEAD(&(e->ActiveList), wse);
+		e->nSoftPageFaults++;
+		return;
+	}
+
+	//[2] Hard fault: read it from the page file (unless its dirty frame still waits for the write-back daemon)
+	lru_lists_make_room_in_active(e);
+
+	int ret = fault_read_page(e, va, PERM_USER | PERM_WRITEABLE | PERM_USED, isWrite);
+	LIST_INSERT_HEAD(&(e->ActiveList), env_page_ws_list_create_element(e, va));
+	if (ret != FAULT_PAGE_RECLAIMED)
+		e->nHardPageFaults++;
+	if (ret == 0 && getFaultAroundWindow() > 0)
+		fault_around(e, va);
+}
+
+//Append the page to the env reference stream, doubling its array when it's full
+static void optimal_add_reference(struct Env* e, uint32 virtual_address)
+{
+	if (e->referenceStreamSize == e->referenceStreamCapacity)
+	{
+		uint32 newCapacity = (e->referenceStreamCapacity == 0) ? OPTIMAL_REF_STREAM_INIT_SIZE : 2 * e->referenceStreamCapacity;
+		uint32 *newStream = krealloc(e->referenceStream, newCapacity * sizeof(uint32));
+		if (newStream == NULL)
+			panic("optimal_add_reference(): NOT ENOUGH KERNEL HEAP SPACE");
+		e->referenceStream = newStream;
+		e->referenceStreamCapacity = newCapacity;
+	}
+	e->referenceStream[e->referenceStreamSize++] = virtual_address;
 }
 
+//Fault-around ===============================================================
+//Put the prefetched page at va in the WS & map a new frame for it with the given perms:
+//	- LRU lists: at the SecondList head (PRESENT = 0, see fault_around()), evicting the Second tail if it's full
+//	- others: in a free room of the WS, or in place of the victim of the current replacement
+//Returns 0 (nothing is changed) if there's no place for it other than the one of the faulted page
+//	or of a page prefetched before it (in [start_va, va))
+static int fault_around_place(struct Env* e, uint32 fault_page, uint32 start_va, uint32 va, uint32 perms)
+{
+	struct WorkingSetElement *victim = NULL;
+	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+	{
+		if (LIST_SIZE(&(e->SecondList)) >= e->SecondListSize)
+			lru_lists_evict(e, &(e->SecondList), LIST_LAST(&(e->SecondList)));
+	}
+	else if (LIST_SIZE(&(e->page_WS_list)) >= e->page_WS_max_size)
+	{
+		victim = find_victim(e);
+		if (victim == NULL || victim->virtual_address == fault_page ||
+				(victim->virtual_address >= start_va && victim->virtual_address < va))
+			return 0;
+		evict_victim_page(e, victim);
+	}
+
+	struct FrameInfo *ptr_frame_info = NULL;
+	allocate_frame(&ptr_frame_info);
+	map_frame(e->env_page_directory, ptr_frame_info, va, perms);
+
+	struct WorkingSetElement *wse = env_page_ws_list_create_element(e, va);
+	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+	{
+		LIST_INSERT_HEAD(&(e->SecondList), wse);
+	}
+	else if (victim != NULL && isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX))
+	{
+		env_page_ws_invalidate(e, victim->virtual_address);
+		LIST_INSERT_TAIL(&(e->page_WS_list), wse);
+	}
+	else if (victim != NULL)
+	{
+		env_page_ws_replace_element(e, victim, wse);
+		e->prp = 1;
+	}
+	else if (e->prp == 0)
+	{
+		LIST_INSERT_TAIL(&(e->page_WS_list), wse);
+		if (LIST_SIZE(&(e->page_WS_list)) == e->page_WS_max_size)
+		{
+			e->prp = 1;
+			e->page_last_WS_element = LIST_FIRST(&(e->page_WS_list));
+		}
+	}
+	else
+	{
+		LIST_INSERT_BEFORE(&(e->page_WS_list), e->page_last_WS_element, wse);
+	}
+	return 1;
+}
+
+//Bring the next neighbors of the faulted page (already in the WS) that exist in the page file on consecutive
+//	disk frames in ONE disk transfer. They're mapped with the perms of the faulted page & USED = 0,
+//	so they're the first candidates to be replaced if not used. Once the WS is full, each one replaces a victim
+//	of the same sweep that replaced the faulted page (see fault_around_place()).
+static void fault_around(struct Env* e, uint32 fault_va)
+{
+	uint32 fault_page = ROUNDDOWN(fault_va, PAGE_SIZE);
+	uint32 perms = (pt_get_page_permissions(e->env_page_directory, fault_page) & (PERM_USER | PERM_WRITEABLE)) | PERM_PREFETCHED;
+	uint8 isLRULists = isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX);
+	//the faulted page is never replaced by its own neighbors
+	uint32 maxPages = MIN(getFaultAroundWindow(), isLRULists ? e->SecondListSize : e->page_WS_max_size - 1);
+	uint32 start_va = fault_page + PAGE_SIZE;
+	uint32 first_dfn = 0, numOfPages = 0;
+	uint32 *ptr_table = NULL;
+
+	for (; numOfPages < maxPages; numOfPages++)
+	{
+		uint32 va = start_va + numOfPages * PAGE_SIZE;
+		if (va >= USER_TOP)
+			break;
+		if ((e->env_page_directory[PDX(va)] & PERM_PRESENT) == 0)
+			break;
+		if (get_frame_info(e->env_page_directory, va, &ptr_table) != NULL)
+			break;
+		uint32 dfn = pf_get_env_page_dfn(e, va);
+		if (dfn == 0 || (numOfPages > 0 && dfn != first_dfn + numOfPages))
+			break;
+		if (numOfPages == 0)
+			first_dfn = dfn;
+	}
 
+	uint32 numOfPlaced = 0;
+	for (; numOfPlaced < numOfPages; numOfPlaced++)
+	{
+		if (!fault_around_place(e, fault_page, start_va, start_va + numOfPlaced * PAGE_SIZE, perms))
+			break;
+	}
+	if (numOfPlaced == 0)
+		return;
+	pf_read_env_pages(e, start_va, numOfPlaced);
+
+	//the read itself sets their USED bits. In the LRU lists, they wait in the SecondList (PRESENT = 0)
+	for (uint32 i = 0; i < numOfPlaced; i++)
+	{
+		pt_set_page_permissions(e->env_page_directory, start_va + i * PAGE_SIZE, 0, PERM_USED | (isLRULists ? PERM_PRESENT : 0));
+	}
+	e->nFaultAroundPages += numOfPlaced;
+}
 
 struct WS_List temp_ws;
 int temp_WS_OPTIMAL_initialized = 0;
 
-void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
+void page_fault_handler(struct Env * faulted_env, uint32 fault_va, uint8 isWrite)
 {
 #if USE_KHEAP
 
@@ -363,7 +1128,7 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 	            {
 	                struct WorkingSetElement *t = LIST_FIRST(&temp_ws);
 	                LIST_REMOVE(&temp_ws, t);
-	                kfree(t);
+	                kmem_cache_free(ws_element_cache, t);
 	            }
 	            temp_WS_OPTIMAL_initialized = 0;
 	        }
@@ -372,7 +1137,7 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 	        struct WorkingSetElement *orignal, *copy;
 	        LIST_FOREACH(orignal, &(faulted_env->page_WS_list))
 	        {
-	            copy = (struct WorkingSetElement*) kmalloc(sizeof(struct WorkingSetElement));
+	            copy = (struct WorkingSetElement*) kmem_cache_alloc(ws_element_cache);
 	            copy->virtual_address = orignal->virtual_address;
 	            copy->empty = orignal->empty;
 	            copy->time_stamp = orignal->time_stamp;
@@ -389,17 +1154,7 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 
 	    if (frame == NULL)
 	    {
-	    	struct FrameInfo *new_frame = NULL;
-			allocate_frame(&new_frame);
-			map_frame(faulted_env->env_page_directory, new_frame, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT);
-			int retopt = pf_read_env_page(faulted_env, (void*)fault_va);
-
-			if(retopt == E_PAGE_NOT_EXIST_IN_PF){
-				if((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) || (fault_va >= USTACKBOTTOM && fault_va < USTACKTOP)){
-				}else{
-					env_exit();
-				}
-			}
+	    	/*2025*/ fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT, isWrite);
 
 	        pt_set_page_permissions(faulted_env->env_page_directory, rva, PERM_PRESENT, 0);
 	    }
@@ -428,13 +1183,13 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 	            struct WorkingSetElement *t = LIST_FIRST(&temp_ws);
 	            pt_set_page_permissions(faulted_env->env_page_directory, t->virtual_address, 0, PERM_PRESENT);
 	            LIST_REMOVE(&temp_ws, t);
-	            kfree(t);
+	            kmem_cache_free(ws_element_cache, t);
 	        }
 	    }
 
 	    if (!exist)
 	    {
-	        struct WorkingSetElement *new_copy = (struct WorkingSetElement*) kmalloc(sizeof(struct WorkingSetElement));
+	        struct WorkingSetElement *new_copy = (struct WorkingSetElement*) kmem_cache_alloc(ws_element_cache);
 	        new_copy->virtual_address = rva;
 	        new_copy->empty = 0;
 	        new_copy->time_stamp = 0;
@@ -442,10 +1197,13 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 	        LIST_INSERT_TAIL(&temp_ws, new_copy);
 	    }
 
-	    struct PageRefElement *pre = (struct PageRefElement*) kmalloc(sizeof(struct PageRefElement));
-	    pre->virtual_address = rva;
-	    LIST_INSERT_TAIL(&(faulted_env->referenceStreamList), pre);
+	    optimal_add_reference(faulted_env, rva);
 		}
+	/*2025*/
+	else if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+	{
+		lru_lists_page_fault(faulted_env, fault_va, isWrite);
+	}
 	else
 	{
 		struct WorkingSetElement *victimWSElement = NULL;
@@ -456,18 +1214,7 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 		//Your code is here
 		//Comment the following line
 		//panic("page_fault_handler().PLACEMENT is not implemented yet...!!");
-		struct FrameInfo *ptr_on_frame_info = NULL;
-		allocate_frame(&ptr_on_frame_info);
-		map_frame(faulted_env->env_page_directory, ptr_on_frame_info,fault_va, PERM_USER | PERM_WRITEABLE);
-		int retplac = pf_read_env_page(faulted_env, (void*)fault_va);
-		 if (retplac == E_PAGE_NOT_EXIST_IN_PF)
-		 {
-			if ((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) ||(fault_va >= USTACKBOTTOM && fault_va < USTACKTOP))
-			{
-			} else {
-			  env_exit();
-			}
-		  }
+		int retplac = /*2025*/ fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE, isWrite);
 		 struct WorkingSetElement *ptr_last=env_page_ws_list_create_element(faulted_env,fault_va);
 		 if(!ptr_last)
 			 panic("cannot create ws element");
@@ -485,86 +1232,36 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 			 struct WorkingSetElement *clock_ptr=faulted_env->page_last_WS_element;
 			 LIST_INSERT_BEFORE(&faulted_env->page_WS_list,clock_ptr,ptr_last);
 		  }
+		 /*2025*/
+		 if (retplac == 0 && getFaultAroundWindow() > 0)
+			 fault_around(faulted_env, fault_va);
 		}
 		else
 		{
-			if (isPageReplacmentAlgorithmCLOCK())
+			/*2025*/ //Dynamic local: CLOCK within the env WS while its size follows its page fault frequency (see env_page_ws_pff_update())
+			if (isPageReplacmentAlgorithmCLOCK() || isPageReplacmentAlgorithmDynamicLocal())
 			{
 				//TODO: [PROJECT'25.IM#1] FAULT HANDLER II - #3 Clock Replacement
 				//Your code is here
 				//Comment the following line
 				//panic("page_fault_handler().REPLACEMENT is not implemented yet...!!");
-				struct WS_List *wl = &faulted_env->page_WS_list;
-				struct WorkingSetElement *wse = faulted_env->page_last_WS_element;
-				struct WorkingSetElement *victim = NULL;
-				while (1){
-					if (!wse)
-						wse = LIST_FIRST(wl);
-
-					if(!wse)
-						panic("WS is empty");
-
-					uint32 perms = pt_get_page_permissions(faulted_env->env_page_directory, wse->virtual_address);
-
-					if (!(perms & PERM_PRESENT)) {
-						wse = LIST_NEXT(wse);
-						continue;
-					}
-
-					if (perms & PERM_USED)
-					{
-						pt_set_page_permissions(faulted_env->env_page_directory, wse->virtual_address, 0, PERM_USED);
-						wse = LIST_NEXT(wse);
-					}
-					else
-					{
-						victim = wse;
-						break;
-					}
-				}
-
-				uint32 victim_va = victim->virtual_address;
-				uint32 perms = pt_get_page_permissions(faulted_env->env_page_directory, victim_va);
-				uint32 *temp_table = NULL;
-				struct FrameInfo *victim_frame = get_frame_info(faulted_env->env_page_directory, victim_va, &temp_table);
-				//write on disk if modified
-				uint32 victim_perms = pt_get_page_permissions(faulted_env->env_page_directory, victim_va);
-				if (victim_perms & PERM_MODIFIED)
-				{
-					pf_update_env_page(faulted_env, victim_va, victim_frame);
-				}
+				struct WorkingSetElement *victim = clock_find_victim(faulted_env);
 
-			    unmap_frame(faulted_env->env_page_directory, victim_va);
+				//write on disk if modified (by the write-back daemon, it keeps the frame till then)
+				/*2025*/ evict_victim_page(faulted_env, victim);
 				//placement CLOCK
-				struct FrameInfo *new_frame = NULL;
-				allocate_frame(&new_frame);
-				map_frame(faulted_env->env_page_directory, new_frame, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED);
-
-				int retclk = pf_read_env_page(faulted_env, (void*)fault_va);
-				if(retclk == E_PAGE_NOT_EXIST_IN_PF){
-					if((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) || (fault_va >= USTACKBOTTOM && fault_va < USTACKTOP)){
-					}else{
-						env_exit();
-					}
-				}
+				int retrep = /*2025*/ fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED, isWrite);
 
-				struct WorkingSetElement *victim_prev = LIST_PREV(victim);
-				LIST_REMOVE(&faulted_env->page_WS_list, victim);
 				struct WorkingSetElement *n_element = env_page_ws_list_create_element(faulted_env, fault_va);
 				if(!n_element)
 					panic("cannot create WS element for new page");
-				if(!victim_prev)
-					LIST_INSERT_HEAD(&faulted_env->page_WS_list, n_element);
-				else
-					LIST_INSERT_AFTER(&faulted_env->page_WS_list, victim_prev, n_element);
-
-				faulted_env->page_last_WS_element = LIST_NEXT(n_element);
-				if(!faulted_env->page_last_WS_element)
-					faulted_env->page_last_WS_element = LIST_FIRST(&faulted_env->page_WS_list);
+				env_page_ws_replace_element(faulted_env, victim, n_element);
 
 				pt_set_page_permissions(faulted_env->env_page_directory, fault_va, PERM_USED, 0);
 				faulted_env->prp = 1;
-
+				/*2025*/
+				if (retrep == 0 && getFaultAroundWindow() > 0)
+					fault_around(faulted_env, fault_va);
 			}
 			else if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_TIME_APPROX))
 			{
@@ -572,39 +1269,20 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 				//Your code is here
 				//Comment the following line
 				//panic("page_fault_handler().REPLACEMENT is not implemented yet...!!");
-				struct WorkingSetElement *wse = NULL;
-				struct WorkingSetElement *victim = NULL;
-				uint32 min_age = 0xFFFFFFFF;
-
-				LIST_FOREACH(wse, &(faulted_env->page_WS_list))
-				{
-					if(wse->time_stamp < min_age){
-						min_age = wse->time_stamp;
-						victim = wse;
-					}
-				}
+				struct WorkingSetElement *victim = /*2025*/ lru_time_find_victim(faulted_env);
 
 				uint32 victim_va = victim->virtual_address;
 				uint32 *ptr_page_table = NULL;
 				struct FrameInfo *victim_frame = get_frame_info(faulted_env->env_page_directory, victim_va, &ptr_page_table);
 				uint32 victim_perms = pt_get_page_permissions(faulted_env->env_page_directory, victim_va);
+				fault_around_account(faulted_env, victim_va, victim_perms);
 
 				if(ptr_page_table != NULL && ((victim_perms & PERM_MODIFIED) != 0)){
-					pf_update_env_page(faulted_env, victim_va, victim_frame);
+					writeback_enqueue(faulted_env, victim_va, victim_frame);
 				}
 				env_page_ws_invalidate(faulted_env, victim_va);
 				//placement LRU
-				struct FrameInfo *new_frame = NULL;
-				allocate_frame(&new_frame);
-				map_frame(faulted_env->env_page_directory, new_frame, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT);
-				int retlru = pf_read_env_page(faulted_env, (void*)fault_va);
-
-				if(retlru == E_PAGE_NOT_EXIST_IN_PF){
-					if((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) || (fault_va >= USTACKBOTTOM && fault_va < USTACKTOP)){
-					}else{
-						env_exit();
-					}
-				}
+				int retrep = /*2025*/ fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT, isWrite);
 
 				struct WorkingSetElement *new_wkst_elem = env_page_ws_list_create_element(faulted_env, fault_va);
 				if(new_wkst_elem != NULL){
@@ -615,6 +1293,9 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 				if(LIST_SIZE(&(faulted_env->page_WS_list)) == faulted_env->page_WS_max_size){
 					faulted_env->page_last_WS_element = LIST_FIRST(&(faulted_env->page_WS_list));
 				}
+				/*2025*/
+				if (retrep == 0 && getFaultAroundWindow() > 0)
+					fault_around(faulted_env, fault_va);
 
 			}
 			else if (isPageReplacmentAlgorithmModifiedCLOCK())
@@ -623,94 +1304,91 @@ void page_fault_handler(struct Env * faulted_env, uint32 fault_va)
 				//Your code is here
 				//Comment the following line
 				//panic("page_fault_handler().REPLACEMENT is not implemented yet...!!");
-				struct WorkingSetElement *wse = faulted_env->page_last_WS_element;
-				struct WorkingSetElement *victim = NULL;
-
-				try_again:
-				for (int i = 0; i < faulted_env->page_WS_max_size; i++)
-				{
-				    uint32 va = wse->virtual_address;
-				    uint32 perms = pt_get_page_permissions(faulted_env->env_page_directory, va);
-				    	int used = (perms & PERM_USED);
-				    	int modified = (perms & PERM_MODIFIED);
-				    	if ((used == 0) && (modified == 0))
-				    	{
-				    		victim = wse;
-				    		wse = LIST_NEXT(wse);
-							if(wse == NULL){
-								wse = LIST_FIRST(&faulted_env->page_WS_list);}
-					    	faulted_env->page_last_WS_element= wse;
-				    		break;
-				    	}else{
-							wse = LIST_NEXT(wse);
-				    		if(wse == NULL){
-				    			wse = LIST_FIRST(&faulted_env->page_WS_list);
-				    		}
-				    	}
-				}
-					if(victim == NULL){
-					wse = faulted_env->page_last_WS_element;
-					for (int i = 0; i < faulted_env->page_WS_max_size; i++){
-					//TRY 2 : USED = 0 (clear all used = 1 on the way)
-				    uint32 va = wse->virtual_address;
-				    uint32 perms = pt_get_page_permissions(faulted_env->env_page_directory, va);
-				    int used = (perms & PERM_USED);
-				    if (used!=0){
-				    pt_set_page_permissions(faulted_env->env_page_directory, va, 0, PERM_USED);
-					wse = LIST_NEXT(wse);
-					if(wse == NULL){
-					wse = LIST_FIRST(&faulted_env->page_WS_list);
-					}
-				    }else {
-				    	victim = wse;
-				    	faulted_env->page_last_WS_element= wse;
-				    	uint32 victim_va = victim->virtual_address;
-				    	uint32 *pt = NULL;
-				    	struct FrameInfo *victim_frame = get_frame_info(faulted_env->env_page_directory, victim_va, &pt);
-				    	pt_set_page_permissions(faulted_env->env_page_directory, victim_va, 0, PERM_MODIFIED);
-				    	pf_update_env_page(faulted_env, victim_va, victim_frame);
-				    	wse = LIST_NEXT(wse);
-						if(wse == NULL){
-							wse = LIST_FIRST(&faulted_env->page_WS_list);}
-				    	break;
-				    }
-				  }
-				}
-					if(victim == NULL){
-						goto try_again;
-						}
+				struct WorkingSetElement *victim = modified_clock_find_victim(faulted_env);
 
-					env_page_ws_invalidate(faulted_env, victim->virtual_address);
+				//write on disk if modified (by the write-back daemon, it keeps the frame till then)
+				/*2025*/ evict_victim_page(faulted_env, victim);
 					//placement MODCLOCK
-					struct FrameInfo *new_frame = NULL;
-					allocate_frame(&new_frame);
-					map_frame(faulted_env->env_page_directory, new_frame, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT);
-					int retmod = pf_read_env_page(faulted_env, (void*)fault_va);
-					if(retmod == E_PAGE_NOT_EXIST_IN_PF){
-						if((fault_va >= USER_HEAP_START && fault_va < USER_HEAP_MAX) || (fault_va >= USTACKBOTTOM && fault_va < USTACKTOP)){
-						}else{
-							env_exit();
-						}
-					}
+					int retrep = /*2025*/ fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED | PERM_PRESENT, isWrite);
 					struct WorkingSetElement *new_wkst_elem = env_page_ws_list_create_element(faulted_env, fault_va);
-					if(faulted_env->page_last_WS_element != NULL){
-						LIST_INSERT_BEFORE(&(faulted_env->page_WS_list), faulted_env->page_last_WS_element, new_wkst_elem);
-					}
-					else{
-						LIST_INSERT_TAIL(&(faulted_env->page_WS_list), new_wkst_elem);
-
-						faulted_env->page_last_WS_element = LIST_FIRST(&(faulted_env->page_WS_list));
-					}
+					env_page_ws_replace_element(faulted_env, victim, new_wkst_elem);
 					faulted_env->prp=1;
+					/*2025*/
+					if (retrep == 0 && getFaultAroundWindow() > 0)
+						fault_around(faulted_env, fault_va);
+			}
+			/*2025*/
+			else if (isPageReplacmentAlgorithmNchanceCLOCK())
+			{
+				struct WorkingSetElement *victim = nchance_clock_find_victim(faulted_env);
+
+				//write on disk if modified (by the write-back daemon, it keeps the frame till then)
+				evict_victim_page(faulted_env, victim);
+				//placement Nth chance CLOCK
+				int retrep = fault_read_page(faulted_env, fault_va, PERM_USER | PERM_WRITEABLE | PERM_USED, isWrite);
+				struct WorkingSetElement *new_wkst_elem = env_page_ws_list_create_element(faulted_env, fault_va);
+				env_page_ws_replace_element(faulted_env, victim, new_wkst_elem);
+				faulted_env->prp=1;
+				if (retrep == 0 && getFaultAroundWindow() > 0)
+					fault_around(faulted_env, fault_va);
 			}
 		}
 	}
 #endif
 }
 
-void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va)
+//Page buffering (CLOCK replacement): the victim keeps its frame in the free list (clean) or the modified list (dirty),
+//	so a re-fault on it before its frame is re-allocated is served without any disk I/O (soft fault)
+void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va, uint8 isWrite)
 {
-	panic("this function is not required...!!");
+#if USE_KHEAP
+	uint32 va = ROUNDDOWN(fault_va, PAGE_SIZE);
+	struct WorkingSetElement *victim = NULL;
+
+	//[1] If the WS is full, buffer a victim
+	if (LIST_SIZE(&(curenv->page_WS_list)) >= curenv->page_WS_max_size)
+	{
+		victim = clock_find_victim(curenv);
+		/*2025*/ evict_victim_page(curenv, victim);
+	}
+
+	//[2] Reclaim its frame if still buffered, else read it from the page file
+	int ret = E_PAGE_NOT_EXIST_IN_PF;
+	if (reclaim_buffered_frame(curenv, va) != NULL)
+	{
+		curenv->nSoftPageFaults++;
+	}
+	else
+	{
+		/*2025*/ ret = fault_read_page(curenv, va, PERM_USER | PERM_WRITEABLE | PERM_USED, isWrite);
+		curenv->nHardPageFaults++;
+	}
+
+	//[3] Add it to the WS (in place of the victim, if any)
+	struct WorkingSetElement *wse = env_page_ws_list_create_element(curenv, va);
+	if (victim != NULL)
+	{
+		env_page_ws_replace_element(curenv, victim, wse);
+		curenv->prp = 1;
+	}
+	else if (curenv->prp == 0)
+	{
+		LIST_INSERT_TAIL(&(curenv->page_WS_list), wse);
+		if (LIST_SIZE(&(curenv->page_WS_list)) == curenv->page_WS_max_size)
+		{
+			curenv->prp = 1;
+			curenv->page_last_WS_element = LIST_FIRST(&(curenv->page_WS_list));
+		}
+	}
+	else
+	{
+		LIST_INSERT_BEFORE(&(curenv->page_WS_list), curenv->page_last_WS_element, wse);
+	}
+
+	//[4] Bring its neighbors with it (hard faults only)
+	if (ret == 0 && getFaultAroundWindow() > 0)
+		fault_around(curenv, va);
+#endif
 }
 
 
@@ -19,6 +19,17 @@
 uint32 _EnableModifiedBuffer ;
 uint32 _EnableBuffering ;
 
+/*2025*/
+uint32 _FaultAroundWindow ;				//max # neighbor pages to bring with each page fault (0: disabled)
+#define FAULT_AROUND_MAX_WINDOW	32		//max # pages in one disk transfer (256 sectors)
+
+/*2025*/
+#define CLOCK_SWEEP_HIST_SIZE	16		//bucket i: # CLOCK sweeps that passed [2^(i-1), 2^i) pages before the victim (0: none)
+uint32 ClockSweepHistogram[CLOCK_SWEEP_HIST_SIZE];
+
+/*2025*/
+uint32 _EnableZeroFill ;				//map the fresh heap/stack pages on the shared zero frame till they're written
+
 uint32 _PageRepAlgoType;
 #define PG_REP_LRU_TIME_APPROX 	0x1
 #define PG_REP_LRU_LISTS_APPROX 0x2
@@ -29,6 +40,7 @@ uint32 _PageRepAlgoType;
 #define PG_REP_DYNAMIC_LOCAL 	0x7
 #define PG_REP_OPTIMAL 			0x8
 bool FASTNchanceCLOCK ;
+/*2025*/ #define OPTIMAL_REF_STREAM_INIT_SIZE	1024	//initial # refs of the env reference stream (doubled when it's full)
 
 /*2021*/ int page_WS_max_sweeps;
 
@@ -67,14 +79,34 @@ uint8 isBufferingEnabled() ;
 void setModifiedBufferLength(uint32 length) ;
 uint32 getModifiedBufferLength();
 
+//===============================
+// FAULT-AROUND
+//===============================
+/*2025*/ void setFaultAroundWindow(uint32 numOfPages);
+/*2025*/ uint32 getFaultAroundWindow();
+/*2025*/ void fault_around_account(struct Env* e, uint32 virtual_address, uint32 perms);
+
+//===============================
+// LAZY ZERO-FILL
+//===============================
+/*2025*/ void enableZeroFill(uint32 enableIt);
+/*2025*/ uint8 isZeroFillEnabled();
+/*2025*/ struct FrameInfo* get_zero_frame_info();
+
+//===============================
+// CLOCK SWEEPS
+//===============================
+/*2025*/ void print_clock_sweep_histogram();
+/*2025*/ void reset_clock_sweep_histogram();
+
 //===============================
 // FAULT HANDLERS
 //===============================
 void fault_handler_init();
 void fault_handler(struct Trapframe *);
-void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va);
+void __page_fault_handler_with_buffering(struct Env * curenv, uint32 fault_va, uint8 isWrite);
 void dyn_alloc_local_scope_method(struct Env * curenv, uint32 fault_va);
-void page_fault_handler(struct Env * curenv, uint32 fault_va);
+void page_fault_handler(struct Env * curenv, uint32 fault_va, uint8 isWrite);
 void table_fault_handler(struct Env * curenv, uint32 fault_va);
-/*2025*/ int get_optimal_num_faults(struct WS_List *initWorkingSet, int maxWSSize, struct PageRef_List *pageReferences);
+/*2025*/ int get_optimal_num_faults(struct WS_List *initWorkingSet, int maxWSSize, uint32 *pageReferences, uint32 numOfReferences);
 #endif /* KERN_FAULT_HANDLER_H_ */
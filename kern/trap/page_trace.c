@@ -0,0 +1,123 @@
+/*
+ * page_trace.c
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#include "page_trace.h"
+#include <kern/cpu/sched.h>
+#include <kern/cons/console.h>
+#include <kern/mem/kheap.h>
+#include <kern/trap/fault_handler.h>
+
+//Per-env trace of the page faults: a fixed-size ring of compact records, allocated at the first traced fault
+//	of the env and written from fault_handler(). It can be printed, exported or streamed to COM1 (e.g. to replay
+//	the real workloads offline against the different replacement strategies).
+
+void enablePageTrace(uint32 enableIt){_EnablePageTrace = enableIt;}
+uint8 isPageTraceEnabled(){  return _EnablePageTrace ; }
+
+void enablePageTraceCOM1(uint32 enableIt){_EnablePageTraceCOM1 = enableIt;}
+uint8 isPageTraceCOM1Enabled(){  return _EnablePageTraceCOM1 ; }
+
+static void page_trace_send(uint32 env_id, struct PageTraceRecord* rec)
+{
+	uint32 words[4] = {env_id, rec->tick, rec->virtual_address, rec->ws_size};
+	serial_putc(PAGE_TRACE_MAGIC & 0xFF);
+	serial_putc(PAGE_TRACE_MAGIC >> 8);
+	serial_putc(rec->type);
+	serial_putc(0);
+	for (int w = 0; w < 4; w++)
+	{
+		for (int b = 0; b < 4; b++)
+			serial_putc((words[w] >> (8*b)) & 0xFF);
+	}
+}
+
+//=====================================
+// [1] RECORD A FAULT:
+//=====================================
+void page_trace_record(struct Env* e, uint32 virtual_address, uint8 type)
+{
+	if (e->pageTrace == NULL)
+	{
+		e->pageTrace = kmalloc(PAGE_TRACE_SIZE * sizeof(struct PageTraceRecord));
+		if (e->pageTrace == NULL)
+		{
+			//no room for the trace, don't stop the fault handling for it
+			return;
+		}
+		e->pageTraceNext = 0;
+		e->pageTraceCount = 0;
+	}
+	struct PageTraceRecord* rec = &(e->pageTrace[e->pageTraceNext]);
+	rec->tick = (uint32) ticks;
+	rec->virtual_address = ROUNDDOWN(virtual_address, PAGE_SIZE);
+	if (isPageReplacmentAlgorithmLRU(PG_REP_LRU_LISTS_APPROX))
+		rec->ws_size = LIST_SIZE(&(e->ActiveList)) + LIST_SIZE(&(e->SecondList));
+	else
+	{
+#if USE_KHEAP
+		rec->ws_size = LIST_SIZE(&(e->page_WS_list));
+#else
+		rec->ws_size = 0;
+#endif
+	}
+	rec->type = type;
+	rec->reserved[0] = rec->reserved[1] = rec->reserved[2] = 0;
+
+	e->pageTraceNext = (e->pageTraceNext + 1) % PAGE_TRACE_SIZE;
+	if (e->pageTraceCount < PAGE_TRACE_SIZE)
+		e->pageTraceCount++;
+
+	if (isPageTraceCOM1Enabled())
+		page_trace_send(e->env_id, rec);
+}
+
+void page_trace_free(struct Env* e)
+{
+	if (e->pageTrace != NULL)
+	{
+		kfree(e->pageTrace);
+		e->pageTrace = NULL;
+	}
+	e->pageTraceNext = e->pageTraceCount = 0;
+}
+
+//=====================================
+// [2] DUMP THE TRACE:
+//=====================================
+static char* page_trace_type_name(uint8 type)
+{
+	switch (type)
+	{
+	case PG_TRACE_TABLE:		return "TABLE";
+	case PG_TRACE_PLACEMENT:	return "PLACEMENT";
+	case PG_TRACE_REPLACEMENT:	return "REPLACEMENT";
+	case PG_TRACE_SOFT:			return "SOFT";
+	}
+	return "?";
+}
+
+//print the records of the env from the oldest to the newest
+void page_trace_print(struct Env* e)
+{
+	cprintf("Page trace of env [%d] %s: %d records\n", e->env_id, e->prog_name, e->pageTraceCount);
+	uint32 first = (e->pageTraceNext + PAGE_TRACE_SIZE - e->pageTraceCount) % PAGE_TRACE_SIZE;
+	for (uint32 i = 0; i < e->pageTraceCount; i++)
+	{
+		struct PageTraceRecord* rec = &(e->pageTrace[(first + i) % PAGE_TRACE_SIZE]);
+		cprintf("%d: tick = %d, va = %x, %s, WS size = %d\n", i, rec->tick, rec->virtual_address, page_trace_type_name(rec->type), rec->ws_size);
+	}
+}
+
+//send the records of the env from the oldest to the newest to COM1 (in the stream format)
+//Returns the number of sent records
+uint32 page_trace_export(struct Env* e)
+{
+	uint32 first = (e->pageTraceNext + PAGE_TRACE_SIZE - e->pageTraceCount) % PAGE_TRACE_SIZE;
+	for (uint32 i = 0; i < e->pageTraceCount; i++)
+		page_trace_send(e->env_id, &(e->pageTrace[(first + i) % PAGE_TRACE_SIZE]));
+	return e->pageTraceCount;
+}
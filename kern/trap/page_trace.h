@@ -0,0 +1,58 @@
+/*
+ * page_trace.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: HP
+ */
+
+#ifndef KERN_TRAP_PAGE_TRACE_H_
+#define KERN_TRAP_PAGE_TRACE_H_
+
+#ifndef FOS_KERNEL
+# error "This is a FOS kernel header; user programs should not #include it"
+#endif
+
+#include <inc/types.h>
+#include <inc/environment_definitions.h>
+
+/******************************/
+/*	DATA 					  */
+/******************************/
+//Fault types
+#define PG_TRACE_TABLE			1	//page table is not present
+#define PG_TRACE_PLACEMENT		2	//page brought while the WS has a free room
+#define PG_TRACE_REPLACEMENT	3	//page brought in place of a victim
+#define PG_TRACE_SOFT			4	//[buffering] page reclaimed from the free/modified lists (no disk I/O)
+
+#define PAGE_TRACE_SIZE			4096	//# records in the ring of each env (the oldest are overwritten)
+
+//One traced fault
+struct PageTraceRecord {
+	uint32 tick;			//ticks at the fault (low 32 bits)
+	uint32 virtual_address;	//faulted page
+	uint32 ws_size;			//# pages in the WS after handling the fault (Active + Second lists under the LRU lists)
+	uint8 type;				//PG_TRACE_xxx
+	uint8 reserved[3];		//pads the record to 16 bytes
+};
+
+//COM1 stream: each record is sent as it's recorded in 20 bytes (little endian):
+//	magic (uint16 = PAGE_TRACE_MAGIC), type (uint8), 0 (uint8), env_id, tick, virtual_address, ws_size (uint32 each)
+#define PAGE_TRACE_MAGIC		0x5450	//"PT"
+
+uint32 _EnablePageTrace ;
+uint32 _EnablePageTraceCOM1 ;
+
+/******************************/
+/*	FUNCTIONS				  */
+/******************************/
+void enablePageTrace(uint32 enableIt);
+uint8 isPageTraceEnabled();
+void enablePageTraceCOM1(uint32 enableIt);
+uint8 isPageTraceCOM1Enabled();
+
+void page_trace_record(struct Env* e, uint32 virtual_address, uint8 type);
+void page_trace_free(struct Env* e);
+void page_trace_print(struct Env* e);
+uint32 page_trace_export(struct Env* e);
+
+#endif /* KERN_TRAP_PAGE_TRACE_H_ */
@@ -12,6 +12,7 @@
 #include <kern/cons/console.h>
 #include <kern/conc/channel.h>
 #include <kern/cpu/sched.h>
+#include <kern/cpu/timer_wheel.h>
 #include <kern/cpu/cpu.h>
 #include <kern/disk/pagefile_manager.h>
 #include <kern/mem/memory_manager.h>
@@ -328,6 +329,12 @@ void sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, u
 	struct Env* cur_env = get_cpu_proc();
 	assert(cur_env != NULL);
 
+	if ((src_virtual_address < USER_HEAP_START) || (src_virtual_address + size > USER_HEAP_MAX) || (src_virtual_address + size < src_virtual_address)
+		|| (dst_virtual_address < USER_HEAP_START) || (dst_virtual_address + size > USER_HEAP_MAX) || (dst_virtual_address + size < dst_virtual_address))
+	{
+		cprintf("\nsys_move_user_mem(): ILLEGAL ADDRESS! Process will be terminated...\n");
+		env_exit();
+	}
 	move_user_mem(cur_env, src_virtual_address, dst_virtual_address, size);
 	return;
 }
@@ -341,6 +348,11 @@ void sys_set_uheap_strategy(uint32 heapStrategy)
 {
 	_UHeapPlacementStrategy = heapStrategy;
 }
+/*2025*/
+uint32 sys_get_uheap_da_mode()
+{
+	return get_uheap_da_mode();
+}
 
 /*******************************/
 /* SEMAPHORES SYSTEM CALLS */
@@ -496,7 +508,7 @@ int sys_get_optimal_num_faults()
 			panic("sys_get_optimal_num_faults(): page working set is changed during the OPTIMAL replacement while it's not expected to");
 		}
 	}
-	return get_optimal_num_faults(&(cur_env->page_WS_list), cur_env->page_WS_max_size, &(cur_env->referenceStreamList));
+	return get_optimal_num_faults(&(cur_env->page_WS_list), cur_env->page_WS_max_size, cur_env->referenceStream, cur_env->referenceStreamSize);
 #else
 	panic("MUST ENABLE KHEAP");
 #endif
@@ -508,6 +520,31 @@ void sys_env_set_priority(int32 envID, int priority){
 	env_set_priority(envID,priority);
 }
 
+/*2025*/
+//Add the given increment to the nice value of the current env (clamped to [BSD_NICE_MIN, BSD_NICE_MAX]).
+//	Returns its new nice value (i.e. nice(0) just gets it)
+int sys_nice(int increment)
+{
+	struct Env* cur_env = get_cpu_proc();
+	env_set_nice(cur_env, env_get_nice(cur_env) + increment);
+	return env_get_nice(cur_env);
+}
+
+/*2025*/
+//Block the current env for the given time (in ns): it's woken up by its timer, so it takes no CPU meanwhile
+void sys_sleep_ns(uint64 ns)
+{
+	if (ns == 0)
+		return;
+	sleep_timeout(&TimerSleepChannel, NULL, ns);
+}
+
+//Nanoseconds since the boot (monotonic)
+uint64 sys_get_time_ns()
+{
+	return kclock_now_ns();
+}
+
 
 //====================================
 /*******************************/
@@ -552,6 +589,22 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 			 sys_env_set_priority(a1,a2);
 			 return 0;
 			 break;
+	/*2025*/
+	case SYS_nice:
+		return sys_nice((int)a1);
+		break;
+	case SYS_sleep_ns:
+		sys_sleep_ns(((uint64)a2 << 32) | a1);
+		return 0;
+		break;
+	case SYS_get_time_ns:
+	{
+		uint64 t = sys_get_time_ns();
+		*((uint32*)a1) = (uint32)t;
+		*((uint32*)a2) = (uint32)(t >> 32);
+		return 0;
+		break;
+	}
 	//=============================================
 	case SYS_allocate_user_mem:
 		sys_allocate_user_mem(a1, a2);
@@ -680,6 +733,9 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 		sys_move_user_mem(a1, a2, a3);
 		return 0;
 		break;
+	case SYS_sbrk:
+		return (uint32)sys_sbrk((int)a1);
+		break;
 	case SYS_rcr2:
 		return sys_rcr2();
 		break;
@@ -709,12 +765,18 @@ uint32 syscall(uint32 syscallno, uint32 a1, uint32 a2, uint32 a3, uint32 a4, uin
 		sys_set_uheap_strategy(a1);
 		return 0;
 
+	case SYS_get_uheap_da_mode:
+		return sys_get_uheap_da_mode();
+
 	case SYS_check_LRU_lists:
 		return sys_check_LRU_lists((uint32*)a1, (uint32*)a2, (int)a3, (int)a4);
 
 	case SYS_check_LRU_lists_free:
 		return sys_check_LRU_lists_free((uint32*)a1, (int)a2);
 
+	case SYS_check_LRU_lists_invariants:
+		return sys_check_LRU_lists_invariants();
+
 	case SYS_check_WS_list:
 		return sys_check_WS_list((uint32*)a1, (int)a2, (uint32)a3, (bool)a4);
 
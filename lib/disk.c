@@ -45,6 +45,7 @@ void ide_init()
 	{
 		irq_install_handler(14, &disk_interrupt_handler);
 		init_channel(&DISKchannel, "DISK channel");
+		/*2025*/ set_channel_io_wait(&DISKchannel, 1);
 		init_kspinlock(&DISKlock, "DISK channel lock");
 		init_sleeplock(&DISKmutex, "DISK mutex");
 	}
@@ -52,6 +53,7 @@ void ide_init()
 	{
 		irq_install_handler(14, &disk_interrupt_handler);
 		init_ksemaphore(&DISKsem, 0, "DISK semaphore");
+		/*2025*/ set_channel_io_wait(&(DISKsem.chan), 1);
 		init_ksemaphore(&DISKmutex, 1, "DISK mutex");
 	}
 #endif
@@ -1,5 +1,6 @@
 #include <inc/assert.h>
 #include <inc/string.h>
+#include <inc/x86.h>
 #include "../inc/dynamic_allocator.h"
 
 //==================================================================================//
@@ -48,6 +49,10 @@ void initialize_dynamic_allocator(uint32 daStart, uint32 daEnd) {
 		LIST_INIT(&freeBlockLists[i]);
 	}
 
+	for (int i = 0; i <= LOG2_MAX_SIZE - LOG2_MIN_SIZE; i++) {
+		LIST_INIT(&partialPagesLists[i]);
+	}
+
 	LIST_INIT(&freePagesList);
 
 	int numPages = (daEnd - daStart) / PAGE_SIZE;
@@ -55,6 +60,7 @@ void initialize_dynamic_allocator(uint32 daStart, uint32 daEnd) {
 	for (int i = 0; i < numPages; i++) {
 		pageBlockInfoArr[i].block_size = 0;
 		pageBlockInfoArr[i].num_of_free_blocks = 0;
+		pageBlockInfoArr[i].free_map = 0;
 
 		LIST_INSERT_TAIL(&freePagesList, &pageBlockInfoArr[i]);
 	}
@@ -112,6 +118,110 @@ void get_size_and_index(uint32 size, uint32* alloc_size, int* index) {
 	}
 }
 
+//===========================
+// BITMAP MODE HELPERS:
+//===========================
+//Pages of more than 32 blocks keep their bitmap (1 bit per block) at the start of the page
+//itself, so the first few blocks are reserved for it and never given to the user.
+static inline uint32 bitmap_reserved_blocks(uint32 block_size) {
+	uint32 num_of_blocks = PAGE_SIZE / block_size;
+	if (num_of_blocks <= 32)
+		return 0;
+	return ROUNDUP((num_of_blocks / 32) * sizeof(uint32), block_size) / block_size;
+}
+
+static void *alloc_block_bitmap(uint32 alloc_size, int index) {
+	struct PageInfoElement *pageInfo = LIST_FIRST(&partialPagesLists[index]);
+	if (pageInfo == NULL) {
+		if (!LIST_EMPTY(&freePagesList)) {
+			// get first free page & mark all of its (non-reserved) blocks as free
+			pageInfo = LIST_FIRST(&freePagesList);
+			LIST_REMOVE(&freePagesList, pageInfo);
+			uint32 page_va = to_page_va(pageInfo);
+			get_page((void*) page_va);
+			uint32 num_of_blocks = PAGE_SIZE / alloc_size;
+			uint32 reserved = bitmap_reserved_blocks(alloc_size);
+			pageInfo->block_size = alloc_size;
+			pageInfo->num_of_free_blocks = num_of_blocks - reserved;
+			if (num_of_blocks <= 32) {
+				pageInfo->free_map = (num_of_blocks == 32) ? 0xFFFFFFFF : (1 << num_of_blocks) - 1;
+			} else {
+				uint32 *map = (uint32 *) page_va;
+				uint32 num_of_words = num_of_blocks / 32;
+				for (int w = 0; w < num_of_words; w++)
+					map[w] = 0xFFFFFFFF;
+				// reserved blocks are always in word 0
+				map[0] &= ~((1 << reserved) - 1);
+				pageInfo->free_map = (num_of_words == 32) ? 0xFFFFFFFF : (1 << num_of_words) - 1;
+			}
+			LIST_INSERT_HEAD(&partialPagesLists[index], pageInfo);
+		} else {
+			// No any free pages left: search for higher size level
+			for (int i = index + 1; i <= LOG2_MAX_SIZE - LOG2_MIN_SIZE; i++) {
+				if (!LIST_EMPTY(&partialPagesLists[i])) {
+					pageInfo = LIST_FIRST(&partialPagesLists[i]);
+					index = i;
+					break;
+				}
+			}
+			if (pageInfo == NULL)
+				return NULL;
+		}
+	}
+
+	// find-first-set in the page bitmap
+	uint32 page_va = to_page_va(pageInfo);
+	uint32 blk;
+	if (PAGE_SIZE / pageInfo->block_size <= 32) {
+		blk = bsf(pageInfo->free_map);
+		pageInfo->free_map &= ~(1 << blk);
+	} else {
+		uint32 *map = (uint32 *) page_va;
+		uint32 w = bsf(pageInfo->free_map);
+		uint32 b = bsf(map[w]);
+		map[w] &= ~(1 << b);
+		if (map[w] == 0)
+			pageInfo->free_map &= ~(1 << w);
+		blk = w * 32 + b;
+	}
+	pageInfo->num_of_free_blocks--;
+	if (pageInfo->num_of_free_blocks == 0)
+		LIST_REMOVE(&partialPagesLists[index], pageInfo);
+
+	return (void*) (page_va + blk * pageInfo->block_size);
+}
+
+static void free_block_bitmap(void *va, int index) {
+	struct PageInfoElement *page = to_page_info((uint32) va);
+	uint32 page_va = to_page_va(page);
+	uint32 num_of_blocks = PAGE_SIZE / page->block_size;
+	uint32 blk = ((uint32) va - page_va) / page->block_size;
+
+	if (num_of_blocks <= 32) {
+		page->free_map |= (1 << blk);
+	} else {
+		uint32 *map = (uint32 *) page_va;
+		map[blk / 32] |= (1 << (blk % 32));
+		page->free_map |= (1 << (blk / 32));
+	}
+
+	if (page->num_of_free_blocks == 0)
+		LIST_INSERT_HEAD(&partialPagesLists[index], page);
+	page->num_of_free_blocks++;
+
+	// whole page is free: release it in O(1)
+	if (page->num_of_free_blocks == num_of_blocks - bitmap_reserved_blocks(page->block_size)) {
+		LIST_REMOVE(&partialPagesLists[index], page);
+		page->block_size = 0;
+		page->num_of_free_blocks = 0;
+		page->free_map = 0;
+
+		return_page((void*) page_va);
+
+		LIST_INSERT_TAIL(&freePagesList, page);
+	}
+}
+
 void *alloc_block(uint32 size) {
 	{
 		assert(size <= DYN_ALLOC_MAX_BLOCK_SIZE);
@@ -129,6 +239,9 @@ void *alloc_block(uint32 size) {
 	get_size_and_index(size, &alloc_size, &index);
 	//cprintf("size : %d and index : %d",alloc_size,index);
 
+	if (dynAllocMode == DA_MODE_BITMAP)
+		return alloc_block_bitmap(alloc_size, index);
+
 	// If there is a free block in this category of sizes
 	/* =========================================================================== */
 	/* ================================== CASE_1 ================================= */
@@ -210,6 +323,11 @@ void free_block(void *va) {
 	uint32 alloc_size = -1;
 	get_size_and_index(block_size, &alloc_size, &index);
 
+	if (dynAllocMode == DA_MODE_BITMAP) {
+		free_block_bitmap(va, index);
+		return;
+	}
+
 	struct BlockElement *block = (struct BlockElement *) va;
 	LIST_INSERT_HEAD(&freeBlockLists[index], block);
 
@@ -242,9 +360,33 @@ void free_block(void *va) {
 //===========================
 // [1] REALLOCATE BLOCK:
 //===========================
+//	Resize the block at "va" to "new_size" bytes inside the DA.
+//	Returns NULL (and "va" remains valid) if new_size exceeds DYN_ALLOC_MAX_BLOCK_SIZE
+//	or no block is available, so that the caller can move it to the page allocator.
 void *realloc_block(void* va, uint32 new_size) {
 //TODO: [PROJECT'25.BONUS#2] KERNEL REALLOC - realloc_block
-//Your code is here
-//Comment the following line
-	panic("realloc_block() Not implemented yet");
+	if (va == NULL)
+		return alloc_block(new_size);
+	if (new_size == 0)
+	{
+		free_block(va);
+		return NULL;
+	}
+	if (new_size > DYN_ALLOC_MAX_BLOCK_SIZE)
+		return NULL;
+
+	uint32 old_size = get_block_size(va);
+	uint32 alloc_size;
+	int index;
+	get_size_and_index(new_size, &alloc_size, &index);
+	//same size class: nothing to do
+	if (alloc_size == old_size)
+		return va;
+
+	void* new_va = alloc_block(new_size);
+	if (new_va == NULL)
+		return NULL;
+	memcpy(new_va, va, MIN(old_size, alloc_size));
+	free_block(va);
+	return new_va;
 }
@@ -48,6 +48,14 @@ libmain(int argc, char **argv)
 			{
 				cprintf("Num of PAGE faults = %d, modif = %d\n", myEnv->pageFaultsCounter, myEnv->nModifiedPages);
 				cprintf("# PAGE IN (from disk) = %d, # PAGE OUT (on disk) = %d, # NEW PAGE ADDED (on disk) = %d\n", myEnv->nPageIn, myEnv->nPageOut,myEnv->nNewPageAdded);
+				if (myEnv->nFaultAroundPages > 0)
+					cprintf("# FAULT-AROUND pages = %d, hits = %d, misses = %d\n", myEnv->nFaultAroundPages, myEnv->nFaultAroundHits, myEnv->nFaultAroundMisses);
+				if (myEnv->nSoftPageFaults + myEnv->nHardPageFaults > 0)
+					cprintf("# SOFT faults (from buffers) = %d, # HARD faults (from disk) = %d\n", myEnv->nSoftPageFaults, myEnv->nHardPageFaults);
+				if (myEnv->nZeroMappedPages + myEnv->nZeroFillCOWFaults > 0)
+					cprintf("# ZERO-MAPPED pages = %d, # ZERO-FILL COW faults = %d\n", myEnv->nZeroMappedPages, myEnv->nZeroFillCOWFaults);
+				if (myEnv->nProgCachePages + myEnv->nProgCOWFaults > 0)
+					cprintf("# PROGRAM CACHED pages = %d, # PROGRAM COW faults = %d\n", myEnv->nProgCachePages, myEnv->nProgCOWFaults);
 			}
 			//cprintf("Num of freeing scarce memory = %d, freeing full working set = %d\n", myEnv->freeingScarceMemCounter, myEnv->freeingFullWSCounter);
 			cprintf("Num of clocks = %d\n", myEnv->nClocks);
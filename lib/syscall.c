@@ -185,6 +185,12 @@ struct uint64 sys_get_virtual_time()
 	return result;
 }
 
+/*2025*/
+void* sys_sbrk(int numOfPages)
+{
+	return (void*)syscall(SYS_sbrk, (uint32)numOfPages, 0, 0, 0, 0);
+}
+
 // 2014
 void sys_move_user_mem(uint32 src_virtual_address, uint32 dst_virtual_address, uint32 size)
 {
@@ -241,6 +247,11 @@ void sys_set_uheap_strategy(uint32 heapStrategy)
 	return ;
 }
 
+uint32 sys_get_uheap_da_mode()
+{
+	return syscall(SYS_get_uheap_da_mode, 0, 0, 0, 0, 0);
+}
+
 //2020
 int sys_check_LRU_lists(uint32* active_list_content, uint32* second_list_content, int actual_active_list_size, int actual_second_list_size)
 {
@@ -252,6 +263,12 @@ int sys_check_LRU_lists_free(uint32* list_content, int list_size)
 	return syscall(SYS_check_LRU_lists_free, (uint32)list_content, (uint32)list_size , 0, 0, 0);
 }
 
+//2025
+int sys_check_LRU_lists_invariants()
+{
+	return syscall(SYS_check_LRU_lists_invariants, 0, 0, 0, 0, 0);
+}
+
 int sys_check_WS_list(uint32* WS_list_content, int actual_WS_list_size, uint32 last_WS_element_content, bool chk_in_order)
 {
 	return syscall(SYS_check_WS_list, (uint32)WS_list_content, (uint32)actual_WS_list_size , last_WS_element_content, (uint32)chk_in_order, 0);
@@ -292,5 +309,24 @@ void sys_env_set_priority(int32 envID, int priority)
 	syscall(SYS_env_set_priority, envID, priority, 0, 0, 0);
 		return ;
 }
+
+/*2025*/
+int sys_nice(int increment)
+{
+	return syscall(SYS_nice, increment, 0, 0, 0, 0);
+}
+
+/*2025*/
+void sys_sleep_ns(uint64 ns)
+{
+	syscall(SYS_sleep_ns, (uint32)ns, (uint32)(ns >> 32), 0, 0, 0);
+}
+
+uint64 sys_get_time_ns()
+{
+	uint32 low, hi;
+	syscall(SYS_get_time_ns, (uint32)&low, (uint32)&hi, 0, 0, 0);
+	return ((uint64)hi << 32) | low;
+}
 //=============================================
 
@@ -21,6 +21,12 @@ static struct UserChunksList UserChunks;
 //uint32 uheapPlaceStategy =0;
 
 
+//pages of the DA area are taken from the kernel in batches by moving its break (sys_sbrk)
+#define UHEAP_SBRK_BATCH	16
+static uint32 uheapDABreak;
+//bit i is set if page i of the DA area (below the break) was returned to the kernel
+static uint32 uheapDAReturned[DYN_ALLOC_MAX_SIZE / PAGE_SIZE / 32];
+
 static struct UserHeapChunk chunkspool[MAX_USER_CHUNKS];
 static int next_chunk_index=0;
 
@@ -45,12 +51,15 @@ void uheap_init()
 {
 	if(__firstTimeFlag)
 	{
+		/*2025*/ //the DA mode should be set BEFORE initializing it
+		set_dyn_alloc_mode(sys_get_uheap_da_mode());
 		initialize_dynamic_allocator(USER_HEAP_START, USER_HEAP_START + DYN_ALLOC_MAX_SIZE);
 		uheapPlaceStrategy = sys_get_uheap_strategy();
 		uheapPageAllocStart = dynAllocEnd + PAGE_SIZE;
 		uheapPageAllocBreak = uheapPageAllocStart;
 		LIST_INIT(&UserChunks);
 		next_chunk_index=0;
+		uheapDABreak = (uint32)sys_sbrk(0);
 
 		__firstTimeFlag = 0;
 	}
@@ -59,11 +68,26 @@ void uheap_init()
 //==============================================
 // [2] GET A PAGE FROM THE KERNEL FOR DA:
 //==============================================
+//	The pages are only marked by the kernel, their frames are allocated on the first access
 int get_page(void* va)
 {
-	int ret = __sys_allocate_page(ROUNDDOWN(va, PAGE_SIZE), PERM_USER|PERM_WRITEABLE|PERM_UHPAGE);
-	if (ret < 0)
-		panic("get_page() in user: failed to allocate page from the kernel");
+	uint32 page_va = ROUNDDOWN((uint32)va, PAGE_SIZE);
+	uint32 idx = (page_va - dynAllocStart) >> PGSHIFT;
+	if (page_va >= uheapDABreak)
+	{
+		//move the break to cover this page and the next batch
+		uint32 numOfPages = ROUNDUP((page_va + PAGE_SIZE - uheapDABreak) / PAGE_SIZE, UHEAP_SBRK_BATCH);
+		if (numOfPages > (dynAllocEnd - uheapDABreak) / PAGE_SIZE)
+			numOfPages = (dynAllocEnd - uheapDABreak) / PAGE_SIZE;
+		if (sys_sbrk(numOfPages) == (void*)-1)
+			panic("get_page() in user: failed to allocate page from the kernel");
+		uheapDABreak += numOfPages * PAGE_SIZE;
+	}
+	else if (uheapDAReturned[idx / 32] & (1 << (idx % 32)))
+	{
+		sys_allocate_user_mem(page_va, PAGE_SIZE);
+		uheapDAReturned[idx / 32] &= ~(1 << (idx % 32));
+	}
 	return 0;
 }
 
@@ -72,9 +96,10 @@ int get_page(void* va)
 //==============================================
 void return_page(void* va)
 {
-	int ret = __sys_unmap_frame(ROUNDDOWN((uint32)va, PAGE_SIZE));
-	if (ret < 0)
-		panic("return_page() in user: failed to return a page to the kernel");
+	uint32 page_va = ROUNDDOWN((uint32)va, PAGE_SIZE);
+	uint32 idx = (page_va - dynAllocStart) >> PGSHIFT;
+	sys_free_user_mem(page_va, PAGE_SIZE);
+	uheapDAReturned[idx / 32] |= (1 << (idx % 32));
 }
 
 //==================================================================================//
@@ -93,6 +118,14 @@ void* malloc(uint32 size)
 	//==============================================================
 	//TODO: [PROJECT'25.IM#2] USER HEAP - #1 malloc
 	//Your code is here
+	//small objects: served by the DA inside the process (no syscall unless it needs a new page)
+	if (size <= DYN_ALLOC_MAX_BLOCK_SIZE)
+	{
+		void* blk = alloc_block(size);
+		if (blk != NULL)
+			return blk;
+	}
+
 	uint32 alloc_size=ROUNDUP(size,PAGE_SIZE);
 	struct UserHeapChunk* ch;
 	struct UserHeapChunk* best=NULL;//worst fit
@@ -183,7 +216,7 @@ void free(void* virtual_address)
 	//TODO: [PROJECT'25.IM#2] USER HEAP - #3 free
 	//Your code is here
 	uint32 va = (uint32)virtual_address;
-	if (va >= USER_HEAP_START && va < (USER_HEAP_START + DYN_ALLOC_MAX_SIZE))
+	if (va >= dynAllocStart && va < dynAllocEnd)
 	{
 		free_block(virtual_address);
 		return;
@@ -489,13 +522,114 @@ void* sget(int32 ownerEnvID, char *sharedVarName)
 //		which switches to the kernel mode, calls move_user_mem(...)
 //		in "kern/mem/chunk_operations.c", then switch back to the user mode here
 //	the move_user_mem() function is empty, make sure to implement it.
+
+//move the content of a block/chunk to a new allocation of "new_size" (memcpy)
+static void *realloc_copy(void *virtual_address, uint32 old_size, uint32 new_size)
+{
+	void* new_va = malloc(new_size);
+	if (new_va == NULL)
+		return NULL;
+	memcpy(new_va, virtual_address, MIN(old_size, new_size));
+	free(virtual_address);
+	return new_va;
+}
+
 void *realloc(void *virtual_address, uint32 new_size)
 {
 	//==============================================================
 	//DON'T CHANGE THIS CODE========================================
 	uheap_init();
 	//==============================================================
-	panic("realloc() is not implemented yet...!!");
+	if (virtual_address == NULL)
+		return malloc(new_size);
+	if (new_size == 0)
+	{
+		free(virtual_address);
+		return NULL;
+	}
+
+	uint32 va = (uint32)virtual_address;
+	//block: resize it inside the DA, else promote it to the page allocator
+	if (va >= dynAllocStart && va < dynAllocEnd)
+	{
+		if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE)
+		{
+			void* blk = realloc_block(virtual_address, new_size);
+			if (blk != NULL)
+				return blk;
+		}
+		return realloc_copy(virtual_address, get_block_size(virtual_address), new_size);
+	}
+
+	struct UserHeapChunk* ch;
+	LIST_FOREACH(ch,&UserChunks)
+	{
+		if(ch->startVA==va)
+			break;
+	}
+	if (ch == NULL || ch->isFree)
+		return NULL;
+
+	//fits in a block: demote it to the DA
+	if (new_size <= DYN_ALLOC_MAX_BLOCK_SIZE)
+		return realloc_copy(virtual_address, ch->size, new_size);
+
+	uint32 alloc_size=ROUNDUP(new_size,PAGE_SIZE);
+	if (alloc_size == ch->size)
+		return virtual_address;
+
+	//shrink: split the tail as a new chunk then free it (merges with the next / moves the break down)
+	if (alloc_size < ch->size)
+	{
+		struct UserHeapChunk* rest=allocChunk();
+		if(rest==NULL)
+			return virtual_address;
+		rest->startVA=ch->startVA + alloc_size;
+		rest->size=ch->size - alloc_size;
+		rest->isFree=0;
+		LIST_INSERT_AFTER(&UserChunks,ch,rest);
+		ch->size=alloc_size;
+		free((void*)rest->startVA);
+		return virtual_address;
+	}
+
+	//grow in place: into the free next chunk, or by moving the break up if it's the last one
+	uint32 extra = alloc_size - ch->size;
+	struct UserHeapChunk* next=LIST_NEXT(ch);
+	if (next == NULL && ch->startVA + ch->size == uheapPageAllocBreak)
+	{
+		if (extra <= USER_HEAP_MAX - uheapPageAllocBreak)
+		{
+			sys_allocate_user_mem(uheapPageAllocBreak, extra);
+			uheapPageAllocBreak += extra;
+			ch->size=alloc_size;
+			return virtual_address;
+		}
+	}
+	else if (next != NULL && next->isFree && next->size >= extra)
+	{
+		sys_allocate_user_mem(next->startVA, extra);
+		if (next->size == extra)
+		{
+			LIST_REMOVE(&UserChunks,next);
+		}
+		else
+		{
+			next->startVA += extra;
+			next->size -= extra;
+		}
+		ch->size=alloc_size;
+		return virtual_address;
+	}
+
+	//move: the kernel remaps the frames of the old chunk to the new one (no copy)
+	uint32 old_size = ch->size;
+	void* new_va = malloc(new_size);
+	if (new_va == NULL)
+		return NULL;
+	sys_move_user_mem(va, (uint32)new_va, old_size);
+	free(virtual_address);
+	return new_va;
 }
 
 
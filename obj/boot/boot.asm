@@ -0,0 +1,331 @@
+
+obj/boot/boot.out:     file format elf32-i386
+
+
+Disassembly of section .text:
+
+00007c00 <start>:
+# memory can accessed, then calls into C.
+###############################################################################
+	
+.globl start					# Entry point	
+start:		.code16				# This runs in real mode
+		cli				# Disable interrupts
+    7c00:	fa                   	cli
+		cld				# String operations increment
+    7c01:	fc                   	cld
+
+		# Set up the important data segment registers (DS, ES, SS).
+		xorw	%ax,%ax			# Segment number zero
+    7c02:	31 c0                	xor    %eax,%eax
+		movw	%ax,%ds			# -> Data Segment
+    7c04:	8e d8                	mov    %eax,%ds
+		movw	%ax,%es			# -> Extra Segment
+    7c06:	8e c0                	mov    %eax,%es
+		movw	%ax,%ss			# -> Stack Segment
+    7c08:	8e d0                	mov    %eax,%ss
+
+		# Set up the stack pointer, growing downward from 0x7c00.
+		movw	$start,%sp         	# Stack Pointer
+    7c0a:	bc                   	.byte 0xbc
+    7c0b:	00                   	.byte 0x0
+    7c0c:	7c                   	.byte 0x7c
+
+00007c0d <seta20.1>:
+#   and subsequent 80286-based PCs wanted to retain maximum compatibility),
+#   physical address line 20 is tied to low when the machine boots.
+#   Obviously this a bit of a drag for us, especially when trying to
+#   address memory above 1MB.  This code undoes this.
+	
+seta20.1:	inb	$0x64,%al		# Get status
+    7c0d:	e4 64                	in     $0x64,%al
+		testb	$0x2,%al		# Busy?
+    7c0f:	a8 02                	test   $0x2,%al
+		jnz	seta20.1		# Yes
+    7c11:	75 fa                	jne    7c0d <seta20.1>
+		movb	$0xd1,%al		# Command: Write
+    7c13:	b0 d1                	mov    $0xd1,%al
+		outb	%al,$0x64		#  output port
+    7c15:	e6 64                	out    %al,$0x64
+
+00007c17 <seta20.2>:
+seta20.2:	inb	$0x64,%al		# Get status
+    7c17:	e4 64                	in     $0x64,%al
+		testb	$0x2,%al		# Busy?
+    7c19:	a8 02                	test   $0x2,%al
+		jnz	seta20.2		# Yes
+    7c1b:	75 fa                	jne    7c17 <seta20.2>
+		movb	$0xdf,%al		# Enable
+    7c1d:	b0 df                	mov    $0xdf,%al
+		outb	%al,$0x60		#  A20
+    7c1f:	e6 60                	out    %al,$0x60
+
+00007c21 <real_to_prot>:
+#   OK to run code at any address, or write to any address.
+#   The 'gdt' and 'gdtdesc' tables below define these segments.
+#   This code loads them into the processor.
+#   We need this setup to ensure the transition to protected mode is smooth.
+
+real_to_prot:	cli			# Don't allow interrupts: mandatory,
+    7c21:	fa                   	cli
+					# since we didn't set up an interrupt
+					# descriptor table for handling them
+		lgdt	gdtdesc		# load GDT: mandatory in protected mode
+    7c22:	0f 01 16             	lgdtl  (%esi)
+    7c25:	64 7c 0f             	fs jl  7c37 <protcseg+0x1>
+		movl	%cr0, %eax	# Turn on protected mode
+    7c28:	20 c0                	and    %al,%al
+		orl	$CR0_PE_ON, %eax
+    7c2a:	66 83 c8 01          	or     $0x1,%ax
+		movl	%eax, %cr0
+    7c2e:	0f 22 c0             	mov    %eax,%cr0
+
+	        # CPU magic: jump to relocation, flush prefetch queue, and
+		# reload %cs.  Has the effect of just jmp to the next
+		# instruction, but simultaneously loads CS with
+		# $PROT_MODE_CSEG.
+		ljmp	$PROT_MODE_CSEG, $protcseg
+    7c31:	ea                   	.byte 0xea
+    7c32:	36 7c 08             	ss jl  7c3d <protcseg+0x7>
+	...
+
+00007c36 <protcseg>:
+	
+		# we've switched to 32-bit protected mode; tell the assembler
+		# to generate code for that mode
+protcseg:	.code32
+		# Set up the protected-mode data segment registers
+		movw	$PROT_MODE_DSEG, %ax	# Our data segment selector
+    7c36:	66 b8 10 00          	mov    $0x10,%ax
+		movw	%ax, %ds		# -> DS: Data Segment
+    7c3a:	8e d8                	mov    %eax,%ds
+		movw	%ax, %es		# -> ES: Extra Segment
+    7c3c:	8e c0                	mov    %eax,%es
+		movw	%ax, %fs		# -> FS
+    7c3e:	8e e0                	mov    %eax,%fs
+		movw	%ax, %gs		# -> GS
+    7c40:	8e e8                	mov    %eax,%gs
+		movw	%ax, %ss		# -> SS: Stack Segment
+    7c42:	8e d0                	mov    %eax,%ss
+	
+		call cmain			# finish the boot load from C.
+    7c44:	e8 d6 00 00 00       	call   7d1f <cmain>
+
+00007c49 <spin>:
+						# cmain() should not return
+spin:		jmp spin			# ..but in case it does, spin
+    7c49:	eb fe                	jmp    7c49 <spin>
+    7c4b:	90                   	nop
+
+00007c4c <gdt>:
+	...
+    7c54:	ff                   	(bad)
+    7c55:	ff 00                	incl   (%eax)
+    7c57:	00 00                	add    %al,(%eax)
+    7c59:	9a cf 00 ff ff 00 00 	lcall  $0x0,$0xffff00cf
+    7c60:	00                   	.byte 0x0
+    7c61:	92                   	xchg   %eax,%edx
+    7c62:	cf                   	iret
+	...
+
+00007c64 <gdtdesc>:
+    7c64:	17                   	pop    %ss
+    7c65:	00 4c 7c 00          	add    %cl,0x0(%esp,%edi,2)
+	...
+
+00007c6a <waitdisk>:
+
+static __inline uint8
+inb(int port)
+{
+	uint8 data;
+	__asm __volatile("inb %w1,%0" : "=a" (data) : "d" (port));
+    7c6a:	ba f7 01 00 00       	mov    $0x1f7,%edx
+    7c6f:	ec                   	in     (%dx),%al
+
+void
+waitdisk(void)
+{
+	// wait for disk reaady
+	while ((inb(0x1F7) & 0xC0) != 0x40)
+    7c70:	83 e0 c0             	and    $0xffffffc0,%eax
+    7c73:	3c 40                	cmp    $0x40,%al
+    7c75:	75 f8                	jne    7c6f <waitdisk+0x5>
+		/* do nothing */;
+}
+    7c77:	c3                   	ret
+
+00007c78 <readsect>:
+
+void
+readsect(void *dst, uint32 offset)
+{
+    7c78:	55                   	push   %ebp
+    7c79:	89 e5                	mov    %esp,%ebp
+    7c7b:	57                   	push   %edi
+    7c7c:	50                   	push   %eax
+    7c7d:	8b 4d 0c             	mov    0xc(%ebp),%ecx
+	// wait for disk to be ready
+	waitdisk();
+    7c80:	e8 e5 ff ff ff       	call   7c6a <waitdisk>
+}
+
+static __inline void
+outb(int port, uint8 data)
+{
+	__asm __volatile("outb %0,%w1" : : "a" (data), "d" (port));
+    7c85:	b0 01                	mov    $0x1,%al
+    7c87:	ba f2 01 00 00       	mov    $0x1f2,%edx
+    7c8c:	ee                   	out    %al,(%dx)
+    7c8d:	ba f3 01 00 00       	mov    $0x1f3,%edx
+    7c92:	89 c8                	mov    %ecx,%eax
+    7c94:	ee                   	out    %al,(%dx)
+
+	outb(0x1F2, 1);		// count = 1
+	outb(0x1F3, offset);
+	outb(0x1F4, offset >> 8);
+    7c95:	89 c8                	mov    %ecx,%eax
+    7c97:	ba f4 01 00 00       	mov    $0x1f4,%edx
+    7c9c:	c1 e8 08             	shr    $0x8,%eax
+    7c9f:	ee                   	out    %al,(%dx)
+	outb(0x1F5, offset >> 16);
+    7ca0:	89 c8                	mov    %ecx,%eax
+    7ca2:	ba f5 01 00 00       	mov    $0x1f5,%edx
+    7ca7:	c1 e8 10             	shr    $0x10,%eax
+    7caa:	ee                   	out    %al,(%dx)
+	outb(0x1F6, (offset >> 24) | 0xE0);
+    7cab:	89 c8                	mov    %ecx,%eax
+    7cad:	ba f6 01 00 00       	mov    $0x1f6,%edx
+    7cb2:	c1 e8 18             	shr    $0x18,%eax
+    7cb5:	83 c8 e0             	or     $0xffffffe0,%eax
+    7cb8:	ee                   	out    %al,(%dx)
+    7cb9:	b0 20                	mov    $0x20,%al
+    7cbb:	ba f7 01 00 00       	mov    $0x1f7,%edx
+    7cc0:	ee                   	out    %al,(%dx)
+	outb(0x1F7, 0x20);	// cmd 0x20 - read sectors
+
+	// wait for disk to be ready
+	waitdisk();
+    7cc1:	e8 a4 ff ff ff       	call   7c6a <waitdisk>
+	__asm __volatile("cld\n\trepne\n\tinsl"			:
+    7cc6:	b9 80 00 00 00       	mov    $0x80,%ecx
+    7ccb:	8b 7d 08             	mov    0x8(%ebp),%edi
+    7cce:	ba f0 01 00 00       	mov    $0x1f0,%edx
+    7cd3:	fc                   	cld
+    7cd4:	f2 6d                	repnz insl (%dx),%es:(%edi)
+
+	// read a sector
+	insl(0x1F0, dst, SECTSIZE/4);
+}
+    7cd6:	5a                   	pop    %edx
+    7cd7:	5f                   	pop    %edi
+    7cd8:	5d                   	pop    %ebp
+    7cd9:	c3                   	ret
+
+00007cda <readseg>:
+{
+    7cda:	55                   	push   %ebp
+    7cdb:	89 e5                	mov    %esp,%ebp
+    7cdd:	57                   	push   %edi
+    7cde:	56                   	push   %esi
+    7cdf:	53                   	push   %ebx
+    7ce0:	83 ec 0c             	sub    $0xc,%esp
+    7ce3:	8b 5d 08             	mov    0x8(%ebp),%ebx
+	offset = (offset / SECTSIZE) + 1;
+    7ce6:	8b 75 10             	mov    0x10(%ebp),%esi
+	va &= 0xFFFFFF;
+    7ce9:	89 df                	mov    %ebx,%edi
+	offset = (offset / SECTSIZE) + 1;
+    7ceb:	c1 ee 09             	shr    $0x9,%esi
+	va &= ~(SECTSIZE - 1);
+    7cee:	81 e3 00 fe ff 00    	and    $0xfffe00,%ebx
+	va &= 0xFFFFFF;
+    7cf4:	81 e7 ff ff ff 00    	and    $0xffffff,%edi
+	offset = (offset / SECTSIZE) + 1;
+    7cfa:	46                   	inc    %esi
+	end_va = va + count;
+    7cfb:	03 7d 0c             	add    0xc(%ebp),%edi
+	while (va < end_va) {
+    7cfe:	39 fb                	cmp    %edi,%ebx
+    7d00:	73 15                	jae    7d17 <readseg+0x3d>
+		readsect((uint8*) va, offset);
+    7d02:	50                   	push   %eax
+    7d03:	50                   	push   %eax
+    7d04:	56                   	push   %esi
+		offset++;
+    7d05:	46                   	inc    %esi
+		readsect((uint8*) va, offset);
+    7d06:	53                   	push   %ebx
+		va += SECTSIZE;
+    7d07:	81 c3 00 02 00 00    	add    $0x200,%ebx
+		readsect((uint8*) va, offset);
+    7d0d:	e8 66 ff ff ff       	call   7c78 <readsect>
+		offset++;
+    7d12:	83 c4 10             	add    $0x10,%esp
+    7d15:	eb e7                	jmp    7cfe <readseg+0x24>
+}
+    7d17:	8d 65 f4             	lea    -0xc(%ebp),%esp
+    7d1a:	5b                   	pop    %ebx
+    7d1b:	5e                   	pop    %esi
+    7d1c:	5f                   	pop    %edi
+    7d1d:	5d                   	pop    %ebp
+    7d1e:	c3                   	ret
+
+00007d1f <cmain>:
+{
+    7d1f:	55                   	push   %ebp
+    7d20:	89 e5                	mov    %esp,%ebp
+    7d22:	56                   	push   %esi
+    7d23:	53                   	push   %ebx
+	readseg((uint32) ELFHDR, SECTSIZE*8, 0);
+    7d24:	52                   	push   %edx
+    7d25:	6a 00                	push   $0x0
+    7d27:	68 00 10 00 00       	push   $0x1000
+    7d2c:	68 00 00 01 00       	push   $0x10000
+    7d31:	e8 a4 ff ff ff       	call   7cda <readseg>
+	if (ELFHDR->e_magic != ELF_MAGIC)
+    7d36:	83 c4 10             	add    $0x10,%esp
+    7d39:	81 3d 00 00 01 00 7f 	cmpl   $0x464c457f,0x10000
+    7d40:	45 4c 46 
+    7d43:	75 3e                	jne    7d83 <cmain+0x64>
+	ph = (struct Proghdr *) ((uint8 *) ELFHDR + ELFHDR->e_phoff);
+    7d45:	a1 1c 00 01 00       	mov    0x1001c,%eax
+	eph = ph + ELFHDR->e_phnum;
+    7d4a:	0f b7 35 2c 00 01 00 	movzwl 0x1002c,%esi
+	ph = (struct Proghdr *) ((uint8 *) ELFHDR + ELFHDR->e_phoff);
+    7d51:	8d 98 00 00 01 00    	lea    0x10000(%eax),%ebx
+	eph = ph + ELFHDR->e_phnum;
+    7d57:	c1 e6 05             	shl    $0x5,%esi
+    7d5a:	01 de                	add    %ebx,%esi
+	for (; ph < eph; ph++)
+    7d5c:	39 f3                	cmp    %esi,%ebx
+    7d5e:	73 17                	jae    7d77 <cmain+0x58>
+		readseg(ph->p_va, ph->p_memsz, ph->p_offset);
+    7d60:	50                   	push   %eax
+	for (; ph < eph; ph++)
+    7d61:	83 c3 20             	add    $0x20,%ebx
+		readseg(ph->p_va, ph->p_memsz, ph->p_offset);
+    7d64:	ff 73 e4             	push   -0x1c(%ebx)
+    7d67:	ff 73 f4             	push   -0xc(%ebx)
+    7d6a:	ff 73 e8             	push   -0x18(%ebx)
+    7d6d:	e8 68 ff ff ff       	call   7cda <readseg>
+	for (; ph < eph; ph++)
+    7d72:	83 c4 10             	add    $0x10,%esp
+    7d75:	eb e5                	jmp    7d5c <cmain+0x3d>
+	((void (*)(void)) (ELFHDR->e_entry & 0xFFFFFF))();
+    7d77:	a1 18 00 01 00       	mov    0x10018,%eax
+    7d7c:	25 ff ff ff 00       	and    $0xffffff,%eax
+    7d81:	ff d0                	call   *%eax
+}
+
+static __inline void
+outw(int port, uint16 data)
+{
+	__asm __volatile("outw %0,%w1" : : "a" (data), "d" (port));
+    7d83:	ba 00 8a 00 00       	mov    $0x8a00,%edx
+    7d88:	b8 00 8a ff ff       	mov    $0xffff8a00,%eax
+    7d8d:	66 ef                	out    %ax,(%dx)
+    7d8f:	b8 00 8e ff ff       	mov    $0xffff8e00,%eax
+    7d94:	66 ef                	out    %ax,(%dx)
+	while (1)
+    7d96:	eb fe                	jmp    7d96 <cmain+0x77>
@@ -0,0 +1,75 @@
+/* *********************************************************** */
+/* RUN IT WITH A SMALL WS, e.g. run nclkbench 20 */
+/* *********************************************************** */
+/* Benchmarks the Nth chance CLOCK: the same page reference string is replayed for
+ * N = 1..NCLK_MAX_N of the NORMAL & the MODIFIED versions, each reports its
+ * # page faults and # page in/out (the page out is done by the write-back daemon,
+ * so some writes of a run may be counted within the next one) */
+
+#include <inc/lib.h>
+
+#define NCLK_MAX_N 		5
+#define NCLK_HOT_PAGES	8
+#define NCLK_COLD_PAGES	32
+#define NCLK_NUM_OF_REFS 4000
+
+char __arr__[PAGE_SIZE*(NCLK_HOT_PAGES + NCLK_COLD_PAGES)];
+
+static uint32 seed ;
+static uint32 next_rand()
+{
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 16) & 0x7FFF;
+}
+
+//3 of each 4 refs go to the hot pages, the rest scan the cold ones. 1 of each 4 refs is a write
+static void run_workload()
+{
+	int coldIdx = 0;
+	char garbage = 0;
+	seed = 1;
+	for (int i = 0; i < NCLK_NUM_OF_REFS; i++)
+	{
+		int page ;
+		if (next_rand() % 4 != 0)
+			page = next_rand() % NCLK_HOT_PAGES;
+		else
+			page = NCLK_HOT_PAGES + (coldIdx++ % NCLK_COLD_PAGES);
+
+		if (next_rand() % 4 == 0)
+			__arr__[page*PAGE_SIZE] = i ;
+		else
+			garbage += __arr__[page*PAGE_SIZE] ;
+	}
+	__arr__[0] = garbage;
+}
+
+void _main(void)
+{
+	char fastCmd[64] = "__FastNthClkRepl__";
+	for (int fast = 0; fast <= 1; fast++)
+	{
+		sys_utilities(fastCmd, fast);
+		for (int type = 1; type <= 2; type++)
+		{
+			for (int N = 1; N <= NCLK_MAX_N; N++)
+			{
+				char nclkCmd[64] = "__NthClkRepl@";
+				nclkCmd[13] = '0' + type;
+				nclkCmd[14] = '\0';
+				sys_utilities(nclkCmd, N);
+
+				uint32 faults = myEnv->pageFaultsCounter;
+				uint32 pageIn = myEnv->nPageIn;
+				uint32 pageOut = myEnv->nPageOut;
+
+				run_workload();
+
+				atomic_cprintf("%~[%s %s] N = %d: # faults = %d, # page in = %d, # page out = %d\n",
+						fast ? "FAST" : "STEP", type == 1 ? "NORMAL" : "MODIFIED", N,
+						myEnv->pageFaultsCounter - faults, myEnv->nPageIn - pageIn, myEnv->nPageOut - pageOut);
+			}
+		}
+	}
+	return;
+}
@@ -0,0 +1,50 @@
+/* *********************************************************** */
+/* RUN IT WITH THE LRU LISTS REPLACEMENT & A SMALL WS, e.g. lru 2 then run tlruinv 10 */
+/* *********************************************************** */
+/* Keeps referencing more pages than the WS can hold (reads & writes, in forward & backward
+ * scans), so the pages keep being demoted to the Second list, soft faulted back to the
+ * Active list & evicted, and checks the LRU lists invariants after each step */
+
+#include <inc/lib.h>
+
+#define LRUINV_NUM_OF_PAGES	24
+#define LRUINV_NUM_OF_ROUNDS	5
+
+char __arr__[PAGE_SIZE*LRUINV_NUM_OF_PAGES];
+
+static void check_invariants(char* step, int round)
+{
+	if (sys_check_LRU_lists_invariants() != 1)
+		panic("LRU lists invariants are violated after the %s of round #%d", step, round);
+}
+
+void _main(void)
+{
+	char garbage = 0;
+	for (int round = 0; round < LRUINV_NUM_OF_ROUNDS; round++)
+	{
+		//forward scan: write each page
+		for (int i = 0; i < LRUINV_NUM_OF_PAGES; i++)
+			__arr__[i*PAGE_SIZE] = round + i ;
+		check_invariants("forward scan", round);
+
+		//backward scan: read each page (the recent ones are in the Second list)
+		for (int i = LRUINV_NUM_OF_PAGES - 1; i >= 0; i--)
+			garbage += __arr__[i*PAGE_SIZE] ;
+		check_invariants("backward scan", round);
+
+		//re-reference a few pages repeatedly
+		for (int r = 0; r < 4; r++)
+			for (int i = 0; i < 4; i++)
+				garbage += __arr__[(i*(round+1) % LRUINV_NUM_OF_PAGES)*PAGE_SIZE] ;
+		check_invariants("re-references", round);
+	}
+
+	//the written values should survive the evictions
+	for (int i = 0; i < LRUINV_NUM_OF_PAGES; i++)
+		if (__arr__[i*PAGE_SIZE] != (char)(LRUINV_NUM_OF_ROUNDS - 1 + i))
+			panic("wrong value at page #%d after its eviction", i);
+
+	__arr__[0] = garbage;
+	cprintf("Congratulations!! test LRU lists invariants completed successfully.\n");
+}
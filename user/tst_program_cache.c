@@ -0,0 +1,154 @@
+/* *********************************************************** */
+/* RUN IT AFTER ENABLING THE PROGRAM CACHE (progcache 1) ON A FRESH RUN */
+/* *********************************************************** */
+// Test the program frame cache
+// Master program: run 2 instances of the same slave program, then check
+//	1. they share the frames of their program pages (with the right references)
+//	2. a write on a data page of one of them breaks its sharing only
+//	3. flushing the caches frees the frames of the programs that have no env only
+#include <inc/lib.h>
+
+#define PCACHE_SLAVE_PROG	"tPCacheSlave"
+
+static void get_shared_info(int envID1, int envID2, uint32 info[2])
+{
+	char cmd[64] = "__ProgCache@Shared@";
+	char str[12];
+	ltostr(envID1, str); strcconcat(cmd, str, cmd); strcconcat(cmd, "@", cmd);
+	ltostr(envID2, str); strcconcat(cmd, str, cmd);
+	sys_utilities(cmd, (uint32)info);
+}
+static int get_cached_frames(char* progName)
+{
+	int numOfFrames = 0;
+	char cmd[64] = "__ProgCache@Frames@";
+	strcconcat(cmd, progName, cmd);
+	sys_utilities(cmd, (uint32)(&numOfFrames));
+	return numOfFrames;
+}
+static uint32 flush_caches()
+{
+	uint32 numOfFreed = 0;
+	char cmd[64] = "__ProgCache@Flush";
+	sys_utilities(cmd, (uint32)(&numOfFreed));
+	return numOfFreed;
+}
+//wait till the test counter & the sleeping slaves reach the given values
+static void wait_slaves(uint32 tstCnt, int numOfSleeping)
+{
+	int numOfBlockedProcesses = -1;
+	int cnt = 0;
+	while (1)
+	{
+		char cmd[64] = "__GetChanQueueSize__";
+		sys_utilities(cmd, (uint32)(&numOfBlockedProcesses));
+		if (gettst() == tstCnt && numOfBlockedProcesses == numOfSleeping)
+			break;
+		if (cnt++ == 10)
+			panic("%~unexpected state of the slaves. Expected (finished steps, sleeping) = (%d, %d), Actual = (%d, %d)", tstCnt, numOfSleeping, gettst(), numOfBlockedProcesses);
+		env_sleep(1000);
+	}
+}
+
+void
+_main(void)
+{
+	uint32 enabled = 0;
+	{
+		char cmd[64] = "__ProgCache@Enabled";
+		sys_utilities(cmd, (uint32)(&enabled));
+	}
+	if (!enabled)
+	{
+		cprintf_colored(TEXT_TESTERR_CLR, "%~the program cache is disabled: enable it (progcache 1) then run this test again\n");
+		return;
+	}
+
+	int eval = 0;
+	bool correct = 1;
+	rsttst();
+
+	//Run 2 instances of the slave, wait till they read their data pages & sleep
+	int slaves[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		slaves[i] = sys_create_env(PCACHE_SLAVE_PROG, (myEnv->page_WS_max_size), (myEnv->SecondListSize), (myEnv->percentage_of_WS_pages_to_be_removed));
+		if (slaves[i] == E_ENV_CREATION_ERROR)
+			panic("%~insufficient number of processes in the system!");
+		sys_run_env(slaves[i]);
+	}
+	wait_slaves(0, 2);
+
+	//1. Shared frames
+	cprintf_colored(TEXT_cyan,"\n1. Check the 2 instances share the frames of their program [30%]\n");
+	uint32 shared[2];
+	get_shared_info(slaves[0], slaves[1], shared);
+	uint32 numOfShared = shared[0];
+	int numOfCached = get_cached_frames(PCACHE_SLAVE_PROG);
+	{
+		if (numOfShared == 0 || numOfCached <= 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~no shared frames! # shared pages = %d, # cached frames = %d\n", numOfShared, numOfCached); }
+		if (shared[1] != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~%d cached frames have wrong references\n", shared[1]); }
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	//2. Copy on write (checked by the slave itself on its own page)
+	cprintf_colored(TEXT_cyan,"\n2. Write a data page of one instance: only its sharing should be broken [40%]\n");
+	{
+		char cmd[64] = "__WakeupOne__";
+		sys_utilities(cmd, 0);
+		wait_slaves(1, 2);
+		get_shared_info(slaves[0], slaves[1], shared);
+		if (shared[0] != numOfShared - 1)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~wrong # shared pages after the write! Expected = %d, Actual = %d\n", numOfShared - 1, shared[0]); }
+		if (shared[1] != 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~%d cached frames have wrong references after the write\n", shared[1]); }
+		if (get_cached_frames(PCACHE_SLAVE_PROG) != numOfCached)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the cached frame of the written page is dropped\n"); }
+	}
+	if (correct) eval += 40;
+	correct = 1;
+
+	//3. Flush
+	cprintf_colored(TEXT_cyan,"\n3. Flush the caches: only the frames of the programs with no env should be freed [30%]\n");
+	{
+		char masterProg[PROGNAMELEN];
+		strcpy(masterProg, (char*)myEnv->prog_name);
+		int numOfMasterCached = get_cached_frames(masterProg);
+		flush_caches();
+		if (get_cached_frames(PCACHE_SLAVE_PROG) != numOfCached || get_cached_frames(masterProg) != numOfMasterCached)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the cache of a program is flushed while it has running envs\n"); }
+
+		//Let the slaves finish (the 2nd one writes its page first), then free them
+		{
+			char cmd[64] = "__WakeupAll__";
+			sys_utilities(cmd, 0);
+		}
+		wait_slaves(3, 1);
+		{
+			char cmd[64] = "__WakeupAll__";
+			sys_utilities(cmd, 0);
+		}
+		wait_slaves(4, 0);
+		sys_destroy_env(slaves[0]);
+		sys_destroy_env(slaves[1]);
+
+		uint32 freeFramesBefore = sys_calculate_free_frames();
+		uint32 numOfFreed = flush_caches();
+		uint32 freeFramesAfter = sys_calculate_free_frames();
+		if (get_cached_frames(PCACHE_SLAVE_PROG) != -1 || numOfFreed < numOfCached)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the cache of the program with no env is not flushed! # freed frames = %d, Expected >= %d\n", numOfFreed, numOfCached); }
+		if (freeFramesAfter - freeFramesBefore != numOfFreed)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~wrong # freed frames! Expected = %d, Actual = %d\n", numOfFreed, freeFramesAfter - freeFramesBefore); }
+		if (get_cached_frames(masterProg) != numOfMasterCached)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the cache of the running program is flushed\n"); }
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	cprintf_colored(TEXT_light_green, "%~\ntest program cache is finished. Evaluation = %d%\n", eval);
+
+	return;
+}
@@ -0,0 +1,57 @@
+// Test the program frame cache
+// Slave program (2 instances of it run together):
+//	read its data pages & sleep, then write one of them (copy-on-write), sleep again & exit
+#include <inc/lib.h>
+
+#define PCACHE_NUM_OF_PAGES	4
+#define PCACHE_INTS_PER_PAGE	(PAGE_SIZE/sizeof(int))
+
+//initialized: it's in the data segment of the program (a cached page)
+int __data__[PCACHE_NUM_OF_PAGES*PCACHE_INTS_PER_PAGE] = {
+		[0*PCACHE_INTS_PER_PAGE] = 1, [1*PCACHE_INTS_PER_PAGE] = 2,
+		[2*PCACHE_INTS_PER_PAGE] = 3, [3*PCACHE_INTS_PER_PAGE] = 4 };
+
+static void get_page_info(int envID, void* va, uint32 info[3])
+{
+	char cmd[64] = "__ProgCache@Page@";
+	char str[12];
+	ltostr(envID, str); strcconcat(cmd, str, cmd); strcconcat(cmd, "@", cmd);
+	ltostr((uint32)va, str); strcconcat(cmd, str, cmd);
+	sys_utilities(cmd, (uint32)info);
+}
+
+void
+_main(void)
+{
+	int envID = sys_getenvid();
+
+	//1. Read the data pages: they're mapped on the frames of the program cache
+	int sum = 0;
+	for (int i = 0; i < PCACHE_NUM_OF_PAGES; i++)
+		sum += __data__[i*PCACHE_INTS_PER_PAGE];
+	if (sum != 1+2+3+4)
+		panic("%~wrong initial content of the data pages");
+	char cmd1[64] = "__Sleep__";
+	sys_utilities(cmd1, 0);
+
+	//2. Write a data page: it should get its own frame with the pristine content
+	int* ptr = &__data__[1*PCACHE_INTS_PER_PAGE];
+	uint32 before[3], after[3];
+	get_page_info(envID, ptr, before);
+	if (!before[0])
+		panic("%~the data page is not mapped on the cached frame of its program before the write");
+	ptr[1] = envID;
+	get_page_info(envID, ptr, after);
+	if (after[0] || after[1] != 1)
+		panic("%~the written data page is not copied on write! its references = %d", after[1]);
+	if (after[2] != before[2] - 1)
+		panic("%~wrong references of the cached frame after the copy on write! Expected = %d, Actual = %d", before[2] - 1, after[2]);
+	if (ptr[0] != 2 || ptr[1] != envID)
+		panic("%~wrong content of the data page after the copy on write");
+	inctst();
+	char cmd2[64] = "__Sleep__";
+	sys_utilities(cmd2, 0);
+
+	inctst();
+	return;
+}
@@ -0,0 +1,186 @@
+/* *********************************************************** */
+/* MAKE SURE to have a FRESH RUN for this test (no other running programs) */
+/* *********************************************************** */
+// Test the memory reclaimer
+// Master program: run 2 slaves that write their pages then sleep, then
+//	1. take frames above the low watermark: the daemon should stay idle
+//	2. take frames below the low watermark: the daemon should reclaim till the high watermark only
+//	3. take ALL the free frames then allocate one more: it should block till the daemon frees some
+// while one of the slaves is marked in the middle of a page fault: its WS should never be reclaimed
+#include <inc/lib.h>
+
+#define RECL_NUM_OF_SLAVES		2
+#define RECL_SLAVE_WS_SIZE		64
+#define RECL_SLAVE_PERCENTAGE	50
+
+static uint32 get_ws_size(int envID)
+{
+	uint32 size = 0;
+	char cmd[64] = "__Reclaimer@WSSize@";
+	char id[10]; ltostr(envID, id);
+	strcconcat(cmd, id, cmd);
+	sys_utilities(cmd, (uint32)(&size));
+	return size;
+}
+static void set_handling_fault(int envID, int flag)
+{
+	char cmd[64] = "__Reclaimer@HandlingFault@";
+	char id[10]; ltostr(envID, id);
+	strcconcat(cmd, id, cmd);
+	sys_utilities(cmd, flag);
+}
+static void set_watermarks(uint32 low, uint32 high)
+{
+	uint32 wm[2] = {low, high};
+	char cmd[64] = "__Reclaimer@SetWM";
+	sys_utilities(cmd, (uint32)wm);
+}
+static uint32 take_frames(uint32 numOfFrames)
+{
+	char cmd[64] = "__Reclaimer@Take";
+	sys_utilities(cmd, (uint32)(&numOfFrames));
+	return numOfFrames;
+}
+static void release_frames()
+{
+	char cmd[64] = "__Reclaimer@Release";
+	sys_utilities(cmd, 0);
+}
+static uint32 is_reclaimer_idle()
+{
+	uint32 idle = 0;
+	char cmd[64] = "__Reclaimer@IsIdle";
+	sys_utilities(cmd, (uint32)(&idle));
+	return idle;
+}
+
+void
+_main(void)
+{
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+	cprintf_colored(TEXT_yellow,"MAKE SURE to have a FRESH RUN for this test\n(i.e. don't run any program/test before it)\n");
+	cprintf_colored(TEXT_yellow,"==============================================\n");
+
+	int eval = 0;
+	bool correct = 1;
+
+	uint32 savedWM[2];
+	{
+		char cmd[64] = "__Reclaimer@GetWM";
+		sys_utilities(cmd, (uint32)savedWM);
+	}
+	//no reclaim while the slaves are writing their pages
+	set_watermarks(0, 0);
+
+	//Create & run the slaves, wait till they're all sleeping
+	int slaves[RECL_NUM_OF_SLAVES];
+	for (int i = 0; i < RECL_NUM_OF_SLAVES; ++i)
+	{
+		slaves[i] = sys_create_env("tReclSlave", RECL_SLAVE_WS_SIZE, (myEnv->SecondListSize), RECL_SLAVE_PERCENTAGE);
+		if (slaves[i] == E_ENV_CREATION_ERROR)
+			panic("%~insufficient number of processes in the system!");
+		sys_run_env(slaves[i]);
+	}
+	int numOfBlockedProcesses = 0;
+	int cnt = 0;
+	do
+	{
+		env_sleep(1000);
+		if (cnt++ == 10)
+			panic("%~unexpected number of sleeping slaves. Expected = %d, Current = %d", RECL_NUM_OF_SLAVES, numOfBlockedProcesses);
+		char cmd[64] = "__GetChanQueueSize__";
+		sys_utilities(cmd, (uint32)(&numOfBlockedProcesses));
+	} while (numOfBlockedProcesses != RECL_NUM_OF_SLAVES);
+
+	//the 2nd slave is in the middle of a page fault (e.g. blocked on a free frame): it can't be a victim
+	int victimID = slaves[0], skippedID = slaves[1];
+	set_handling_fault(skippedID, 1);
+	uint32 skippedWS = get_ws_size(skippedID);
+
+	//1. Above the low watermark
+	cprintf_colored(TEXT_cyan,"\n1. Take frames above the low watermark: the reclaimer should stay idle [30%]\n");
+	{
+		uint32 victimWS = get_ws_size(victimID);
+		uint32 freeFrames = sys_calculate_free_frames();
+		set_watermarks(freeFrames - 64, freeFrames - 32);
+		uint32 numOfTaken = take_frames(32);
+		env_sleep(1000);
+		if (numOfTaken != 32)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~can't take the frames! Expected = %d, Actual = %d\n", 32, numOfTaken); }
+		if (!is_reclaimer_idle() || get_ws_size(victimID) != victimWS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the reclaimer runs while the free frames are above its low watermark\n"); }
+		release_frames();
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	//2. Below the low watermark
+	cprintf_colored(TEXT_cyan,"\n2. Take frames below the low watermark: the reclaimer should stop at its high watermark [40%]\n");
+	{
+		uint32 victimWS = get_ws_size(victimID);
+		uint32 freeFrames = sys_calculate_free_frames();
+		uint32 low = freeFrames - 16, high = freeFrames - 12;
+		set_watermarks(low, high);
+		uint32 numOfTaken = take_frames(24);
+		uint32 freeAfterTake = freeFrames - numOfTaken;
+		env_sleep(1000);
+		uint32 freeAfterReclaim = sys_calculate_free_frames();
+		uint32 numOfReclaimed = freeAfterReclaim - freeAfterTake;
+		//one round takes this # pages of the victim's WS
+		uint32 chunk = MAX(RECL_SLAVE_PERCENTAGE * victimWS / 100, 1);
+
+		if (!is_reclaimer_idle())
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the reclaimer is still running above its high watermark\n"); }
+		if (freeAfterReclaim < high)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the free frames are below the high watermark after the reclaim! Expected >= %d, Actual = %d\n", high, freeAfterReclaim); }
+		if (numOfReclaimed > (high - freeAfterTake) + chunk)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the reclaimer goes beyond its high watermark! Expected <= %d, Actual = %d\n", (high - freeAfterTake) + chunk, numOfReclaimed); }
+		if (get_ws_size(victimID) >= victimWS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the least recently run slave is not reclaimed\n"); }
+		if (get_ws_size(skippedID) != skippedWS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the WS of the slave in the middle of a fault is reclaimed\n"); }
+		release_frames();
+	}
+	if (correct) eval += 40;
+	correct = 1;
+
+	//3. No free frame
+	cprintf_colored(TEXT_cyan,"\n3. Allocate a frame with NO free frames: it should block till the reclaimer frees some [30%]\n");
+	{
+		uint32 victimWS = get_ws_size(victimID);
+		set_watermarks(0, 8);
+		uint32 numOfTaken = 0;
+		char cmd[64] = "__Reclaimer@TakeAllAndWait";
+		sys_utilities(cmd, (uint32)(&numOfTaken));
+		//here, the frame is allocated: it's freed by the reclaimer from the victim
+		if (numOfTaken == 0)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~can't take the free frames\n"); }
+		if (get_ws_size(victimID) >= victimWS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the blocked allocation is not served from the reclaimed frames\n"); }
+		if (get_ws_size(skippedID) != skippedWS)
+		{ correct = 0; cprintf_colored(TEXT_TESTERR_CLR, "%~the WS of the slave in the middle of a fault is reclaimed\n"); }
+		release_frames();
+	}
+	if (correct) eval += 30;
+	correct = 1;
+
+	//Restore, wakeup the slaves & wait them to check their pages
+	set_handling_fault(skippedID, 0);
+	set_watermarks(savedWM[0], savedWM[1]);
+	rsttst();
+	{
+		char cmd[64] = "__WakeupAll__";
+		sys_utilities(cmd, 0);
+	}
+	cnt = 0;
+	while (gettst() != RECL_NUM_OF_SLAVES)
+	{
+		env_sleep(1000);
+		if (cnt++ == 10)
+			panic("%~not all slaves finished");
+	}
+
+	cprintf_colored(TEXT_light_green, "%~\ntest memory reclaimer is finished. Evaluation = %d%\n", eval);
+
+	return;
+}
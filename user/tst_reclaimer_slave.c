@@ -0,0 +1,31 @@
+// Test the memory reclaimer
+// Slave program: write its pages, sleep till the master finishes, then check them
+#include <inc/lib.h>
+
+#define RECL_NUM_OF_PAGES	48
+
+char __arr__[PAGE_SIZE*RECL_NUM_OF_PAGES];
+
+void
+_main(void)
+{
+	int envID = sys_getenvid();
+
+	//Write all the pages (private dirty frames)
+	for (int i = 0; i < RECL_NUM_OF_PAGES; i++)
+		__arr__[i*PAGE_SIZE] = (char)(envID + i) ;
+
+	//Sleep on the channel: the reclaimer can take its pages meanwhile
+	char cmd[64] = "__Sleep__";
+	sys_utilities(cmd, 0);
+
+	//The reclaimed pages should be read back from the page file
+	for (int i = 0; i < RECL_NUM_OF_PAGES; i++)
+		if (__arr__[i*PAGE_SIZE] != (char)(envID + i))
+			panic("%~wrong value at page #%d after its reclaim", i);
+
+	//indicates finished
+	inctst();
+
+	return;
+}
@@ -0,0 +1,61 @@
+/* *********************************************************** */
+/* Tests the timed sleeps: sys_sleep_ns() & the kernel semaphore wait with a timeout,
+ * their lengths are measured by sys_get_time_ns() */
+/* *********************************************************** */
+
+#include <inc/lib.h>
+
+//a sleep shouldn't end before its time, nor much later (e.g. a few quanta if other envs are running)
+#define SLEEP_MAX_DELAY_NS	(50ULL * 1000000)
+
+static void check_length(char* what, uint64 expected_ns, uint64 start_ns, uint64 end_ns)
+{
+	uint64 elapsed_ns = end_ns - start_ns;
+	if (elapsed_ns < expected_ns)
+		panic("%s: woken up early [expected = %d ns, actual = %d ns]", what, (uint32)expected_ns, (uint32)elapsed_ns);
+	if (elapsed_ns > expected_ns + SLEEP_MAX_DELAY_NS)
+		panic("%s: woken up too late [expected = %d ns, actual = %d ns]", what, (uint32)expected_ns, (uint32)elapsed_ns);
+	cprintf("%s: expected = %d ns, actual = %d ns\n", what, (uint32)expected_ns, (uint32)elapsed_ns);
+}
+
+void _main(void)
+{
+	//1- sys_sleep_ns() of different lengths (within a quantum, a few quanta & more than a whole PIT count)
+	uint64 lengths_ms[] = {1, 5, 20, 100};
+	for (int i = 0; i < sizeof(lengths_ms)/sizeof(lengths_ms[0]); i++)
+	{
+		uint64 ns = lengths_ms[i] * 1000000;
+		uint64 start = sys_get_time_ns();
+		sys_sleep_ns(ns);
+		check_length("sys_sleep_ns", ns, start, sys_get_time_ns());
+	}
+
+	//2- the semaphore wait is timed out if it's not signaled
+	int semVal = 0;
+	char initCmd[64] = "__KSem@0@Init";
+	sys_utilities(initCmd, (uint32)(&semVal));
+
+	char waitCmd[64] = "__KSem@0@WaitTimeout";
+	int timeout_ms = 10;
+	int result = timeout_ms;
+	uint64 start = sys_get_time_ns();
+	sys_utilities(waitCmd, (uint32)(&result));
+	check_length("wait_ksemaphore_timeout", (uint64)timeout_ms * 1000000, start, sys_get_time_ns());
+	if (result != 0)
+		panic("wait_ksemaphore_timeout: acquired while the semaphore is not signaled");
+
+	char getCmd[64] = "__KSem@0@Get";
+	sys_utilities(getCmd, (uint32)(&semVal));
+	if (semVal != 0)
+		panic("wait_ksemaphore_timeout: the semaphore value should be restored after the timeout [expected = 0, actual = %d]", semVal);
+
+	//3- ... & acquired at once if it's signaled
+	char signalCmd[64] = "__KSem@0@Signal";
+	sys_utilities(signalCmd, 0);
+	result = timeout_ms;
+	sys_utilities(waitCmd, (uint32)(&result));
+	if (result != 1)
+		panic("wait_ksemaphore_timeout: not acquired while the semaphore is signaled");
+
+	cprintf("Congratulations!! test timed sleeps completed successfully.\n");
+}
@@ -0,0 +1,119 @@
+/* *********************************************************** */
+/* RUN IT AFTER ENABLING THE LAZY ZERO-FILL (zerofill 1) WITH A WS OF 20 PAGES AT LEAST, e.g. run tzf 20 */
+/* *********************************************************** */
+// Test the lazy zero-fill of the fresh heap & stack pages:
+//	a read maps the page on the shared zero frame (no frame is allocated),
+//	its first write gets it a private zeroed frame (copy-on-write) & drops its zero frame reference
+#include <inc/lib.h>
+
+#define ZF_NUM_OF_PAGES	4
+
+//info: {[in] va, is it mapped on the zero frame, refs of its frame (0 if not mapped), refs of the zero frame}
+static void get_page_info(volatile char* va, uint32 info[4])
+{
+	info[0] = (uint32)va;
+	char cmd[64] = "__ZeroFill@Page";
+	sys_utilities(cmd, (uint32)info);
+}
+
+//Read then write each fresh page of the given area. Returns 1 if it's correct
+static int test_fresh_pages(char* name, volatile char* area)
+{
+	uint32 info[4];
+	int numOfTested = 0;
+	uint32 zeroRefs;
+	get_page_info(area, info);
+	uint32 initZeroRefs = info[3];
+
+	//1. Read: mapped on the zero frame
+	uint32 freeFrames = sys_calculate_free_frames();
+	for (int i = 0; i < ZF_NUM_OF_PAGES; i++)
+	{
+		volatile char* ptr = area + i*PAGE_SIZE;
+		get_page_info(ptr, info);
+		zeroRefs = info[3];
+		if (info[2] != 0)
+			continue;		//already mapped (e.g. the stack page that's in use)
+		numOfTested++;
+		if (*ptr != 0)
+		{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: fresh page #%d is not zero\n", name, i); return 0; }
+		get_page_info(ptr, info);
+		if (!info[1])
+		{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: fresh page #%d is not mapped on the zero frame after its read\n", name, i); return 0; }
+		if (info[3] != zeroRefs + 1)
+		{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: wrong zero frame references after reading page #%d! Expected = %d, Actual = %d\n", name, i, zeroRefs + 1, info[3]); return 0; }
+	}
+	if (numOfTested == 0)
+	{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: no fresh page to test\n", name); return 0; }
+	//(a page table & the slab of the WS elements may be allocated)
+	int numOfAllocated = (int)freeFrames - (int)sys_calculate_free_frames();
+	if (numOfAllocated > 2)
+	{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: frames are allocated on reading the fresh pages! # allocated = %d\n", name, numOfAllocated); return 0; }
+
+	//2. Write: a private zeroed frame
+	freeFrames = sys_calculate_free_frames();
+	for (int i = 0; i < ZF_NUM_OF_PAGES; i++)
+	{
+		volatile char* ptr = area + i*PAGE_SIZE;
+		get_page_info(ptr, info);
+		if (!info[1])
+			continue;
+		zeroRefs = info[3];
+		ptr[0] = i + 1;
+		get_page_info(ptr, info);
+		if (info[1] || info[2] != 1)
+		{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: page #%d does not get a private frame on its first write! its references = %d\n", name, i, info[2]); return 0; }
+		if (info[3] != zeroRefs - 1)
+		{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: wrong zero frame references after writing page #%d! Expected = %d, Actual = %d\n", name, i, zeroRefs - 1, info[3]); return 0; }
+		for (int j = 1; j < PAGE_SIZE; j++)
+		{
+			if (ptr[j] != 0)
+			{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: the private frame of page #%d is not zeroed\n", name, i); return 0; }
+		}
+	}
+	numOfAllocated = (int)freeFrames - (int)sys_calculate_free_frames();
+	if (numOfAllocated != numOfTested)
+	{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: wrong # allocated frames on writing the pages! Expected = %d, Actual = %d\n", name, numOfTested, numOfAllocated); return 0; }
+
+	//the zero frame doesn't keep the references of the written pages
+	get_page_info(area, info);
+	if (info[3] != initZeroRefs)
+	{ cprintf_colored(TEXT_TESTERR_CLR, "%~%s: the zero frame references are leaked! Expected = %d, Actual = %d\n", name, initZeroRefs, info[3]); return 0; }
+	return 1;
+}
+
+//its array is on fresh stack pages (below the ones in use)
+static int __attribute__((noinline)) test_stack_pages()
+{
+	volatile char arr[PAGE_SIZE*(ZF_NUM_OF_PAGES+1)];
+	return test_fresh_pages("stack", (volatile char*)ROUNDUP((uint32)arr, PAGE_SIZE));
+}
+
+void _main(void)
+{
+	uint32 enabled = 0;
+	{
+		char cmd[64] = "__ZeroFill@Enabled";
+		sys_utilities(cmd, (uint32)(&enabled));
+	}
+	if (!enabled)
+	{
+		cprintf_colored(TEXT_TESTERR_CLR, "%~the lazy zero-fill is disabled: enable it (zerofill 1) then run this test again\n");
+		return;
+	}
+
+	int eval = 0;
+
+	cprintf_colored(TEXT_cyan, "%~\n1. Read then write fresh heap pages [50%]\n");
+	volatile char* heap = malloc(PAGE_SIZE*ZF_NUM_OF_PAGES);
+	if (heap == NULL)
+		panic("%~can't allocate the heap pages");
+	if (test_fresh_pages("heap", heap))
+		eval += 50;
+
+	cprintf_colored(TEXT_cyan, "%~\n2. Read then write fresh stack pages [50%]\n");
+	if (test_stack_pages())
+		eval += 50;
+
+	cprintf_colored(TEXT_light_green, "%~\ntest lazy zero-fill is finished. Evaluation = %d%\n", eval);
+}